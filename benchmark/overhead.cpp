@@ -0,0 +1,449 @@
+// OSU-style microbenchmarks comparing yampi wrappers with the equivalent raw MPI calls.
+//
+// Build:
+//   mpicxx -std=c++17 -O3 -DNDEBUG -I../include overhead.cpp -o overhead
+// Run:
+//   mpiexec -n 2 ./overhead [--min-bytes N] [--max-bytes N] [--iterations N] [--warmup N]
+//
+// Every benchmark runs the raw MPI version and the yampi version back to back for the same message size,
+// and rank 0 prints one CSV row per (benchmark, size) pair.
+// Latencies are the maximum over all ranks of the mean time per iteration.
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include <mpi.h>
+
+#include <yampi/environment.hpp>
+#include <yampi/communicator.hpp>
+#include <yampi/rank.hpp>
+#include <yampi/tag.hpp>
+#include <yampi/buffer.hpp>
+#include <yampi/status.hpp>
+#include <yampi/send.hpp>
+#include <yampi/receive.hpp>
+#include <yampi/send_receive.hpp>
+#include <yampi/broadcast.hpp>
+#include <yampi/all_reduce.hpp>
+#include <yampi/all_gather.hpp>
+#include <yampi/complete_exchange.hpp>
+#include <yampi/barrier.hpp>
+#include <yampi/binary_operation.hpp>
+#include <yampi/window.hpp>
+#include <yampi/target_buffer.hpp>
+#include <yampi/displacement.hpp>
+#include <yampi/fence.hpp>
+#include <yampi/put.hpp>
+#include <yampi/get.hpp>
+#include <yampi/accumulate.hpp>
+#include <yampi/wall_clock.hpp>
+
+
+namespace
+{
+  struct options
+  {
+    std::size_t min_bytes;
+    std::size_t max_bytes;
+    int iterations;
+    int warmup;
+  };
+
+  options parse_options(int argc, char* argv[])
+  {
+    options result{std::size_t{8u}, std::size_t{1u} << 22u, 1000, 100};
+
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+      auto const key = std::string{argv[index]};
+      auto const value = std::strtoull(argv[index + 1], nullptr, 10);
+      if (key == "--min-bytes")
+        result.min_bytes = static_cast<std::size_t>(value);
+      else if (key == "--max-bytes")
+        result.max_bytes = static_cast<std::size_t>(value);
+      else if (key == "--iterations")
+        result.iterations = static_cast<int>(value);
+      else if (key == "--warmup")
+        result.warmup = static_cast<int>(value);
+    }
+
+    result.min_bytes = std::max(result.min_bytes, sizeof(double));
+    return result;
+  }
+
+  // large messages are repeated fewer times so that a full sweep stays short
+  int num_iterations(options const& opts, std::size_t const num_bytes)
+  { return num_bytes > (std::size_t{1u} << 16u) ? std::max(opts.iterations / 10, 10) : opts.iterations; }
+
+  template <typename Function>
+  double measure(
+    Function&& function, int const iterations, int const warmup,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    for (int iteration = 0; iteration < warmup; ++iteration)
+      function();
+
+    ::yampi::barrier(communicator, environment);
+    auto const start = ::yampi::wall_clock::now(environment);
+    for (int iteration = 0; iteration < iterations; ++iteration)
+      function();
+    auto const finish = ::yampi::wall_clock::now(environment);
+
+    auto const local_latency = (finish - start).count() / static_cast<double>(iterations);
+    return ::yampi::all_reduce(
+      ::yampi::make_buffer(local_latency), ::yampi::binary_operation{::yampi::tags::maximum},
+      communicator, environment);
+  }
+
+  void print_header(std::ostream& out)
+  {
+    out
+      << "benchmark,bytes,processes,iterations,"
+      << "raw_latency_us,yampi_latency_us,delta_latency_us,delta_latency_percent,"
+      << "raw_bandwidth_MBps,yampi_bandwidth_MBps\n";
+  }
+
+  // bytes_per_iteration is the payload moved by one rank in one iteration, used for the bandwidth columns
+  void print_row(
+    std::ostream& out, char const* benchmark, std::size_t const num_bytes, int const num_processes,
+    int const iterations, double const raw_latency, double const yampi_latency, double const bytes_per_iteration)
+  {
+    auto const delta = yampi_latency - raw_latency;
+    out
+      << benchmark << ',' << num_bytes << ',' << num_processes << ',' << iterations << ','
+      << std::fixed << std::setprecision(3)
+      << raw_latency * 1.0e6 << ',' << yampi_latency * 1.0e6 << ','
+      << delta * 1.0e6 << ',' << (raw_latency > 0.0 ? 100.0 * delta / raw_latency : 0.0) << ','
+      << bytes_per_iteration / raw_latency * 1.0e-6 << ',' << bytes_per_iteration / yampi_latency * 1.0e-6 << '\n';
+  }
+
+  class benchmark_runner
+  {
+    options options_;
+    ::yampi::communicator const& communicator_;
+    ::yampi::environment const& environment_;
+    ::yampi::rank present_rank_;
+    int num_processes_;
+
+   public:
+    benchmark_runner(
+      options const& opts, ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+      : options_{opts}, communicator_{communicator}, environment_{environment},
+        present_rank_{communicator.rank(environment)}, num_processes_{communicator.size(environment)}
+    { }
+
+    template <typename RawFunction, typename YampiFunction>
+    void run(
+      char const* benchmark, std::size_t const num_bytes, double const bytes_per_iteration,
+      RawFunction&& raw_function, YampiFunction&& yampi_function, double const latency_scale = 1.0)
+    {
+      auto const iterations = num_iterations(options_, num_bytes);
+      auto const raw_latency
+        = latency_scale * measure(raw_function, iterations, options_.warmup, communicator_, environment_);
+      auto const yampi_latency
+        = latency_scale * measure(yampi_function, iterations, options_.warmup, communicator_, environment_);
+
+      if (present_rank_ == ::yampi::rank{0})
+        print_row(
+          std::cout, benchmark, num_bytes, num_processes_, iterations,
+          raw_latency, yampi_latency, bytes_per_iteration);
+    }
+
+    void run_all()
+    {
+      if (present_rank_ == ::yampi::rank{0})
+        print_header(std::cout);
+
+      for (auto num_bytes = options_.min_bytes; num_bytes <= options_.max_bytes; num_bytes *= std::size_t{2u})
+      {
+        run_send_receive(num_bytes);
+        run_send_receive_exchange(num_bytes);
+        run_broadcast(num_bytes);
+        run_all_reduce(num_bytes);
+        run_all_gather(num_bytes);
+        run_complete_exchange(num_bytes);
+        run_put(num_bytes);
+        run_get(num_bytes);
+        run_accumulate(num_bytes);
+      }
+    }
+
+   private:
+    // ping-pong between ranks 0 and 1, reporting half the round-trip time
+    void run_send_receive(std::size_t const num_bytes)
+    {
+      if (num_processes_ < 2)
+        return;
+
+      std::vector<char> data(num_bytes, 'a');
+      auto const count = static_cast<int>(num_bytes);
+      auto const mpi_rank = present_rank_.mpi_rank();
+      auto const mpi_comm = communicator_.mpi_comm();
+
+      auto raw_function
+        = [&data, count, mpi_rank, mpi_comm]()
+          {
+            if (mpi_rank == 0)
+            {
+              MPI_Send(data.data(), count, MPI_CHAR, 1, 0, mpi_comm);
+              MPI_Recv(data.data(), count, MPI_CHAR, 1, 0, mpi_comm, MPI_STATUS_IGNORE);
+            }
+            else if (mpi_rank == 1)
+            {
+              MPI_Recv(data.data(), count, MPI_CHAR, 0, 0, mpi_comm, MPI_STATUS_IGNORE);
+              MPI_Send(data.data(), count, MPI_CHAR, 0, 0, mpi_comm);
+            }
+          };
+
+      auto yampi_function
+        = [&data, this]()
+          {
+            auto const buffer = ::yampi::make_buffer(data.begin(), data.end());
+            if (present_rank_ == ::yampi::rank{0})
+            {
+              ::yampi::send(buffer, ::yampi::rank{1}, ::yampi::tag{0}, communicator_, environment_);
+              ::yampi::receive(::yampi::ignore_status, buffer, ::yampi::rank{1}, ::yampi::tag{0}, communicator_, environment_);
+            }
+            else if (present_rank_ == ::yampi::rank{1})
+            {
+              ::yampi::receive(::yampi::ignore_status, buffer, ::yampi::rank{0}, ::yampi::tag{0}, communicator_, environment_);
+              ::yampi::send(buffer, ::yampi::rank{0}, ::yampi::tag{0}, communicator_, environment_);
+            }
+          };
+
+      run("send_receive", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function, 0.5);
+    }
+
+    // every rank exchanges with its neighbors on a ring
+    void run_send_receive_exchange(std::size_t const num_bytes)
+    {
+      std::vector<char> send_data(num_bytes, 'a');
+      std::vector<char> receive_data(num_bytes);
+      auto const count = static_cast<int>(num_bytes);
+      auto const destination = (present_rank_.mpi_rank() + 1) % num_processes_;
+      auto const source = (present_rank_.mpi_rank() + num_processes_ - 1) % num_processes_;
+      auto const mpi_comm = communicator_.mpi_comm();
+
+      auto raw_function
+        = [&send_data, &receive_data, count, destination, source, mpi_comm]()
+          {
+            MPI_Sendrecv(
+              send_data.data(), count, MPI_CHAR, destination, 0,
+              receive_data.data(), count, MPI_CHAR, source, 0, mpi_comm, MPI_STATUS_IGNORE);
+          };
+
+      auto yampi_function
+        = [&send_data, &receive_data, destination, source, this]()
+          {
+            ::yampi::send_receive(
+              ::yampi::ignore_status,
+              ::yampi::make_buffer(send_data.cbegin(), send_data.cend()), ::yampi::rank{destination}, ::yampi::tag{0},
+              ::yampi::make_buffer(receive_data.begin(), receive_data.end()), ::yampi::rank{source}, ::yampi::tag{0},
+              communicator_, environment_);
+          };
+
+      run("send_receive_exchange", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+    }
+
+    void run_broadcast(std::size_t const num_bytes)
+    {
+      std::vector<char> data(num_bytes, 'a');
+      auto const count = static_cast<int>(num_bytes);
+      auto const mpi_comm = communicator_.mpi_comm();
+
+      auto raw_function
+        = [&data, count, mpi_comm]() { MPI_Bcast(data.data(), count, MPI_CHAR, 0, mpi_comm); };
+
+      auto yampi_function
+        = [&data, this]()
+          { ::yampi::broadcast(::yampi::make_buffer(data.begin(), data.end()), ::yampi::rank{0}, communicator_, environment_); };
+
+      run("broadcast", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+    }
+
+    void run_all_reduce(std::size_t const num_bytes)
+    {
+      auto const num_elements = num_bytes / sizeof(double);
+      std::vector<double> send_data(num_elements, 1.0);
+      std::vector<double> receive_data(num_elements);
+      auto const count = static_cast<int>(num_elements);
+      auto const mpi_comm = communicator_.mpi_comm();
+      auto const operation = ::yampi::binary_operation{::yampi::tags::plus};
+
+      auto raw_function
+        = [&send_data, &receive_data, count, mpi_comm]()
+          { MPI_Allreduce(send_data.data(), receive_data.data(), count, MPI_DOUBLE, MPI_SUM, mpi_comm); };
+
+      auto yampi_function
+        = [&send_data, &receive_data, &operation, this]()
+          {
+            ::yampi::all_reduce(
+              ::yampi::make_buffer(send_data.cbegin(), send_data.cend()), receive_data.begin(),
+              operation, communicator_, environment_);
+          };
+
+      run("all_reduce", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+    }
+
+    void run_all_gather(std::size_t const num_bytes)
+    {
+      std::vector<char> send_data(num_bytes, 'a');
+      std::vector<char> receive_data(num_bytes * static_cast<std::size_t>(num_processes_));
+      auto const count = static_cast<int>(num_bytes);
+      auto const mpi_comm = communicator_.mpi_comm();
+
+      auto raw_function
+        = [&send_data, &receive_data, count, mpi_comm]()
+          { MPI_Allgather(send_data.data(), count, MPI_CHAR, receive_data.data(), count, MPI_CHAR, mpi_comm); };
+
+      auto yampi_function
+        = [&send_data, &receive_data, this]()
+          {
+            ::yampi::all_gather(
+              ::yampi::make_buffer(send_data.cbegin(), send_data.cend()), receive_data.begin(),
+              communicator_, environment_);
+          };
+
+      run(
+        "all_gather", num_bytes, static_cast<double>(receive_data.size()),
+        raw_function, yampi_function);
+    }
+
+    // num_bytes is the block size sent to each rank
+    void run_complete_exchange(std::size_t const num_bytes)
+    {
+      std::vector<char> send_data(num_bytes * static_cast<std::size_t>(num_processes_), 'a');
+      std::vector<char> receive_data(send_data.size());
+      auto const count = static_cast<int>(num_bytes);
+      auto const mpi_comm = communicator_.mpi_comm();
+
+      auto raw_function
+        = [&send_data, &receive_data, count, mpi_comm]()
+          { MPI_Alltoall(send_data.data(), count, MPI_CHAR, receive_data.data(), count, MPI_CHAR, mpi_comm); };
+
+      auto yampi_function
+        = [&send_data, &receive_data, num_bytes, this]()
+          {
+            ::yampi::complete_exchange(
+              ::yampi::make_buffer(send_data.data(), send_data.data() + num_bytes), receive_data.begin(),
+              communicator_, environment_);
+          };
+
+      run(
+        "complete_exchange", num_bytes, static_cast<double>(send_data.size()),
+        raw_function, yampi_function);
+    }
+
+    // one-sided benchmarks target the next rank on a ring, one fence epoch per iteration
+    void run_put(std::size_t const num_bytes)
+    {
+      std::vector<char> origin_data(num_bytes, 'a');
+      std::vector<char> target_data(num_bytes);
+      ::yampi::window window{target_data.data(), target_data.data() + num_bytes, communicator_, environment_};
+      auto const count = static_cast<int>(num_bytes);
+      auto const target = (present_rank_.mpi_rank() + 1) % num_processes_;
+      auto const mpi_win = window.mpi_win();
+
+      auto raw_function
+        = [&origin_data, count, target, mpi_win]()
+          {
+            MPI_Put(origin_data.data(), count, MPI_CHAR, target, MPI_Aint{0}, count, MPI_CHAR, mpi_win);
+            MPI_Win_fence(0, mpi_win);
+          };
+
+      auto yampi_function
+        = [&origin_data, &window, count, target, this]()
+          {
+            ::yampi::put(
+              ::yampi::make_buffer(origin_data.cbegin(), origin_data.cend()),
+              ::yampi::rank{target}, ::yampi::target_buffer<char>{::yampi::displacement{MPI_Aint{0}}, count},
+              window, environment_);
+            ::yampi::fence(window, environment_);
+          };
+
+      ::yampi::fence(window, environment_);
+      run("put", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+      ::yampi::fence(window, environment_);
+    }
+
+    void run_get(std::size_t const num_bytes)
+    {
+      std::vector<char> origin_data(num_bytes);
+      std::vector<char> target_data(num_bytes, 'a');
+      ::yampi::window window{target_data.data(), target_data.data() + num_bytes, communicator_, environment_};
+      auto const count = static_cast<int>(num_bytes);
+      auto const target = (present_rank_.mpi_rank() + 1) % num_processes_;
+      auto const mpi_win = window.mpi_win();
+
+      auto raw_function
+        = [&origin_data, count, target, mpi_win]()
+          {
+            MPI_Get(origin_data.data(), count, MPI_CHAR, target, MPI_Aint{0}, count, MPI_CHAR, mpi_win);
+            MPI_Win_fence(0, mpi_win);
+          };
+
+      auto yampi_function
+        = [&origin_data, &window, count, target, this]()
+          {
+            ::yampi::get(
+              ::yampi::make_buffer(origin_data.begin(), origin_data.end()),
+              ::yampi::rank{target}, ::yampi::target_buffer<char>{::yampi::displacement{MPI_Aint{0}}, count},
+              window, environment_);
+            ::yampi::fence(window, environment_);
+          };
+
+      ::yampi::fence(window, environment_);
+      run("get", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+      ::yampi::fence(window, environment_);
+    }
+
+    void run_accumulate(std::size_t const num_bytes)
+    {
+      auto const num_elements = num_bytes / sizeof(double);
+      std::vector<double> origin_data(num_elements, 1.0);
+      std::vector<double> target_data(num_elements);
+      ::yampi::window window{target_data.data(), target_data.data() + num_elements, communicator_, environment_};
+      auto const count = static_cast<int>(num_elements);
+      auto const target = (present_rank_.mpi_rank() + 1) % num_processes_;
+      auto const mpi_win = window.mpi_win();
+      auto const operation = ::yampi::binary_operation{::yampi::tags::plus};
+
+      auto raw_function
+        = [&origin_data, count, target, mpi_win]()
+          {
+            MPI_Accumulate(
+              origin_data.data(), count, MPI_DOUBLE, target, MPI_Aint{0}, count, MPI_DOUBLE, MPI_SUM, mpi_win);
+            MPI_Win_fence(0, mpi_win);
+          };
+
+      auto yampi_function
+        = [&origin_data, &window, &operation, count, target, this]()
+          {
+            ::yampi::accumulate(
+              ::yampi::make_buffer(origin_data.cbegin(), origin_data.cend()),
+              ::yampi::rank{target}, ::yampi::target_buffer<double>{::yampi::displacement{MPI_Aint{0}}, count},
+              operation, window, environment_);
+            ::yampi::fence(window, environment_);
+          };
+
+      ::yampi::fence(window, environment_);
+      run("accumulate", num_bytes, static_cast<double>(num_bytes), raw_function, yampi_function);
+      ::yampi::fence(window, environment_);
+    }
+  };
+}
+
+
+int main(int argc, char* argv[])
+{
+  ::yampi::environment environment{argc, argv};
+  ::yampi::communicator communicator{::yampi::tags::world_communicator};
+
+  benchmark_runner runner{parse_options(argc, argv), communicator, environment};
+  runner.run_all();
+}
@@ -11,6 +11,7 @@
 # include <yampi/assertion_mode.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -19,20 +20,20 @@ namespace yampi
     : public std::runtime_error
   {
    public:
-    unexpected_access_status_error()
+    explicit unexpected_access_status_error(::yampi::environment const&)
       : std::runtime_error{"Error occurred because of strange access member variables"}
     { }
   };
 
 
   struct defer_access_t { };
-  struct adapt_access_t { };
+  struct adopt_access_t { };
 # if __cplusplus >= 201703L
   inline constexpr ::yampi::defer_access_t defer_access{};
-  inline constexpr ::yampi::adapt_access_t adapt_access{};
+  inline constexpr ::yampi::adopt_access_t adopt_access{};
 # else
   constexpr ::yampi::defer_access_t defer_access{};
-  constexpr ::yampi::adapt_access_t adapt_access{};
+  constexpr ::yampi::adopt_access_t adopt_access{};
 # endif
 
   template <typename Window>
@@ -44,25 +45,36 @@ namespace yampi
     access_guard(access_guard const&) = delete;
     access_guard& operator=(access_guard const&) = delete;
 
-    ~access_guard() noexcept { MPI_Win_complete(window_.mpi_win()); }
+    ~access_guard() noexcept
+    {
+      MPI_Win_complete(window_.mpi_win());
+      YAMPI_PROFILE_END("yampi::access_guard");
+    }
 
     access_guard(::yampi::group const& group, ::yampi::window_base<Window>& window, ::yampi::environment const& environment)
       : window_{window}
-    { do_start(group, 0, environment); }
+    {
+      do_start(group, 0, environment);
+      YAMPI_PROFILE_BEGIN("yampi::access_guard");
+    }
 
     access_guard(
       ::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::window_base<Window>& window,
       ::yampi::environment const& environment)
       : window_{window}
-    { do_start(group, static_cast<int>(assertion), environment); }
+    {
+      do_start(group, static_cast<int>(assertion), environment);
+      YAMPI_PROFILE_BEGIN("yampi::access_guard");
+    }
 
     access_guard(::yampi::window_base<Window>& window, ::yampi::adopt_access_t const)
       : window_{window}
-    { }
+    { YAMPI_PROFILE_BEGIN("yampi::access_guard"); }
 
    private:
-    void do_start(::yampi::group const& group, int const assertion, ::yampi::environment const& environment) const
+    void do_start(::yampi::group const& group, int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::access_guard::do_start", 0u);
       int const error_code
         = MPI_Win_start(group.mpi_group(), assertion, window_.mpi_win());
       if (error_code != MPI_SUCCESS)
@@ -78,7 +90,7 @@ namespace yampi
     bool owns_;
 
    public:
-    access() noexcept : window_ptr_{nullptr}, owns_{false} { }
+    unique_access() noexcept : window_ptr_{nullptr}, owns_{false} { }
 
     unique_access(unique_access const&) = delete;
     unique_access& operator=(unique_access const&) = delete;
@@ -125,15 +137,16 @@ namespace yampi
       : window_ptr_{std::addressof(window)}, owns_{true}
     { }
 
-    void start(::yampi::group const& group, ::yampi::environment const& environment) const
+    void start(::yampi::group const& group, ::yampi::environment const& environment)
     { do_start(group, 0, environment); }
 
-    void start(::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::environment const& environment) const
+    void start(::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::environment const& environment)
     { do_start(group, static_cast<int>(assertion), environment); }
 
    private:
-    void do_start(::yampi::group const& group, int const assertion, ::yampi::environment const& environment) const
+    void do_start(::yampi::group const& group, int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::access::do_start", 0u);
       if (owns_)
         throw ::yampi::unexpected_access_status_error(environment);
 
@@ -144,8 +157,9 @@ namespace yampi
     }
 
    public:
-    void complete(::yampi::environment const& environment) const
+    void complete(::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::access::complete", 0u);
       if (not owns_)
         throw ::yampi::unexpected_access_status_error(environment);
 
@@ -155,7 +169,7 @@ namespace yampi
       owns_ = false;
     }
 
-    void swap(access& other) noexcept
+    void swap(unique_access& other) noexcept
     {
       using std::swap;
       swap(window_ptr_, other.window_ptr_);
@@ -167,7 +181,7 @@ namespace yampi
   };
 
   template <typename Window>
-  inline void swap(::yampi::access<Window>& lhs, ::yampi::access<Window>& rhs) noexcept
+  inline void swap(::yampi::unique_access<Window>& lhs, ::yampi::unique_access<Window>& rhs) noexcept
   { lhs.swap(rhs); }
 }
 
@@ -13,6 +13,8 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/communication_matrix.hpp>
 
 
 namespace yampi
@@ -24,6 +26,8 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::accumulate", ::yampi::profiler::num_bytes(origin_buffer, environment));
+    YAMPI_RECORD_PUT(window, target, ::yampi::profiler::num_bytes(origin_buffer, environment));
 # if MPI_VERSION >= 4
     int const error_code
       = MPI_Accumulate_c(
@@ -33,8 +37,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     int const error_code
       = MPI_Accumulate(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_buffer.count(environment), origin_buffer.datatype().mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(environment), target_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), window.mpi_win());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -50,6 +54,8 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::accumulate", ::yampi::profiler::num_bytes(origin_buffer, environment));
+    YAMPI_RECORD_PUT(window, target, ::yampi::profiler::num_bytes(origin_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     int const error_code
@@ -60,8 +66,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     int const error_code
       = MPI_Raccumulate(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_buffer.count(environment), origin_buffer.datatype().mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(environment), target_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), window.mpi_win(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
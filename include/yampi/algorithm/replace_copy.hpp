@@ -2,7 +2,6 @@
 # define YAMPI_ALGORITHM_REPLACE_COPY_HPP
 
 # include <cassert>
-# include <vector>
 # include <algorithm>
 
 # include <boost/optional.hpp>
@@ -10,7 +9,7 @@
 
 # include <yampi/send.hpp>
 # include <yampi/receive.hpp>
-# include <yampi/allocator.hpp>
+# include <yampi/scratch_buffer.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/buffer.hpp>
 # include <yampi/message_envelope.hpp>
@@ -79,7 +78,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_buffer(buffer_size);
       return ::yampi::algorithm::replace_copy(
         send_buffer, receive_buffer, old_value, new_value,
         replace_copy_buffer.begin(), message_envelope, environment);
@@ -144,7 +143,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_buffer(buffer_size);
       return ::yampi::algorithm::replace_copy(
         std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, old_value, new_value,
@@ -206,7 +205,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_buffer(buffer_size);
       ::yampi::algorithm::replace_copy(
         ignore_status,
         send_buffer, receive_buffer, old_value, new_value,
@@ -270,7 +269,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_buffer(buffer_size);
       ::yampi::algorithm::replace_copy(
         ignore_status, std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, old_value, new_value,
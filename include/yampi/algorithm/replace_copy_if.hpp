@@ -2,7 +2,6 @@
 # define YAMPI_ALGORITHM_REPLACE_COPY_IF_HPP
 
 # include <cassert>
-# include <vector>
 # include <algorithm>
 
 # include <boost/optional.hpp>
@@ -10,7 +9,7 @@
 
 # include <yampi/send.hpp>
 # include <yampi/receive.hpp>
-# include <yampi/allocator.hpp>
+# include <yampi/scratch_buffer.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/buffer.hpp>
 # include <yampi/message_envelope.hpp>
@@ -23,7 +22,7 @@ namespace yampi
 {
   namespace algorithm
   {
-    template <typename Value, typename ContiguousIterator>
+    template <typename Value, typename UnaryPredicate, typename ContiguousIterator>
     inline boost::optional< ::yampi::status >
     replace_copy_if(
       ::yampi::buffer<Value> const send_buffer,
@@ -66,7 +65,7 @@ namespace yampi
       return boost::none;
     }
 
-    template <typename Value>
+    template <typename Value, typename UnaryPredicate>
     inline boost::optional< ::yampi::status >
     replace_copy_if(
       ::yampi::buffer<Value> const send_buffer,
@@ -79,13 +78,13 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_if_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_if_buffer(buffer_size);
       return ::yampi::algorithm::replace_copy_if(
         send_buffer, receive_buffer, predicate, new_value,
         replace_copy_if_buffer.begin(), message_envelope, environment);
     }
 
-    template <typename CommunicationMode, typename Value, typename ContiguousIterator>
+    template <typename CommunicationMode, typename Value, typename UnaryPredicate, typename ContiguousIterator>
     inline boost::optional< ::yampi::status >
     replace_copy_if(
       CommunicationMode&& communication_mode,
@@ -130,7 +129,7 @@ namespace yampi
       return boost::none;
     }
 
-    template <typename CommunicationMode, typename Value>
+    template <typename CommunicationMode, typename Value, typename UnaryPredicate>
     inline boost::optional< ::yampi::status >
     replace_copy_if(
       CommunicationMode&& communication_mode,
@@ -144,7 +143,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_if_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_if_buffer(buffer_size);
       return ::yampi::algorithm::replace_copy_if(
         std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, predicate, new_value,
@@ -152,7 +151,7 @@ namespace yampi
     }
 
     // ignoring status
-    template <typename Value, typename ContiguousIterator>
+    template <typename Value, typename UnaryPredicate, typename ContiguousIterator>
     inline void replace_copy_if(
       ::yampi::ignore_status_t const ignore_status,
       ::yampi::buffer<Value> const send_buffer,
@@ -193,7 +192,7 @@ namespace yampi
       }
     }
 
-    template <typename Value>
+    template <typename Value, typename UnaryPredicate>
     inline void replace_copy_if(
       ::yampi::ignore_status_t const ignore_status,
       ::yampi::buffer<Value> const send_buffer,
@@ -206,14 +205,14 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_if_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_if_buffer(buffer_size);
       ::yampi::algorithm::replace_copy_if(
         ignore_status,
         send_buffer, receive_buffer, predicate, new_value,
         replace_copy_if_buffer.begin(), message_envelope, environment);
     }
 
-    template <typename CommunicationMode, typename Value, typename ContiguousIterator>
+    template <typename CommunicationMode, typename Value, typename UnaryPredicate, typename ContiguousIterator>
     inline void replace_copy_if(
       ::yampi::ignore_status_t const ignore_status,
       CommunicationMode&& communication_mode,
@@ -256,7 +255,7 @@ namespace yampi
       }
     }
 
-    template <typename CommunicationMode, typename Value>
+    template <typename CommunicationMode, typename Value, typename UnaryPredicate>
     inline void replace_copy_if(
       ::yampi::ignore_status_t const ignore_status,
       CommunicationMode&& communication_mode,
@@ -270,7 +269,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > replace_copy_if_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> replace_copy_if_buffer(buffer_size);
       ::yampi::algorithm::replace_copy_if(
         ignore_status, std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, predicate, new_value,
@@ -2,7 +2,6 @@
 # define YAMPI_ALGORITHM_REVERSE_COPY_HPP
 
 # include <cassert>
-# include <vector>
 # include <algorithm>
 
 # include <boost/optional.hpp>
@@ -10,7 +9,7 @@
 
 # include <yampi/send.hpp>
 # include <yampi/receive.hpp>
-# include <yampi/allocator.hpp>
+# include <yampi/scratch_buffer.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/buffer.hpp>
 # include <yampi/message_envelope.hpp>
@@ -77,7 +76,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > reverse_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> reverse_copy_buffer(buffer_size);
       return ::yampi::algorithm::reverse_copy(
         send_buffer, receive_buffer,
         reverse_copy_buffer.begin(), message_envelope, environment);
@@ -140,7 +139,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > reverse_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> reverse_copy_buffer(buffer_size);
       return ::yampi::algorithm::reverse_copy(
         std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer,
@@ -200,7 +199,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > reverse_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> reverse_copy_buffer(buffer_size);
       ::yampi::algorithm::reverse_copy(
         ignore_status,
         send_buffer, receive_buffer,
@@ -262,7 +261,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > reverse_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> reverse_copy_buffer(buffer_size);
       ::yampi::algorithm::reverse_copy(
         ignore_status, std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer,
@@ -2,7 +2,6 @@
 # define YAMPI_ALGORITHM_ROTATE_COPY_HPP
 
 # include <cassert>
-# include <vector>
 # include <algorithm>
 
 # include <boost/optional.hpp>
@@ -10,7 +9,7 @@
 
 # include <yampi/send.hpp>
 # include <yampi/receive.hpp>
-# include <yampi/allocator.hpp>
+# include <yampi/scratch_buffer.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/buffer.hpp>
 # include <yampi/message_envelope.hpp>
@@ -82,7 +81,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > rotate_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> rotate_copy_buffer(buffer_size);
       return ::yampi::algorithm::rotate_copy(
         send_buffer, receive_buffer,
         rotate_copy_buffer.begin(), message_envelope, environment);
@@ -150,7 +149,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > rotate_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> rotate_copy_buffer(buffer_size);
       return ::yampi::algorithm::rotate_copy(
         std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer,
@@ -215,7 +214,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > rotate_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> rotate_copy_buffer(buffer_size);
       ::yampi::algorithm::rotate_copy(
         ignore_status,
         send_buffer, receive_buffer,
@@ -282,7 +281,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > rotate_copy_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> rotate_copy_buffer(buffer_size);
       ::yampi::algorithm::rotate_copy(
         ignore_status, std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer,
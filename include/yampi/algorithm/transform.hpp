@@ -2,7 +2,6 @@
 # define YAMPI_ALGORITHM_TRANSFORM_HPP
 
 # include <cassert>
-# include <vector>
 # include <algorithm>
 
 # include <boost/optional.hpp>
@@ -10,7 +9,7 @@
 
 # include <yampi/send.hpp>
 # include <yampi/receive.hpp>
-# include <yampi/allocator.hpp>
+# include <yampi/scratch_buffer.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/buffer.hpp>
 # include <yampi/message_envelope.hpp>
@@ -76,7 +75,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > transform_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> transform_buffer(buffer_size);
       return ::yampi::algorithm::transform(
         send_buffer, receive_buffer, unary_function, transform_buffer.begin(), message_envelope, environment);
     }
@@ -137,7 +136,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > transform_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> transform_buffer(buffer_size);
       return ::yampi::algorithm::transform(
         std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, unary_function, transform_buffer.begin(), message_envelope, environment);
@@ -195,7 +194,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > transform_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> transform_buffer(buffer_size);
       ::yampi::algorithm::transform(
         ignore_status, send_buffer, receive_buffer, unary_function, transform_buffer.begin(), message_envelope, environment);
     }
@@ -254,7 +253,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
       auto const buffer_size = send_buffer.count();
 # endif // MPI_VERSION >= 4
-      std::vector<Value, ::yampi::allocator<Value> > transform_buffer(buffer_size);
+      ::yampi::scratch_buffer<Value> transform_buffer(buffer_size);
       ::yampi::algorithm::transform(
         ignore_status, std::forward<CommunicationMode>(communication_mode),
         send_buffer, receive_buffer, unary_function,
@@ -2,8 +2,12 @@
 # define YAMPI_ALL_GATHER_HPP
 
 # include <cassert>
+# include <cstddef>
+# include <cstring>
+# include <algorithm>
 # include <type_traits>
 # include <iterator>
+# include <vector>
 # include <memory>
 
 # include <mpi.h>
@@ -19,6 +23,13 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
+# include <yampi/collective_algorithm.hpp>
+# include <yampi/collective_autotuner.hpp>
+# if MPI_VERSION >= 3
+#   include <yampi/hierarchy.hpp>
+# endif // MPI_VERSION >= 3
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -34,13 +45,15 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -52,15 +65,15 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allgather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -72,15 +85,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -91,14 +106,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allgather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -111,9 +126,11 @@ namespace yampi
     ::yampi::in_place_t const, ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -138,13 +155,15 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.remote_size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.remote_size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.remote_size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -156,15 +175,15 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allgather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -176,15 +195,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -195,14 +216,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allgather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -217,13 +238,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * topology.num_neighbors(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * topology.num_neighbors(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * topology.num_neighbors(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -235,8 +257,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -248,15 +270,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -267,12 +290,12 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
-      throw ::yampi::error(error_code, "yampi::all_gather", environment};
+      throw ::yampi::error(error_code, "yampi::all_gather", environment);
   }
 # endif // MPI_VERSION >= 3
 
@@ -284,13 +307,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -303,8 +327,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iallgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -318,15 +342,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -338,7 +363,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iallgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -353,9 +378,10 @@ namespace yampi
     ::yampi::immediate_request& request, ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -383,13 +409,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.remote_size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.remote_size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.remote_size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -402,8 +429,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iallgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -417,15 +444,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -437,7 +465,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iallgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -454,13 +482,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 #   if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * topology.num_neighbors(environment) <= send_buffer.data());
 #   else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * topology.num_neighbors(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * topology.num_neighbors(environment) <= send_buffer.data());
 #   endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -473,8 +502,8 @@ namespace yampi
 #   else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ineighbor_allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm(), std::addressof(mpi_request));
 #   endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -488,15 +517,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 #   if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 #   else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 #   endif // MPI_VERSION >= 4
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 #   if MPI_VERSION >= 4
@@ -508,7 +538,7 @@ namespace yampi
 #   else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ineighbor_allgather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm(), std::addressof(mpi_request));
 #   endif // MPI_VERSION >= 4
@@ -528,6 +558,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -551,11 +582,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -575,9 +607,10 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -598,6 +631,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -621,11 +655,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -646,6 +681,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -669,11 +705,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -694,6 +731,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -716,11 +754,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -739,9 +778,10 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -761,6 +801,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -783,11 +824,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -807,6 +849,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -829,11 +872,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -846,6 +890,140 @@ namespace yampi
     request.reset(mpi_request, environment);
   }
 # endif // MPI_VERSION >= 4
+# if MPI_VERSION >= 3
+  // Two-level all-gather
+  // Processes on a node store their data in the input, leaders all-gather the inputs of their nodes across nodes into
+  // the output, which is in the order of hierarchy.ranks_by_node(), and every process copies the output to its receive
+  // buffer in the order of parent ranks. Buffers of datatypes with gaps fall back to the flat all-gather
+  template <typename SendValue, typename ContiguousIterator>
+  inline void all_gather(
+    ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
+    ::yampi::hierarchy& hierarchy, ::yampi::environment const& environment)
+  {
+    auto const num_bytes = ::yampi::profiler::num_bytes(send_buffer, environment);
+    if (not ::yampi::hierarchy_detail::uses_two_level(
+          hierarchy, num_bytes, send_buffer.datatype().mpi_datatype(), environment))
+    {
+      ::yampi::all_gather(send_buffer, first, hierarchy.parent(), environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", hierarchy.parent(), environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", num_bytes);
+    static_assert(
+      std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
+      "value_type of ContiguousIterator must be the same to SendValue");
+
+    auto const count = ::yampi::collective_algorithm_detail::count_of(send_buffer, environment);
+    auto const mpi_datatype = send_buffer.datatype().mpi_datatype();
+    auto const num_extent_bytes
+      = static_cast<std::size_t>(count)
+        * static_cast<std::size_t>(::yampi::hierarchy_detail::extent_of(mpi_datatype, environment));
+    auto const node_size = hierarchy.node_size();
+    auto const node_rank = hierarchy.node_communicator().rank(environment).mpi_rank();
+    auto const& ranks_by_node = hierarchy.ranks_by_node();
+    auto const size = static_cast<int>(ranks_by_node.size());
+    // the counts and the displacements of MPI_Allgatherv are at most the total count
+    ::yampi::collective_algorithm_detail::checked_count(static_cast<long long>(size) * count, environment);
+
+    auto const buffers
+      = hierarchy.shared_buffers(node_size * num_extent_bytes, size * num_extent_bytes, environment);
+    std::memcpy(buffers.first + node_rank * num_extent_bytes, send_buffer.data(), num_extent_bytes);
+    hierarchy.synchronize_node(environment);
+
+    if (hierarchy.is_leader())
+    {
+      auto const num_nodes = hierarchy.num_nodes();
+      std::vector<int> counts(num_nodes);
+      std::vector<int> displacements(num_nodes);
+      auto displacement = 0;
+      for (auto index = 0; index < num_nodes; ++index)
+      {
+        counts[index] = hierarchy.node_size(index) * count;
+        displacements[index] = displacement;
+        displacement += counts[index];
+      }
+
+      auto const error_code
+        = MPI_Allgatherv(
+            buffers.first, node_size * count, mpi_datatype,
+            buffers.second, counts.data(), displacements.data(), mpi_datatype,
+            hierarchy.leader_communicator().mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::all_gather", environment};
+    }
+    hierarchy.synchronize_node(environment);
+
+    auto const receive_data = reinterpret_cast<char*>(std::addressof(*first));
+    for (auto index = 0; index < size; ++index)
+      std::memcpy(
+        receive_data + ranks_by_node[index].mpi_rank() * num_extent_bytes,
+        buffers.second + index * num_extent_bytes, num_extent_bytes);
+  }
+# endif // MPI_VERSION >= 3
+  // All-gather by the algorithm in user space (see <yampi/collective_algorithm.hpp>)
+  // only for intracommunicators
+  template <typename SendValue, typename ContiguousIterator>
+  inline void all_gather(
+    ::yampi::collective_algorithm const algorithm,
+    ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    if (algorithm == ::yampi::collective_algorithm::library)
+    {
+      ::yampi::all_gather(send_buffer, first, communicator, environment);
+      return;
+    }
+
+    if (algorithm == ::yampi::collective_algorithm::autotuned)
+    {
+      auto const selected
+        = ::yampi::collective_autotuner::of(communicator, environment).select(
+            ::yampi::collective_autotuner::make_key(
+              "all_gather", send_buffer.datatype().mpi_datatype(), MPI_OP_NULL,
+              ::yampi::profiler::num_bytes(send_buffer, environment), communicator, environment),
+            [&](::yampi::collective_algorithm const candidate)
+            { ::yampi::all_gather(candidate, send_buffer, first, communicator, environment); },
+            communicator, environment);
+      ::yampi::all_gather(selected, send_buffer, first, communicator, environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
+    static_assert(
+      std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
+      "value_type of ContiguousIterator must be the same to SendValue");
+
+    namespace detail = ::yampi::collective_algorithm_detail;
+    auto const count = detail::count_of(send_buffer, environment);
+    auto const rank = communicator.rank(environment).mpi_rank();
+    auto const size = communicator.size(environment);
+    auto const total_count = detail::checked_count(static_cast<long long>(size) * count, environment);
+    auto const data = std::addressof(*first);
+    std::copy(send_buffer.data(), send_buffer.data() + count, data + rank * count);
+    auto const buffer = detail::make_buffer_like(send_buffer, data, data + total_count);
+    auto const& algorithm_communicator = detail::communicator_of(communicator, environment);
+
+    switch (algorithm)
+    {
+     case ::yampi::collective_algorithm::ring:
+      detail::ring_all_gather(
+        buffer, detail::block_offsets(total_count, size), ::yampi::rank{0}, algorithm_communicator, environment);
+      break;
+     case ::yampi::collective_algorithm::recursive_doubling:
+     case ::yampi::collective_algorithm::rabenseifner:
+      detail::bruck_all_gather(buffer, count, algorithm_communicator, environment);
+      break;
+     case ::yampi::collective_algorithm::binomial_tree:
+      detail::binomial_gather(buffer, detail::block_offsets(total_count, size), algorithm_communicator, environment);
+      detail::binomial_broadcast(buffer, ::yampi::rank{0}, algorithm_communicator, environment);
+      break;
+     case ::yampi::collective_algorithm::library:
+     case ::yampi::collective_algorithm::autotuned:
+      throw ::yampi::error{MPI_ERR_ARG, "yampi::all_gather", environment};
+    }
+  }
 }
 
 
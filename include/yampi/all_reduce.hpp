@@ -2,6 +2,9 @@
 # define YAMPI_ALL_REDUCE_HPP
 
 # include <cassert>
+# include <cstddef>
+# include <cstring>
+# include <algorithm>
 # include <type_traits>
 # include <iterator>
 # include <memory>
@@ -17,6 +20,16 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/collective_algorithm.hpp>
+# include <yampi/collective_autotuner.hpp>
+# include <yampi/scratch_buffer.hpp>
+# include <yampi/reduce_local.hpp>
+# include <yampi/load_imbalance.hpp>
+# include <yampi/large_count.hpp>
+# if MPI_VERSION >= 3
+#   include <yampi/hierarchy.hpp>
+# endif // MPI_VERSION >= 3
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -32,13 +45,15 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -49,16 +64,21 @@ namespace yampi
           operation.mpi_op(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
     auto const error_code
-      = MPI_Allreduce(
-          send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          send_buffer.large_count(),
+          [&send_buffer, first, &operation, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Allreduce(
+              send_buffer.data() + offset, std::addressof(*first) + offset,
+              count, send_buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), communicator.mpi_comm());
+          });
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allreduce(
           const_cast<value_type*>(send_buffer.data()), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -74,7 +94,7 @@ namespace yampi
 # if MPI_VERSION >= 4
     assert(send_buffer.count().mpi_count() == 1);
 # else // MPI_VERSION >= 4
-    assert(send_buffer.count() == 1);
+    assert(send_buffer.large_count() == 1);
 # endif // MPI_VERSION >= 4
 
     typename std::remove_cv<SendValue>::type result;
@@ -88,6 +108,8 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Allreduce_c(
@@ -96,10 +118,15 @@ namespace yampi
           operation.mpi_op(), communicator.mpi_comm());
 # else // MPI_VERSION >= 4
     auto const error_code
-      = MPI_Allreduce(
-          MPI_IN_PLACE,
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          buffer.large_count(),
+          [&buffer, &operation, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Allreduce(
+              MPI_IN_PLACE,
+              buffer.data() + offset, count, buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), communicator.mpi_comm());
+          });
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error{error_code, "yampi::all_reduce", environment};
@@ -113,13 +140,14 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -133,7 +161,7 @@ namespace yampi
     auto const error_code
       = MPI_Iallreduce(
           send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -148,6 +176,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -159,7 +188,7 @@ namespace yampi
     auto const error_code
       = MPI_Iallreduce(
           MPI_IN_PLACE,
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -176,6 +205,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -200,6 +230,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allreduce_init_c(
@@ -219,6 +250,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -242,6 +274,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allreduce_init_c(
@@ -253,6 +286,250 @@ namespace yampi
     request.reset(mpi_request, environment);
   }
 # endif // MPI_VERSION >= 4
+# if MPI_VERSION >= 3
+  namespace all_reduce_detail
+  {
+    // Elements are reduced in the order of node ranks in each node, and in the order of node indices across nodes,
+    // which is the order of parent ranks only if the hierarchy is blocked by node
+    inline bool uses_two_level(
+      ::yampi::hierarchy const& hierarchy, std::size_t const num_bytes, MPI_Datatype const mpi_datatype,
+      ::yampi::binary_operation const& operation, ::yampi::environment const& environment)
+    {
+      return ::yampi::hierarchy_detail::uses_two_level(hierarchy, num_bytes, mpi_datatype, environment)
+        and (hierarchy.is_blocked_by_node()
+             or ::yampi::collective_algorithm_detail::is_commutative(operation.mpi_op(), environment));
+    }
+
+    // Processes on a node store their data in the input, reduce their parts of the elements over the node into the
+    // output, then leaders all-reduce the outputs across nodes
+    inline void two_level(
+      void const* send_data, void* receive_data, int const count, MPI_Datatype const mpi_datatype,
+      ::yampi::binary_operation const& operation,
+      ::yampi::hierarchy& hierarchy, ::yampi::environment const& environment)
+    {
+      auto const extent = static_cast<std::size_t>(::yampi::hierarchy_detail::extent_of(mpi_datatype, environment));
+      auto const num_bytes = static_cast<std::size_t>(count) * extent;
+      auto const node_size = hierarchy.node_size();
+      auto const node_rank = hierarchy.node_communicator().rank(environment).mpi_rank();
+
+      auto const buffers = hierarchy.shared_buffers(node_size * num_bytes, num_bytes, environment);
+      std::memcpy(buffers.first + node_rank * num_bytes, send_data, num_bytes);
+      hierarchy.synchronize_node(environment);
+
+      auto const part = ::yampi::collective_algorithm_detail::partition(count, node_rank, node_size);
+      if (part.first < part.second)
+      {
+        auto const offset = static_cast<std::size_t>(part.first) * extent;
+        auto const part_count = part.second - part.first;
+        std::memcpy(
+          buffers.second + offset, buffers.first + (node_size - 1) * num_bytes + offset,
+          static_cast<std::size_t>(part_count) * extent);
+        // MPI_Reduce_local computes inout = in op inout
+        for (auto rank = node_size - 1; rank > 0; --rank)
+          ::yampi::reduce_local_detail::reduce_local(
+            buffers.first + (rank - 1) * num_bytes + offset, buffers.second + offset, part_count, mpi_datatype,
+            operation.mpi_op(), environment);
+      }
+      hierarchy.synchronize_node(environment);
+
+      if (hierarchy.num_nodes() > 1)
+      {
+        if (hierarchy.is_leader())
+        {
+          auto const error_code
+            = MPI_Allreduce(
+                MPI_IN_PLACE, buffers.second, count, mpi_datatype, operation.mpi_op(),
+                hierarchy.leader_communicator().mpi_comm());
+          if (error_code != MPI_SUCCESS)
+            throw ::yampi::error{error_code, "yampi::all_reduce", environment};
+        }
+        hierarchy.synchronize_node(environment);
+      }
+
+      std::memcpy(receive_data, buffers.second, num_bytes);
+    }
+  } // namespace all_reduce_detail
+
+  // Two-level all-reduce
+  // Buffers of datatypes with gaps, and noncommutative operations on hierarchies not blocked by node fall back to the
+  // flat all-reduce
+  template <typename SendValue, typename ContiguousIterator>
+  inline void all_reduce(
+    ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
+    ::yampi::binary_operation const& operation,
+    ::yampi::hierarchy& hierarchy, ::yampi::environment const& environment)
+  {
+    auto const num_bytes = ::yampi::profiler::num_bytes(send_buffer, environment);
+    if (not ::yampi::all_reduce_detail::uses_two_level(
+          hierarchy, num_bytes, send_buffer.datatype().mpi_datatype(), operation, environment))
+    {
+      ::yampi::all_reduce(send_buffer, first, operation, hierarchy.parent(), environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", hierarchy.parent(), environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", num_bytes);
+    static_assert(
+      std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
+      "value_type of ContiguousIterator must be the same to SendValue");
+    ::yampi::all_reduce_detail::two_level(
+      send_buffer.data(), std::addressof(*first),
+      ::yampi::collective_algorithm_detail::count_of(send_buffer, environment), send_buffer.datatype().mpi_datatype(),
+      operation, hierarchy, environment);
+  }
+
+  template <typename Value>
+  inline void all_reduce(
+    ::yampi::in_place_t const,
+    ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
+    ::yampi::hierarchy& hierarchy, ::yampi::environment const& environment)
+  {
+    auto const num_bytes = ::yampi::profiler::num_bytes(buffer, environment);
+    if (not ::yampi::all_reduce_detail::uses_two_level(
+          hierarchy, num_bytes, buffer.datatype().mpi_datatype(), operation, environment))
+    {
+      ::yampi::all_reduce(::yampi::in_place, buffer, operation, hierarchy.parent(), environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", hierarchy.parent(), environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", num_bytes);
+    ::yampi::all_reduce_detail::two_level(
+      buffer.data(), buffer.data(), ::yampi::collective_algorithm_detail::count_of(buffer, environment),
+      buffer.datatype().mpi_datatype(), operation, hierarchy, environment);
+  }
+# endif // MPI_VERSION >= 3
+  namespace all_reduce_detail
+  {
+    // communicator is that of ::yampi::collective_algorithm_detail::communicator_of
+    template <typename Value>
+    inline void user_space(
+      ::yampi::collective_algorithm const algorithm,
+      ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
+      ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+    {
+      namespace detail = ::yampi::collective_algorithm_detail;
+      auto const count = detail::count_of(buffer, environment);
+      auto const size = communicator.size(environment);
+
+      switch (detail::algorithm_for(algorithm, operation, false, environment))
+      {
+       case ::yampi::collective_algorithm::ring:
+       {
+        auto const offsets = detail::block_offsets(count, size);
+        detail::ring_reduce_scatter(buffer, offsets, operation, communicator, environment);
+        detail::ring_all_gather(buffer, offsets, ::yampi::rank{0}, communicator, environment);
+        break;
+       }
+       case ::yampi::collective_algorithm::recursive_doubling:
+       {
+        auto const folded_rank = detail::fold(buffer, operation, communicator, environment);
+        if (folded_rank >= 0)
+          detail::recursive_doubling_all_reduce(buffer, folded_rank, operation, communicator, environment);
+        detail::unfold(buffer, communicator, environment);
+        break;
+       }
+       case ::yampi::collective_algorithm::binomial_tree:
+        detail::binomial_reduce(buffer, operation, communicator, environment);
+        detail::binomial_broadcast(buffer, ::yampi::rank{0}, communicator, environment);
+        break;
+       case ::yampi::collective_algorithm::rabenseifner:
+       {
+        auto const folded_rank = detail::fold(buffer, operation, communicator, environment);
+        if (folded_rank >= 0)
+        {
+          auto const offsets = detail::block_offsets(count, detail::largest_power_of_two(size));
+          detail::recursive_halving_reduce_scatter(buffer, offsets, folded_rank, operation, communicator, environment);
+          detail::recursive_doubling_all_gather(buffer, offsets, folded_rank, communicator, environment);
+        }
+        detail::unfold(buffer, communicator, environment);
+        break;
+       }
+       case ::yampi::collective_algorithm::library:
+       case ::yampi::collective_algorithm::autotuned:
+        throw ::yampi::error{MPI_ERR_ARG, "yampi::all_reduce", environment};
+      }
+    }
+  } // namespace all_reduce_detail
+
+  // All-reduce by the algorithm in user space (see <yampi/collective_algorithm.hpp>)
+  // only for intracommunicators
+  template <typename SendValue, typename ContiguousIterator>
+  inline void all_reduce(
+    ::yampi::collective_algorithm const algorithm,
+    ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
+    ::yampi::binary_operation const& operation,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    if (algorithm == ::yampi::collective_algorithm::library)
+    {
+      ::yampi::all_reduce(send_buffer, first, operation, communicator, environment);
+      return;
+    }
+
+    if (algorithm == ::yampi::collective_algorithm::autotuned)
+    {
+      auto const selected
+        = ::yampi::collective_autotuner::of(communicator, environment).select(
+            ::yampi::collective_autotuner::make_key(
+              "all_reduce", send_buffer.datatype().mpi_datatype(), operation.mpi_op(),
+              ::yampi::profiler::num_bytes(send_buffer, environment), communicator, environment),
+            [&](::yampi::collective_algorithm const candidate)
+            { ::yampi::all_reduce(candidate, send_buffer, first, operation, communicator, environment); },
+            communicator, environment);
+      ::yampi::all_reduce(selected, send_buffer, first, operation, communicator, environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
+    static_assert(
+      std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
+      "value_type of ContiguousIterator must be the same to SendValue");
+
+    auto const count = ::yampi::collective_algorithm_detail::count_of(send_buffer, environment);
+    auto const data = std::addressof(*first);
+    std::copy(send_buffer.data(), send_buffer.data() + count, data);
+    ::yampi::all_reduce_detail::user_space(
+      algorithm, ::yampi::collective_algorithm_detail::make_buffer_like(send_buffer, data, data + count),
+      operation, ::yampi::collective_algorithm_detail::communicator_of(communicator, environment), environment);
+  }
+
+  template <typename Value>
+  inline void all_reduce(
+    ::yampi::in_place_t const, ::yampi::collective_algorithm const algorithm,
+    ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    if (algorithm == ::yampi::collective_algorithm::library)
+    {
+      ::yampi::all_reduce(::yampi::in_place, buffer, operation, communicator, environment);
+      return;
+    }
+
+    if (algorithm == ::yampi::collective_algorithm::autotuned)
+    {
+      // trials reduce buffer into a temporary instead of in place, so that buffer is kept
+      ::yampi::scratch_buffer<typename std::remove_cv<Value>::type> trial(
+        ::yampi::collective_algorithm_detail::count_of(buffer, environment));
+      auto const selected
+        = ::yampi::collective_autotuner::of(communicator, environment).select(
+            ::yampi::collective_autotuner::make_key(
+              "all_reduce", buffer.datatype().mpi_datatype(), operation.mpi_op(),
+              ::yampi::profiler::num_bytes(buffer, environment), communicator, environment),
+            [&](::yampi::collective_algorithm const candidate)
+            { ::yampi::all_reduce(candidate, buffer, trial.begin(), operation, communicator, environment); },
+            communicator, environment);
+      ::yampi::all_reduce(::yampi::in_place, selected, buffer, operation, communicator, environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::all_reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::all_reduce", ::yampi::profiler::num_bytes(buffer, environment));
+    ::yampi::all_reduce_detail::user_space(
+      algorithm, buffer, operation, ::yampi::collective_algorithm_detail::communicator_of(communicator, environment),
+      environment);
+  }
 }
 
 
@@ -7,6 +7,8 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -18,6 +20,8 @@ namespace yampi
   // Blocking barrier
   inline void barrier(::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::barrier", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::barrier", 0u);
     auto const error_code = MPI_Barrier(communicator.mpi_comm());
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error{error_code, "yampi::barrier", environment};
@@ -27,6 +31,7 @@ namespace yampi
   inline void barrier(
     ::yampi::immediate_request& request, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::barrier", 0u);
     MPI_Request mpi_request;
     auto const error_code = MPI_Ibarrier(communicator.mpi_comm(), std::addressof(mpi_request));
     if (error_code != MPI_SUCCESS)
@@ -40,6 +45,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::barrier", 0u);
     MPI_Request mpi_request;
     auto const error_code = MPI_Barrier_init(communicator.mpi_comm(), information.mpi_info(), std::addressof(mpi_request));
     if (error_code != MPI_SUCCESS)
@@ -52,6 +58,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::barrier", 0u);
     MPI_Request mpi_request;
     auto const error_code = MPI_Barrier_init(communicator.mpi_comm(), MPI_INFO_NULL, std::addressof(mpi_request));
     if (error_code != MPI_SUCCESS)
@@ -12,6 +12,7 @@
 
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/function.hpp>
 
 # if __cplusplus >= 201703L
 #   define YAMPI_is_nothrow_swappable std::is_nothrow_swappable
@@ -148,7 +149,12 @@ namespace yampi
 
 # undef YAMPI_DEFINE_OPERATION_CONSTRUCTOR
 
-    // TODO: Implement something like yampi::function and constructor using it
+    template <typename Value, typename Function, bool is_commutative>
+    binary_operation(
+      ::yampi::function<Value, Function, is_commutative> const&, ::yampi::environment const& environment)
+      : mpi_op_{create(&::yampi::function<Value, Function, is_commutative>::call, is_commutative, environment)}
+    { }
+
 # if MPI_VERSION >= 4
     binary_operation(
       MPI_User_function_c* mpi_user_function, bool const is_commutative,
@@ -237,7 +243,14 @@ namespace yampi
 
 # undef YAMPI_DEFINE_OPERATION_RESET
 
-    // TODO: Implement something like yampi::function
+    template <typename Value, typename Function, bool is_commutative>
+    void reset(
+      ::yampi::function<Value, Function, is_commutative> const&, ::yampi::environment const& environment)
+    {
+      free(environment);
+      mpi_op_ = create(&::yampi::function<Value, Function, is_commutative>::call, is_commutative, environment);
+    }
+
 # if MPI_VERSION >= 4
     void reset(
       MPI_User_function_c* mpi_user_function, bool const is_commutative,
@@ -1,6 +1,10 @@
 #ifndef YAMPI_BROADCAST_HPP
 # define YAMPI_BROADCAST_HPP
 
+# include <cstddef>
+# include <cstring>
+# include <type_traits>
+
 # include <mpi.h>
 
 # include <yampi/buffer.hpp>
@@ -10,6 +14,15 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
+# include <yampi/collective_algorithm.hpp>
+# include <yampi/collective_autotuner.hpp>
+# include <yampi/scratch_buffer.hpp>
+# include <yampi/large_count.hpp>
+# if MPI_VERSION >= 3
+#   include <yampi/hierarchy.hpp>
+# endif // MPI_VERSION >= 3
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -24,15 +37,18 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const root,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Bcast_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Bcast(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -44,15 +60,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Bcast_c(
           send_buffer.data(), send_buffer.count().mpi_count(), send_buffer.datatype().mpi_datatype(),
           MPI_ROOT, communicator.mpi_comm());
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{send_buffer, environment};
     auto const error_code
       = MPI_Bcast(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ROOT, communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -61,6 +79,7 @@ namespace yampi
 
   inline void broadcast(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", 0u);
 # if MPI_VERSION >= 4
     auto const error_code = MPI_Bcast_c(nullptr, MPI_Count{0}, MPI_DATATYPE_NULL, MPI_PROC_NULL, communicator.mpi_comm());
 # else // MPI_VERSION >= 4
@@ -77,6 +96,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const root,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -84,9 +104,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Ibcast(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -100,6 +121,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -107,9 +129,10 @@ namespace yampi
           send_buffer.data(), send_buffer.count().mpi_count(), send_buffer.datatype().mpi_datatype(),
           MPI_ROOT, communicator.mpi_comm(), std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{send_buffer, environment};
     auto const error_code
       = MPI_Ibcast(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ROOT, communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -120,6 +143,7 @@ namespace yampi
   inline void broadcast(
     ::yampi::immediate_request& request, ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -146,6 +170,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -163,6 +188,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -177,6 +203,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -194,6 +221,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const root,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -210,6 +238,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -224,6 +253,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Bcast_init_c(
@@ -234,6 +264,133 @@ namespace yampi
     request.reset(mpi_request, environment);
   }
 # endif // MPI_VERSION >= 4
+# if MPI_VERSION >= 3
+  // Two-level broadcast
+  // The root stores its data in the input, the leader of its node copies it to the output, leaders broadcast it
+  // across nodes, and the other processes load it from the output of their nodes. Buffers of datatypes with gaps fall
+  // back to the flat broadcast
+  template <typename Value>
+  inline void broadcast(
+    ::yampi::buffer<Value> buffer, ::yampi::rank const root,
+    ::yampi::hierarchy& hierarchy, ::yampi::environment const& environment)
+  {
+    auto const num_bytes = ::yampi::profiler::num_bytes(buffer, environment);
+    if (not ::yampi::hierarchy_detail::uses_two_level(
+          hierarchy, num_bytes, buffer.datatype().mpi_datatype(), environment))
+    {
+      ::yampi::broadcast(buffer, root, hierarchy.parent(), environment);
+      return;
+    }
+
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", hierarchy.parent(), environment);
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", num_bytes);
+    auto const count = ::yampi::collective_algorithm_detail::count_of(buffer, environment);
+    auto const mpi_datatype = buffer.datatype().mpi_datatype();
+    auto const num_extent_bytes
+      = static_cast<std::size_t>(count)
+        * static_cast<std::size_t>(::yampi::hierarchy_detail::extent_of(mpi_datatype, environment));
+
+    auto const is_root = hierarchy.parent().rank(environment) == root;
+    auto const root_node_index = hierarchy.node_index(root);
+    auto const is_on_root_node = hierarchy.node_index() == root_node_index;
+    auto const buffers = hierarchy.shared_buffers(num_extent_bytes, num_extent_bytes, environment);
+
+    if (is_root)
+      std::memcpy(buffers.first, buffer.data(), num_extent_bytes);
+    hierarchy.synchronize_node(environment);
+
+    if (hierarchy.is_leader())
+    {
+      if (is_on_root_node)
+        std::memcpy(buffers.second, buffers.first, num_extent_bytes);
+
+      if (hierarchy.num_nodes() > 1)
+      {
+        auto const error_code
+          = MPI_Bcast(
+              buffers.second, count, mpi_datatype, root_node_index, hierarchy.leader_communicator().mpi_comm());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::broadcast", environment};
+      }
+    }
+    hierarchy.synchronize_node(environment);
+
+    if (not is_root)
+      std::memcpy(buffer.data(), buffers.second, num_extent_bytes);
+  }
+# endif // MPI_VERSION >= 3
+  // Pipelined broadcast (see <yampi/collective_algorithm.hpp>)
+  template <typename Value>
+  inline void broadcast(
+    ::yampi::pipeline const pipeline,
+    ::yampi::buffer<Value> buffer, ::yampi::rank const root,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
+    ::yampi::collective_algorithm_detail::pipelined_broadcast(
+      buffer, root, pipeline, ::yampi::collective_algorithm_detail::communicator_of(communicator, environment),
+      environment);
+  }
+
+  // Broadcast by the algorithm in user space (see <yampi/collective_algorithm.hpp>)
+  template <typename Value>
+  inline void broadcast(
+    ::yampi::collective_algorithm const algorithm,
+    ::yampi::buffer<Value> buffer, ::yampi::rank const root,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    namespace detail = ::yampi::collective_algorithm_detail;
+    switch (algorithm)
+    {
+     case ::yampi::collective_algorithm::library:
+      ::yampi::broadcast(buffer, root, communicator, environment);
+      return;
+     case ::yampi::collective_algorithm::autotuned:
+     {
+      // trials broadcast a temporary, so that buffer is kept
+      ::yampi::scratch_buffer<typename std::remove_cv<Value>::type> trial(
+        detail::count_of(buffer, environment));
+      auto const trial_buffer = detail::make_buffer_like(buffer, trial.begin(), trial.end());
+      auto const selected
+        = ::yampi::collective_autotuner::of(communicator, environment).select(
+            ::yampi::collective_autotuner::make_key(
+              "broadcast", buffer.datatype().mpi_datatype(), MPI_OP_NULL,
+              ::yampi::profiler::num_bytes(buffer, environment), communicator, environment),
+            [&](::yampi::collective_algorithm const candidate)
+            { ::yampi::broadcast(candidate, trial_buffer, root, communicator, environment); },
+            communicator, environment);
+      ::yampi::broadcast(selected, buffer, root, communicator, environment);
+      return;
+     }
+     case ::yampi::collective_algorithm::ring:
+     {
+      YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", communicator, environment);
+      YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
+      detail::chain_broadcast(buffer, root, detail::communicator_of(communicator, environment), environment);
+      return;
+     }
+     case ::yampi::collective_algorithm::recursive_doubling:
+     case ::yampi::collective_algorithm::binomial_tree:
+     {
+      YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", communicator, environment);
+      YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
+      detail::binomial_broadcast(buffer, root, detail::communicator_of(communicator, environment), environment);
+      return;
+     }
+     case ::yampi::collective_algorithm::rabenseifner:
+     {
+      YAMPI_MEASURE_LOAD_IMBALANCE("yampi::broadcast", communicator, environment);
+      YAMPI_PROFILE_SCOPE("yampi::broadcast", ::yampi::profiler::num_bytes(buffer, environment));
+      auto const offsets
+        = detail::block_offsets(detail::count_of(buffer, environment), communicator.size(environment));
+      auto const& algorithm_communicator = detail::communicator_of(communicator, environment);
+      detail::binomial_scatter(buffer, offsets, root, algorithm_communicator, environment);
+      detail::ring_all_gather(buffer, offsets, root, algorithm_communicator, environment);
+      return;
+     }
+    }
+  }
 }
 
 
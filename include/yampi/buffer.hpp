@@ -2,6 +2,7 @@
 # define YAMPI_BUFFER_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <iterator>
 # include <utility>
 # include <type_traits>
@@ -17,8 +18,12 @@
 # include <yampi/datatype.hpp>
 # include <yampi/predefined_datatype.hpp>
 # include <yampi/has_predefined_datatype.hpp>
+# include <yampi/datatype_of.hpp>
+# include <yampi/environment.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/count.hpp>
+# else // MPI_VERSION >= 4
+#   include <yampi/large_count.hpp>
 # endif
 
 # if __cplusplus >= 201703L
@@ -51,12 +56,17 @@ namespace yampi
     ::yampi::count count_;
 # else // MPI_VERSION >= 4
     int count_;
+    // the number of elements, which may exceed INT_MAX (see <yampi/large_count.hpp>)
+    std::ptrdiff_t large_count_;
 # endif
     ::yampi::datatype* datatype_ptr_;
 
    public:
     buffer(T& value, ::yampi::datatype const& datatype) noexcept
       : data_{const_cast<value_type*>(std::addressof(value))}, count_{1},
+# if MPI_VERSION < 4
+        large_count_{1},
+# endif // MPI_VERSION < 4
         datatype_ptr_{const_cast< ::yampi::datatype* >(std::addressof(datatype))}
     { }
 
@@ -85,7 +95,7 @@ namespace yampi
       ::yampi::datatype const& datatype)
       noexcept(noexcept(*first) and noexcept(last-first))
       : data_{const_cast<T*>(std::addressof(*first))},
-        count_{static_cast<int>(last-first)},
+        count_{static_cast<int>(last-first)}, large_count_{static_cast<std::ptrdiff_t>(last-first)},
         datatype_ptr_{const_cast< ::yampi::datatype* >(std::addressof(datatype))}
     {
       static_assert(
@@ -105,8 +115,22 @@ namespace yampi
     const_pointer data() const noexcept { return data_; }
 # if MPI_VERSION >= 4
     ::yampi::count const& count() const noexcept { return count_; }
+    ::yampi::count const& count(::yampi::environment const&) const noexcept { return count_; }
 # else // MPI_VERSION >= 4
-    int const& count() const noexcept { return count_; }
+    // count() only for at most INT_MAX elements; wrappers handling more use large_count() (see <yampi/large_count.hpp>)
+    int const& count() const noexcept
+    {
+      assert(large_count_ <= ::yampi::large_count_detail::max_count);
+      return count_;
+    }
+    // throws ::yampi::error with MPI_ERR_COUNT for more than INT_MAX elements
+    int const& count(::yampi::environment const& environment) const
+    {
+      return large_count_ <= ::yampi::large_count_detail::max_count
+        ? count_
+        : throw ::yampi::error{MPI_ERR_COUNT, "yampi::buffer::count", environment};
+    }
+    std::ptrdiff_t large_count() const noexcept { return large_count_; }
 # endif
     ::yampi::datatype const& datatype() const noexcept { return *datatype_ptr_; }
 
@@ -115,6 +139,9 @@ namespace yampi
       using std::swap;
       swap(data_, other.data_);
       swap(count_, other.count_);
+# if MPI_VERSION < 4
+      swap(large_count_, other.large_count_);
+# endif // MPI_VERSION < 4
       swap(datatype_ptr_, other.datatype_ptr_);
     }
   }; // class buffer<T, Enable>
@@ -140,11 +167,16 @@ namespace yampi
     ::yampi::count count_;
 # else // MPI_VERSION >= 4
     int count_;
+    // the number of elements, which may exceed INT_MAX (see <yampi/large_count.hpp>)
+    std::ptrdiff_t large_count_;
 # endif
 
    public:
     explicit buffer(T& value) noexcept
       : data_{const_cast<value_type*>(std::addressof(value))}, count_{1}
+# if MPI_VERSION < 4
+        , large_count_{1}
+# endif // MPI_VERSION < 4
     { }
 
 # if MPI_VERSION >= 4
@@ -167,7 +199,7 @@ namespace yampi
     buffer(ContiguousIterator const first, ContiguousIterator const last)
       noexcept(noexcept(*first) and noexcept(last-first))
       : data_{const_cast<T*>(std::addressof(*first))},
-        count_{static_cast<int>(last-first)}
+        count_{static_cast<int>(last-first)}, large_count_{static_cast<std::ptrdiff_t>(last-first)}
     {
       static_assert(
         (std::is_same<
@@ -186,8 +218,22 @@ namespace yampi
     const_pointer data() const noexcept { return data_; }
 # if MPI_VERSION >= 4
     ::yampi::count const& count() const noexcept { return count_; }
+    ::yampi::count const& count(::yampi::environment const&) const noexcept { return count_; }
 # else // MPI_VERSION >= 4
-    int const& count() const noexcept { return count_; }
+    // count() only for at most INT_MAX elements; wrappers handling more use large_count() (see <yampi/large_count.hpp>)
+    int const& count() const noexcept
+    {
+      assert(large_count_ <= ::yampi::large_count_detail::max_count);
+      return count_;
+    }
+    // throws ::yampi::error with MPI_ERR_COUNT for more than INT_MAX elements
+    int const& count(::yampi::environment const& environment) const
+    {
+      return large_count_ <= ::yampi::large_count_detail::max_count
+        ? count_
+        : throw ::yampi::error{MPI_ERR_COUNT, "yampi::buffer::count", environment};
+    }
+    std::ptrdiff_t large_count() const noexcept { return large_count_; }
 # endif
     ::yampi::predefined_datatype<T> datatype() const noexcept { return ::yampi::predefined_datatype<T>(); }
 
@@ -196,6 +242,9 @@ namespace yampi
       using std::swap;
       swap(data_, other.data_);
       swap(count_, other.count_);
+# if MPI_VERSION < 4
+      swap(large_count_, other.large_count_);
+# endif // MPI_VERSION < 4
     }
   }; // class buffer<T, typename std::enable_if< ::yampi::has_predefined_datatype<T>::value >::type>
 
@@ -223,6 +272,13 @@ namespace yampi
     noexcept(noexcept(::yampi::buffer<T>(value, datatype)))
   { return ::yampi::buffer<T>(value, datatype); }
 
+  // with ::yampi::datatype_of<T>(environment)
+  template <typename T>
+  inline
+  typename std::enable_if<not ::yampi::has_predefined_datatype<T>::value, ::yampi::buffer<T> >::type
+  make_buffer(T& value, ::yampi::environment const& environment)
+  { return ::yampi::buffer<T>(value, ::yampi::datatype_of<T>(environment)); }
+
   template <typename ContiguousIterator>
   inline
   typename std::enable_if<
@@ -272,6 +328,22 @@ namespace yampi
     return result_type(first, last, datatype);
   }
 
+  // with ::yampi::datatype_of<T>(environment)
+  template <typename ContiguousIterator>
+  inline
+  typename std::enable_if<
+    not ::yampi::has_predefined_datatype<typename std::iterator_traits<ContiguousIterator>::value_type>::value,
+    ::yampi::buffer<typename std::iterator_traits<ContiguousIterator>::value_type>
+  >::type make_buffer(
+    ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
+  {
+    typedef
+      ::yampi::buffer<typename std::iterator_traits<ContiguousIterator>::value_type>
+      result_type;
+    return result_type(
+      first, last, ::yampi::datatype_of<typename std::iterator_traits<ContiguousIterator>::value_type>(environment));
+  }
+
   template <typename ContiguousRange>
   inline
   typename std::enable_if<
@@ -321,6 +393,23 @@ namespace yampi
   range_to_buffer(ContiguousRange const& range, ::yampi::datatype const& datatype)
     noexcept(noexcept(::yampi::make_buffer(std::begin(range), std::end(range), datatype)))
   { return ::yampi::make_buffer(std::begin(range), std::end(range), datatype); }
+
+  // with ::yampi::datatype_of<T>(environment)
+  template <typename ContiguousRange>
+  inline
+  typename std::enable_if<
+    not ::yampi::has_predefined_datatype<typename boost::range_value<ContiguousRange>::type>::value,
+    ::yampi::buffer<typename boost::range_value<ContiguousRange>::type>
+  >::type range_to_buffer(ContiguousRange& range, ::yampi::environment const& environment)
+  { return ::yampi::make_buffer(std::begin(range), std::end(range), environment); }
+
+  template <typename ContiguousRange>
+  inline
+  typename std::enable_if<
+    not ::yampi::has_predefined_datatype<typename boost::range_value<ContiguousRange const>::type>::value,
+    ::yampi::buffer<typename boost::range_value<ContiguousRange const>::type>
+  >::type range_to_buffer(ContiguousRange const& range, ::yampi::environment const& environment)
+  { return ::yampi::make_buffer(std::begin(range), std::end(range), environment); }
 }
 
 
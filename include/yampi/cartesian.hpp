@@ -15,6 +15,7 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/rank.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -90,6 +91,7 @@ namespace yampi
       bool const is_reorderable,
       ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::cartesian::create", 0u);
       static_assert(
         (std::is_same<
            typename std::remove_cv<
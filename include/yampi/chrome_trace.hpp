@@ -0,0 +1,328 @@
+#ifndef YAMPI_CHROME_TRACE_HPP
+# define YAMPI_CHROME_TRACE_HPP
+
+# include <cstddef>
+# include <limits>
+# include <new>
+# include <array>
+# include <vector>
+# include <string>
+# include <atomic>
+# include <memory>
+# include <ostream>
+# include <algorithm>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Per-process ring buffer of timeline events, exported as Chrome trace JSON (chrome://tracing, Perfetto).
+//
+// yampi::chrome_trace is a profiler policy; include this header first with
+//
+//   # define YAMPI_PROFILER ::yampi::chrome_trace
+//   # include <yampi/chrome_trace.hpp>
+//
+// Then every point-to-point, collective and RMA call (and RMA epochs of lock_guard, access_guard and
+// exposure_guard) is stored as a complete event stamped with MPI_Wtime, the clock of yampi::wall_clock.
+// When the buffer is full, the oldest events are overwritten. Events may be recorded from any thread.
+namespace yampi
+{
+  class chrome_trace
+  {
+   public:
+    struct record
+    {
+      char const* where;
+      double begin;
+      double end;
+      std::size_t num_bytes;
+      int thread;
+    };
+
+    static constexpr std::size_t default_capacity = std::size_t{1u} << 16u;
+
+   private:
+    // depth of nested calls and epochs kept per thread
+    static constexpr std::size_t max_depth = 64u;
+
+    struct begin_stack
+    {
+      std::array<double, max_depth> times;
+      std::size_t depth;
+      int thread;
+    };
+
+    // A thread overwriting the slot of an old event may race with another thread or write(), so each slot is locked
+    struct slot
+    {
+      std::atomic<bool> is_locked{false};
+      record value;
+    };
+
+    std::unique_ptr<slot[]> slots_;
+    std::size_t capacity_;
+    std::atomic<std::size_t> num_records_;
+
+    std::ostream* finalize_output_ptr_;
+    ::yampi::environment const* environment_ptr_;
+
+    // If the ring buffer can't be allocated, events are dropped until reserve is called
+    chrome_trace() noexcept
+      : slots_{new (std::nothrow) slot[default_capacity]}, capacity_{slots_ ? default_capacity : std::size_t{0u}},
+        num_records_{0u}, finalize_output_ptr_{nullptr}, environment_ptr_{nullptr}
+    { }
+
+   public:
+    chrome_trace(chrome_trace const&) = delete;
+    chrome_trace& operator=(chrome_trace const&) = delete;
+
+    // The instance is never destroyed, so that events can be recorded and written until MPI_Finalize
+    static ::yampi::chrome_trace& instance() noexcept
+    {
+      alignas(::yampi::chrome_trace) static unsigned char storage[sizeof(::yampi::chrome_trace)];
+      static auto& result = *::new(static_cast<void*>(storage)) ::yampi::chrome_trace{};
+      return result;
+    }
+
+    static void begin(::yampi::profiler::event const&) noexcept
+    {
+      auto& stack = this_thread_stack();
+      if (stack.depth < max_depth)
+        stack.times[stack.depth] = MPI_Wtime();
+      ++stack.depth;
+    }
+
+    static void end(::yampi::profiler::event const& event) noexcept
+    {
+      auto& stack = this_thread_stack();
+      if (stack.depth == 0u)
+        return;
+
+      --stack.depth;
+      if (stack.depth < max_depth)
+        instance().push(record{event.where, stack.times[stack.depth], MPI_Wtime(), event.num_bytes, stack.thread});
+    }
+
+    // Discards recorded events. Not thread-safe
+    void reserve(std::size_t const capacity)
+    {
+      slots_.reset(new slot[std::max(capacity, std::size_t{1u})]);
+      capacity_ = std::max(capacity, std::size_t{1u});
+      num_records_.store(0u, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept { num_records_.store(0u, std::memory_order_relaxed); }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t size() const noexcept { return std::min(num_records_.load(std::memory_order_relaxed), capacity_); }
+
+    // Collective over the world communicator. The lowest I/O process writes the merged trace, receiving the events of
+    // one process at a time. Timestamps of all processes are aligned at a barrier, so clocks need not be synchronized
+    void write(std::ostream& out, ::yampi::environment const& environment) const
+    {
+      auto const root = writer_rank(environment);
+
+      // events are sent on a duplicate of the world communicator, so that they never match receives of users
+      MPI_Comm mpi_comm;
+      auto const error_code = MPI_Comm_dup(MPI_COMM_WORLD, std::addressof(mpi_comm));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+
+      try
+      {
+        do_write(out, root, mpi_comm, environment);
+      }
+      catch (...)
+      {
+        MPI_Comm_free(std::addressof(mpi_comm));
+        throw;
+      }
+      MPI_Comm_free(std::addressof(mpi_comm));
+    }
+
+    // write(out, environment) is called when environment finalizes MPI.
+    // out must be alive until then, and every process must call this
+    void write_at_finalize(std::ostream& out, ::yampi::environment const& environment)
+    {
+      auto const is_registered = finalize_output_ptr_ != nullptr;
+      finalize_output_ptr_ = std::addressof(out);
+      environment_ptr_ = std::addressof(environment);
+      if (is_registered)
+        return;
+
+      auto const error_code
+        = ::yampi::detail::at_finalize(
+            [this]()
+            {
+              if (finalize_output_ptr_ != nullptr)
+                write(*finalize_output_ptr_, *environment_ptr_);
+            });
+      if (error_code != MPI_SUCCESS)
+      {
+        finalize_output_ptr_ = nullptr;
+        throw ::yampi::error{error_code, "yampi::chrome_trace::write_at_finalize", environment};
+      }
+    }
+
+   private:
+    void do_write(
+      std::ostream& out, int const root, MPI_Comm const mpi_comm, ::yampi::environment const& environment) const
+    {
+      int present_rank;
+      MPI_Comm_rank(mpi_comm, std::addressof(present_rank));
+
+      auto error_code = MPI_Barrier(mpi_comm);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+      auto const synchronized_time = MPI_Wtime();
+
+      auto const num_records = size();
+      auto const first = num_records_.load(std::memory_order_relaxed) > capacity_
+        ? num_records_.load(std::memory_order_relaxed) % capacity_
+        : std::size_t{0u};
+
+      std::vector<record> records;
+      records.reserve(num_records);
+      for (auto index = std::size_t{0u}; index < num_records; ++index)
+        records.push_back(load((first + index) % capacity_));
+
+      auto local_offset = 0.0;
+      for (auto const& record: records)
+        local_offset = std::max(local_offset, synchronized_time - record.begin);
+      auto offset = 0.0;
+      error_code = MPI_Allreduce(std::addressof(local_offset), std::addressof(offset), 1, MPI_DOUBLE, MPI_MAX, mpi_comm);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+
+      // each event is preceded by a separator, because metadata events of processes come first
+      std::string events;
+      for (auto const& record: records)
+      {
+        events += ",\n{\"name\":\"";
+        events += record.where;
+        events += "\",\"cat\":\"yampi\",\"ph\":\"X\",\"pid\":";
+        events += std::to_string(present_rank);
+        events += ",\"tid\":";
+        events += std::to_string(record.thread);
+        events += ",\"ts\":";
+        events += std::to_string((record.begin - synchronized_time + offset) * 1.0e6);
+        events += ",\"dur\":";
+        events += std::to_string((record.end - record.begin) * 1.0e6);
+        events += ",\"args\":{\"bytes\":";
+        events += std::to_string(record.num_bytes);
+        events += "}}";
+      }
+
+      int size;
+      MPI_Comm_size(mpi_comm, std::addressof(size));
+      auto const is_root = present_rank == root;
+      std::vector<unsigned long long> lengths(is_root ? size : 0);
+      auto const length = static_cast<unsigned long long>(events.size());
+      error_code
+        = MPI_Gather(
+            std::addressof(length), 1, MPI_UNSIGNED_LONG_LONG,
+            lengths.data(), 1, MPI_UNSIGNED_LONG_LONG, root, mpi_comm);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+
+      // events longer than INT_MAX characters are sent in pieces
+      auto const max_message_length = static_cast<std::size_t>(std::numeric_limits<int>::max());
+      if (not is_root)
+      {
+        for (auto first_char = std::size_t{0u}; first_char < events.size(); first_char += max_message_length)
+        {
+          auto const piece_length = std::min(events.size() - first_char, max_message_length);
+          error_code
+            = MPI_Send(events.data() + first_char, static_cast<int>(piece_length), MPI_CHAR, root, 0, mpi_comm);
+          if (error_code != MPI_SUCCESS)
+            throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+        }
+        return;
+      }
+
+      out << "{\"traceEvents\":[";
+      for (auto rank = 0; rank < size; ++rank)
+        out
+          << (rank == 0 ? "\n" : ",\n")
+          << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+          << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+      std::vector<char> piece;
+      for (auto rank = 0; rank < size; ++rank)
+      {
+        if (rank == root)
+        {
+          out.write(events.data(), static_cast<std::streamsize>(events.size()));
+          continue;
+        }
+
+        auto const rank_length = static_cast<std::size_t>(lengths[rank]);
+        piece.resize(std::min(rank_length, max_message_length));
+        for (auto first_char = std::size_t{0u}; first_char < rank_length; first_char += max_message_length)
+        {
+          auto const piece_length = std::min(rank_length - first_char, max_message_length);
+          error_code
+            = MPI_Recv(
+                piece.data(), static_cast<int>(piece_length), MPI_CHAR, rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+          if (error_code != MPI_SUCCESS)
+            throw ::yampi::error{error_code, "yampi::chrome_trace::write", environment};
+          out.write(piece.data(), static_cast<std::streamsize>(piece_length));
+        }
+      }
+      out << "\n],\"displayTimeUnit\":\"ns\"}\n" << std::flush;
+    }
+
+    void push(record const& new_record) noexcept
+    {
+      if (capacity_ == 0u)
+        return;
+
+      auto& slot = slots_[num_records_.fetch_add(1u, std::memory_order_relaxed) % capacity_];
+      while (slot.is_locked.exchange(true, std::memory_order_acquire))
+        ;
+      slot.value = new_record;
+      slot.is_locked.store(false, std::memory_order_release);
+    }
+
+    record load(std::size_t const index) const noexcept
+    {
+      auto& slot = slots_[index];
+      while (slot.is_locked.exchange(true, std::memory_order_acquire))
+        ;
+      auto const result = slot.value;
+      slot.is_locked.store(false, std::memory_order_release);
+      return result;
+    }
+
+    // Threads are numbered without instance(), so that begin() allocates nothing
+    static begin_stack& this_thread_stack() noexcept
+    {
+      static std::atomic<int> num_threads{0};
+      thread_local begin_stack result{{}, 0u, num_threads.fetch_add(1, std::memory_order_relaxed)};
+      return result;
+    }
+
+    static int writer_rank(::yampi::environment const& environment)
+    {
+      auto const io_process = ::yampi::io_process(environment);
+      if (io_process == ::yampi::any_source or io_process.is_null())
+        return 0;
+
+      auto const local_rank = io_process.mpi_rank();
+      auto result = 0;
+      auto const error_code = MPI_Allreduce(std::addressof(local_rank), std::addressof(result), 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+      return error_code == MPI_SUCCESS
+        ? result
+        : throw ::yampi::error{error_code, "yampi::chrome_trace::writer_rank", environment};
+    }
+  };
+}
+
+
+#endif
@@ -0,0 +1,695 @@
+#ifndef YAMPI_COLLECTIVE_ALGORITHM_HPP
+# define YAMPI_COLLECTIVE_ALGORITHM_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <limits>
+# include <memory>
+# include <type_traits>
+# include <algorithm>
+# include <vector>
+# include <utility>
+
+# include <mpi.h>
+
+# include <yampi/buffer.hpp>
+# include <yampi/has_predefined_datatype.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/communicator.hpp>
+# include <yampi/binary_operation.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/tag.hpp>
+# include <yampi/status.hpp>
+# include <yampi/send.hpp>
+# include <yampi/receive.hpp>
+# include <yampi/send_receive.hpp>
+# include <yampi/immediate_request.hpp>
+# include <yampi/wait_all.hpp>
+# include <yampi/scratch_buffer.hpp>
+# include <yampi/reduce_local.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Algorithms of collectives in user space.
+//
+// all_reduce, broadcast, all_gather and reduce_scatter have overloads taking ::yampi::collective_algorithm as their
+// first arguments (after ::yampi::in_place), which force the algorithm instead of leaving the choice to the MPI library
+//
+//   ::yampi::all_reduce(::yampi::collective_algorithm::rabenseifner, send_buffer, first, operation, communicator, environment);
+//
+// The algorithms are built on point-to-point communication on a duplicate of the communicator, which is created on the
+// first call of an algorithm on the communicator, cached as its attribute and freed with it, and draw temporaries from
+// ::yampi::scratch_buffer. Only the algorithms communicate on the duplicate, so their messages never match messages of
+// users, and collectives are called in the same order on all processes, so they don't overtake each other. Counts are
+// int's in the algorithms, so buffers of more than INT_MAX elements throw ::yampi::error with MPI_ERR_COUNT.
+//
+// library            the collective of the MPI library
+// ring               ring: 2(p-1) steps of n/p elements for all_reduce; a chain for broadcast
+// recursive_doubling recursive doubling of the whole message for all_reduce; recursive halving for reduce_scatter;
+//                    Bruck's algorithm for all_gather; the binomial tree for broadcast
+// binomial_tree      reduction to (or gather to) rank 0 and broadcast from it on binomial trees
+// rabenseifner       recursive-halving reduce-scatter and recursive-doubling all-gather for all_reduce; binomial scatter
+//                    and ring all-gather for broadcast (van de Geijn's); the same as recursive_doubling otherwise
+// autotuned          one of the above selected by ::yampi::collective_autotuner (see <yampi/collective_autotuner.hpp>)
+//
+// broadcast also has overloads taking ::yampi::pipeline, which pipelines segments of messages down a chain or a binary
+// tree with immediate requests.
+//
+// ring, rabenseifner and recursive_doubling for reduce_scatter reduce elements in different orders on different
+// processes, so binomial_tree runs instead of them for noncommutative operations. Processes of any numbers are supported; recursive doubling and
+// halving fold the processes into the largest power of two first.
+namespace yampi
+{
+  enum class collective_algorithm
+  {
+    library, ring, recursive_doubling, binomial_tree, rabenseifner, autotuned
+  };
+
+  enum class pipeline_shape
+  {
+    chain, binary_tree
+  };
+
+  // Pipelined broadcast of large messages: messages are split into segments of segment_size elements, and processes
+  // forward segment k to their children while segment k+1 is arriving
+  struct pipeline
+  {
+    ::yampi::pipeline_shape shape;
+    int segment_size;
+  };
+
+  namespace collective_algorithm_detail
+  {
+    // any tag does because only the algorithms communicate on the communicators of communicator_of
+# if __cplusplus >= 201703L
+    inline constexpr ::yampi::tag tag{0};
+# else
+    constexpr ::yampi::tag tag{0};
+# endif
+
+    inline int delete_communicator(MPI_Comm, int, void* attribute, void*)
+    {
+      delete static_cast< ::yampi::communicator* >(attribute);
+      return MPI_SUCCESS;
+    }
+
+    // the keyval is freed at MPI_Finalize
+    inline int communicator_keyval(::yampi::environment const& environment)
+    {
+      static int const result
+        = [&environment]()
+          {
+            int keyval = MPI_KEYVAL_INVALID;
+            auto error_code
+              = MPI_Comm_create_keyval(
+                  MPI_COMM_NULL_COPY_FN, &::yampi::collective_algorithm_detail::delete_communicator,
+                  std::addressof(keyval), nullptr);
+            if (error_code != MPI_SUCCESS)
+              throw ::yampi::error{
+                error_code, "yampi::collective_algorithm_detail::communicator_keyval", environment};
+
+            error_code
+              = ::yampi::detail::at_finalize([keyval]() mutable { MPI_Comm_free_keyval(std::addressof(keyval)); });
+            if (error_code != MPI_SUCCESS)
+            {
+              MPI_Comm_free_keyval(std::addressof(keyval));
+              throw ::yampi::error{
+                error_code, "yampi::collective_algorithm_detail::communicator_keyval", environment};
+            }
+            return keyval;
+          }();
+      return result;
+    }
+
+    // Returns the duplicate of communicator cached as its attribute, duplicating communicator first if there is none.
+    // Collective over communicator on the first call
+    inline ::yampi::communicator const& communicator_of(
+      ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+    {
+      auto const keyval = ::yampi::collective_algorithm_detail::communicator_keyval(environment);
+      void* attribute;
+      int flag;
+      auto error_code
+        = MPI_Comm_get_attr(communicator.mpi_comm(), keyval, std::addressof(attribute), std::addressof(flag));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_algorithm_detail::communicator_of", environment};
+      if (static_cast<bool>(flag))
+        return *static_cast< ::yampi::communicator* >(attribute);
+
+      std::unique_ptr< ::yampi::communicator > duplicate_ptr{new ::yampi::communicator{communicator, environment}};
+      error_code = MPI_Comm_set_attr(communicator.mpi_comm(), keyval, duplicate_ptr.get());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_algorithm_detail::communicator_of", environment};
+      return *duplicate_ptr.release();
+    }
+
+    template <typename Count>
+    inline int checked_count(Count const count, ::yampi::environment const& environment)
+    {
+      return count <= static_cast<Count>(std::numeric_limits<int>::max())
+        ? static_cast<int>(count)
+        : throw ::yampi::error{MPI_ERR_COUNT, "yampi::collective_algorithm_detail::checked_count", environment};
+    }
+
+    template <typename Value>
+    inline int count_of(::yampi::buffer<Value> const& buffer, ::yampi::environment const& environment)
+    {
+# if MPI_VERSION >= 4
+      return checked_count(buffer.count().mpi_count(), environment);
+# else // MPI_VERSION >= 4
+      return checked_count(buffer.large_count(), environment);
+# endif // MPI_VERSION >= 4
+    }
+
+    // MPI_OP_NULL, which collectives without operations pass, is regarded as commutative
+    inline bool is_commutative(MPI_Op const mpi_op, ::yampi::environment const& environment)
+    {
+      if (mpi_op == MPI_OP_NULL)
+        return true;
+
+      int commute;
+      auto const error_code = MPI_Op_commutative(mpi_op, std::addressof(commute));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_algorithm_detail::is_commutative", environment};
+      return static_cast<bool>(commute);
+    }
+
+    // Whether algorithm reduces elements in the order of ranks on all processes, which noncommutative operations need
+    inline bool is_order_preserving(
+      ::yampi::collective_algorithm const algorithm, bool const is_reduce_scatter) noexcept
+    {
+      switch (algorithm)
+      {
+       case ::yampi::collective_algorithm::ring:
+       case ::yampi::collective_algorithm::rabenseifner:
+        return false;
+       case ::yampi::collective_algorithm::recursive_doubling:
+        return not is_reduce_scatter;
+       case ::yampi::collective_algorithm::library:
+       case ::yampi::collective_algorithm::binomial_tree:
+       case ::yampi::collective_algorithm::autotuned:
+        return true;
+      }
+      return true;
+    }
+
+    // binomial_tree instead of the algorithms not preserving the order for noncommutative operations
+    inline ::yampi::collective_algorithm algorithm_for(
+      ::yampi::collective_algorithm const algorithm, ::yampi::binary_operation const& operation,
+      bool const is_reduce_scatter, ::yampi::environment const& environment)
+    {
+      return ::yampi::collective_algorithm_detail::is_order_preserving(algorithm, is_reduce_scatter)
+          or ::yampi::collective_algorithm_detail::is_commutative(operation.mpi_op(), environment)
+        ? algorithm
+        : ::yampi::collective_algorithm::binomial_tree;
+    }
+
+    // [first, last) of the part of the elements [0, count) the process of rank in size processes takes
+    inline std::pair<int, int> partition(int const count, int const rank, int const size) noexcept
+    {
+      auto const quotient = count / size;
+      auto const remainder = count % size;
+      auto const first = rank * quotient + std::min(rank, remainder);
+      return std::make_pair(first, first + quotient + (rank < remainder ? 1 : 0));
+    }
+
+    // offsets[index] is the first element of block index in the elements [0, count) split into num_blocks blocks
+    inline std::vector<int> block_offsets(int const count, int const num_blocks)
+    {
+      std::vector<int> result(num_blocks + 1);
+      for (auto index = 0; index < num_blocks; ++index)
+        result[index] = partition(count, index, num_blocks).first;
+      result[num_blocks] = count;
+      return result;
+    }
+
+    // Buffer of [first, last) with the datatype of prototype
+    template <typename Value, typename PrototypeValue>
+    inline typename std::enable_if< ::yampi::has_predefined_datatype<Value>::value, ::yampi::buffer<Value> >::type
+    make_buffer_like(::yampi::buffer<PrototypeValue> const&, Value* first, Value* last)
+    { return ::yampi::buffer<Value>(first, last); }
+
+    template <typename Value, typename PrototypeValue>
+    inline typename std::enable_if<not ::yampi::has_predefined_datatype<Value>::value, ::yampi::buffer<Value> >::type
+    make_buffer_like(::yampi::buffer<PrototypeValue> const& prototype, Value* first, Value* last)
+    { return ::yampi::buffer<Value>(first, last, prototype.datatype()); }
+
+    template <typename Value>
+    inline ::yampi::buffer<Value> sub_buffer(::yampi::buffer<Value> buffer, int const first, int const last)
+    { return make_buffer_like(buffer, buffer.data() + first, buffer.data() + last); }
+
+    // inout = in op inout
+    template <typename Value>
+    inline void reduce_local(
+      Value const* in, Value* inout, int const count, ::yampi::buffer<Value> const& prototype,
+      ::yampi::binary_operation const& operation, ::yampi::environment const& environment)
+    {
+      ::yampi::reduce_local_detail::reduce_local(
+        in, inout, count, prototype.datatype().mpi_datatype(), operation.mpi_op(), environment);
+    }
+
+    template <typename Value>
+    inline void exchange(
+      ::yampi::buffer<Value> const send_buffer, ::yampi::rank const destination,
+      ::yampi::buffer<Value> receive_buffer, ::yampi::rank const source,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      ::yampi::send_receive(
+        ::yampi::ignore_status, send_buffer, destination, tag, receive_buffer, source, tag, communicator, environment);
+    }
+
+    inline ::yampi::rank rank_of(int const relative_rank, ::yampi::rank const root, int const size) noexcept
+    { return ::yampi::rank{(relative_rank + root.mpi_rank()) % size}; }
+
+    inline int relative_rank_of(::yampi::rank const rank, ::yampi::rank const root, int const size) noexcept
+    { return (rank.mpi_rank() - root.mpi_rank() + size) % size; }
+
+    inline int largest_power_of_two(int const size) noexcept
+    {
+      auto result = 1;
+      while (result * 2 <= size)
+        result *= 2;
+      return result;
+    }
+
+    // Processes of ranks [0, 2r) for r = size - largest_power_of_two(size) are paired, and the even ranks pass
+    // their data to the odd ranks, so that a power of two of processes remain
+    inline int folded_rank_of(int const rank, int const size) noexcept
+    {
+      auto const remainder = size - largest_power_of_two(size);
+      return rank < 2 * remainder
+        ? (rank % 2 == 0 ? -1 : rank / 2)
+        : rank - remainder;
+    }
+
+    inline ::yampi::rank unfolded_rank_of(int const folded_rank, int const size) noexcept
+    {
+      auto const remainder = size - largest_power_of_two(size);
+      return ::yampi::rank{folded_rank < remainder ? 2 * folded_rank + 1 : folded_rank + remainder};
+    }
+
+    // Returns the folded rank of the calling process, or -1 if it is left out
+    template <typename Value>
+    inline int fold(
+      ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      auto const result = folded_rank_of(rank, size);
+      if (rank >= 2 * (size - largest_power_of_two(size)))
+        return result;
+
+      if (result < 0)
+      {
+        ::yampi::send(buffer, ::yampi::rank{rank + 1}, tag, communicator, environment);
+        return result;
+      }
+
+      auto const count = count_of(buffer, environment);
+      ::yampi::scratch_buffer<Value> temporary(count);
+      ::yampi::receive(
+        ::yampi::ignore_status, make_buffer_like(buffer, temporary.begin(), temporary.end()), ::yampi::rank{rank - 1}, tag,
+        communicator, environment);
+      reduce_local(temporary.data(), buffer.data(), count, buffer, operation, environment);
+      return result;
+    }
+
+    template <typename Value>
+    inline void unfold(
+      ::yampi::buffer<Value> buffer, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      if (rank >= 2 * (size - largest_power_of_two(size)))
+        return;
+
+      if (rank % 2 == 0)
+        ::yampi::receive(::yampi::ignore_status, buffer, ::yampi::rank{rank + 1}, tag, communicator, environment);
+      else
+        ::yampi::send(buffer, ::yampi::rank{rank - 1}, tag, communicator, environment);
+    }
+
+    // Block index of offsets ends up at rank index, reduced over all processes
+    template <typename Value>
+    inline void ring_reduce_scatter(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets, ::yampi::binary_operation const& operation,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      assert(static_cast<int>(offsets.size()) == size + 1);
+      auto max_block_size = 0;
+      for (auto index = 0; index < size; ++index)
+        max_block_size = std::max(max_block_size, offsets[index + 1] - offsets[index]);
+      ::yampi::scratch_buffer<Value> temporary(max_block_size);
+
+      auto const right = ::yampi::rank{(rank + 1) % size};
+      auto const left = ::yampi::rank{(rank + size - 1) % size};
+      for (auto step = 0; step < size - 1; ++step)
+      {
+        auto const send_block = (rank + 2 * size - step - 1) % size;
+        auto const receive_block = (rank + 2 * size - step - 2) % size;
+        auto const receive_count = offsets[receive_block + 1] - offsets[receive_block];
+        exchange(
+          sub_buffer(buffer, offsets[send_block], offsets[send_block + 1]), right,
+          make_buffer_like(buffer, temporary.data(), temporary.data() + receive_count), left,
+          communicator, environment);
+        reduce_local(
+          temporary.data(), buffer.data() + offsets[receive_block], receive_count, buffer, operation, environment);
+      }
+    }
+
+    // Block index of offsets is that of relative rank index to root
+    template <typename Value>
+    inline void ring_all_gather(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets, ::yampi::rank const root,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      assert(static_cast<int>(offsets.size()) == size + 1);
+      auto const relative_rank = relative_rank_of(communicator.rank(environment), root, size);
+      auto const right = rank_of(relative_rank + 1, root, size);
+      auto const left = rank_of(relative_rank + size - 1, root, size);
+      for (auto step = 0; step < size - 1; ++step)
+      {
+        auto const send_block = (relative_rank + size - step) % size;
+        auto const receive_block = (relative_rank + size - step - 1) % size;
+        exchange(
+          sub_buffer(buffer, offsets[send_block], offsets[send_block + 1]), right,
+          sub_buffer(buffer, offsets[receive_block], offsets[receive_block + 1]), left,
+          communicator, environment);
+      }
+    }
+
+    // Among the folded processes. Reduces elements in the order of ranks
+    template <typename Value>
+    inline void recursive_doubling_all_reduce(
+      ::yampi::buffer<Value> buffer, int const folded_rank, ::yampi::binary_operation const& operation,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      auto const folded_size = largest_power_of_two(size);
+      auto const count = count_of(buffer, environment);
+      ::yampi::scratch_buffer<Value> temporary(count);
+      auto const temporary_buffer = make_buffer_like(buffer, temporary.begin(), temporary.end());
+
+      for (auto mask = 1; mask < folded_size; mask *= 2)
+      {
+        auto const partner = folded_rank ^ mask;
+        auto const partner_rank = unfolded_rank_of(partner, size);
+        exchange(buffer, partner_rank, temporary_buffer, partner_rank, communicator, environment);
+
+        if (partner < folded_rank)
+          reduce_local(temporary.data(), buffer.data(), count, buffer, operation, environment);
+        else
+        {
+          reduce_local(buffer.data(), temporary.data(), count, buffer, operation, environment);
+          std::copy(temporary.begin(), temporary.end(), buffer.data());
+        }
+      }
+    }
+
+    // Among the folded processes. Block index of offsets ends up at folded rank index, reduced over all processes
+    template <typename Value>
+    inline void recursive_halving_reduce_scatter(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets, int const folded_rank,
+      ::yampi::binary_operation const& operation,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      auto const folded_size = largest_power_of_two(size);
+      assert(static_cast<int>(offsets.size()) == folded_size + 1);
+      ::yampi::scratch_buffer<Value> temporary(offsets[folded_size] - offsets[0]);
+
+      auto first_block = 0;
+      for (auto mask = folded_size / 2; mask > 0; mask /= 2)
+      {
+        auto const partner = folded_rank ^ mask;
+        auto const partner_rank = unfolded_rank_of(partner, size);
+        auto const keeps_lower = (folded_rank & mask) == 0;
+        auto const keep_first = keeps_lower ? first_block : first_block + mask;
+        auto const send_first = keeps_lower ? first_block + mask : first_block;
+        auto const keep_count = offsets[keep_first + mask] - offsets[keep_first];
+
+        exchange(
+          sub_buffer(buffer, offsets[send_first], offsets[send_first + mask]), partner_rank,
+          make_buffer_like(buffer, temporary.data(), temporary.data() + keep_count), partner_rank,
+          communicator, environment);
+        reduce_local(
+          temporary.data(), buffer.data() + offsets[keep_first], keep_count, buffer, operation, environment);
+        first_block = keep_first;
+      }
+    }
+
+    // Among the folded processes. Block index of offsets is that of folded rank index
+    template <typename Value>
+    inline void recursive_doubling_all_gather(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets, int const folded_rank,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      auto const folded_size = largest_power_of_two(size);
+      assert(static_cast<int>(offsets.size()) == folded_size + 1);
+
+      for (auto mask = 1; mask < folded_size; mask *= 2)
+      {
+        auto const partner = folded_rank ^ mask;
+        auto const partner_rank = unfolded_rank_of(partner, size);
+        auto const first_block = folded_rank & ~(mask - 1);
+        auto const partner_first_block = partner & ~(mask - 1);
+        exchange(
+          sub_buffer(buffer, offsets[first_block], offsets[first_block + mask]), partner_rank,
+          sub_buffer(buffer, offsets[partner_first_block], offsets[partner_first_block + mask]), partner_rank,
+          communicator, environment);
+      }
+    }
+
+    template <typename Value>
+    inline void binomial_broadcast(
+      ::yampi::buffer<Value> buffer, ::yampi::rank const root,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      auto const relative_rank = relative_rank_of(communicator.rank(environment), root, size);
+
+      auto mask = 1;
+      for (; mask < size; mask *= 2)
+        if ((relative_rank & mask) != 0)
+        {
+          ::yampi::receive(
+            ::yampi::ignore_status, buffer, rank_of(relative_rank - mask, root, size), tag, communicator, environment);
+          break;
+        }
+
+      std::vector< ::yampi::immediate_request > requests;
+      requests.reserve(32u);
+      for (mask /= 2; mask > 0; mask /= 2)
+        if (relative_rank + mask < size)
+        {
+          requests.emplace_back();
+          ::yampi::send(
+            requests.back(), buffer, rank_of(relative_rank + mask, root, size), tag, communicator, environment);
+        }
+      if (not requests.empty())
+        ::yampi::wait_all(::yampi::ignore_status, requests.begin(), requests.end(), environment);
+    }
+
+    // Reduces elements to rank 0 in the order of ranks
+    template <typename Value>
+    inline void binomial_reduce(
+      ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      auto const count = count_of(buffer, environment);
+      ::yampi::scratch_buffer<Value> temporary(count);
+      auto const temporary_buffer = make_buffer_like(buffer, temporary.begin(), temporary.end());
+
+      for (auto mask = 1; mask < size; mask *= 2)
+      {
+        if ((rank & mask) != 0)
+        {
+          ::yampi::send(buffer, ::yampi::rank{rank - mask}, tag, communicator, environment);
+          return;
+        }
+
+        if (rank + mask < size)
+        {
+          ::yampi::receive(
+            ::yampi::ignore_status, temporary_buffer, ::yampi::rank{rank + mask}, tag, communicator, environment);
+          reduce_local(buffer.data(), temporary.data(), count, buffer, operation, environment);
+          std::copy(temporary.begin(), temporary.end(), buffer.data());
+        }
+      }
+    }
+
+    // Block index of offsets goes to relative rank index to root
+    template <typename Value>
+    inline void binomial_scatter(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets, ::yampi::rank const root,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      assert(static_cast<int>(offsets.size()) == size + 1);
+      auto const relative_rank = relative_rank_of(communicator.rank(environment), root, size);
+
+      auto mask = 1;
+      for (; mask < size; mask *= 2)
+        if ((relative_rank & mask) != 0)
+        {
+          ::yampi::receive(
+            ::yampi::ignore_status,
+            sub_buffer(buffer, offsets[relative_rank], offsets[std::min(relative_rank + mask, size)]),
+            rank_of(relative_rank - mask, root, size), tag, communicator, environment);
+          break;
+        }
+
+      for (mask /= 2; mask > 0; mask /= 2)
+        if (relative_rank + mask < size)
+          ::yampi::send(
+            sub_buffer(buffer, offsets[relative_rank + mask], offsets[std::min(relative_rank + 2 * mask, size)]),
+            rank_of(relative_rank + mask, root, size), tag, communicator, environment);
+    }
+
+    // Block index of offsets comes from rank index to rank 0
+    template <typename Value>
+    inline void binomial_gather(
+      ::yampi::buffer<Value> buffer, std::vector<int> const& offsets,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      assert(static_cast<int>(offsets.size()) == size + 1);
+
+      for (auto mask = 1; mask < size; mask *= 2)
+      {
+        if ((rank & mask) != 0)
+        {
+          ::yampi::send(
+            sub_buffer(buffer, offsets[rank], offsets[std::min(rank + mask, size)]),
+            ::yampi::rank{rank - mask}, tag, communicator, environment);
+          return;
+        }
+
+        if (rank + mask < size)
+          ::yampi::receive(
+            ::yampi::ignore_status,
+            sub_buffer(buffer, offsets[rank + mask], offsets[std::min(rank + 2 * mask, size)]),
+            ::yampi::rank{rank + mask}, tag, communicator, environment);
+      }
+    }
+
+    template <typename Value>
+    inline void chain_broadcast(
+      ::yampi::buffer<Value> buffer, ::yampi::rank const root,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const size = communicator.size(environment);
+      auto const relative_rank = relative_rank_of(communicator.rank(environment), root, size);
+      if (relative_rank > 0)
+        ::yampi::receive(
+          ::yampi::ignore_status, buffer, rank_of(relative_rank - 1, root, size), tag, communicator, environment);
+      if (relative_rank + 1 < size)
+        ::yampi::send(buffer, rank_of(relative_rank + 1, root, size), tag, communicator, environment);
+    }
+
+    template <typename Value>
+    inline void pipelined_broadcast(
+      ::yampi::buffer<Value> buffer, ::yampi::rank const root, ::yampi::pipeline const pipeline,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      // the numbers of segments each process receives or sends ahead
+      constexpr int window = 4;
+
+      assert(pipeline.segment_size > 0);
+      auto const size = communicator.size(environment);
+      auto const count = count_of(buffer, environment);
+      if (size == 1 or count == 0)
+        return;
+
+      auto const relative_rank = relative_rank_of(communicator.rank(environment), root, size);
+      auto const is_chain = pipeline.shape == ::yampi::pipeline_shape::chain;
+      auto const parent = relative_rank == 0 ? -1 : is_chain ? relative_rank - 1 : (relative_rank - 1) / 2;
+      std::vector< ::yampi::rank > children;
+      for (auto child = is_chain ? relative_rank + 1 : 2 * relative_rank + 1;
+           child < size and child <= (is_chain ? relative_rank + 1 : 2 * relative_rank + 2); ++child)
+        children.push_back(rank_of(child, root, size));
+      auto const num_children = static_cast<int>(children.size());
+
+      auto const num_segments = (count + pipeline.segment_size - 1) / pipeline.segment_size;
+      auto const segment
+        = [&buffer, count, pipeline](int const index)
+          {
+            return sub_buffer(
+              buffer, index * pipeline.segment_size, std::min((index + 1) * pipeline.segment_size, count));
+          };
+
+      // request of segment index is at index % window (times num_children plus child)
+      std::vector< ::yampi::immediate_request > receive_requests(window);
+      std::vector< ::yampi::immediate_request > send_requests(window * num_children);
+      if (parent >= 0)
+        for (auto index = 0; index < std::min(window, num_segments); ++index)
+          ::yampi::receive(
+            receive_requests[index], segment(index), rank_of(parent, root, size), tag, communicator, environment);
+
+      for (auto index = 0; index < num_segments; ++index)
+      {
+        auto const slot = index % window;
+        if (parent >= 0)
+        {
+          receive_requests[slot].wait(::yampi::ignore_status, environment);
+          if (index + window < num_segments)
+            ::yampi::receive(
+              receive_requests[slot], segment(index + window), rank_of(parent, root, size), tag,
+              communicator, environment);
+        }
+
+        for (auto child = 0; child < num_children; ++child)
+        {
+          auto& request = send_requests[slot * num_children + child];
+          request.wait(::yampi::ignore_status, environment);
+          ::yampi::send(request, segment(index), children[child], tag, communicator, environment);
+        }
+      }
+
+      if (not send_requests.empty())
+        ::yampi::wait_all(::yampi::ignore_status, send_requests.begin(), send_requests.end(), environment);
+    }
+
+    // Block index (of count elements) ends up at that of rank index
+    template <typename Value>
+    inline void bruck_all_gather(
+      ::yampi::buffer<Value> buffer, int const count,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const rank = communicator.rank(environment).mpi_rank();
+      auto const size = communicator.size(environment);
+      // block index of temporary is that of rank (rank + index) % size
+      ::yampi::scratch_buffer<Value> temporary(size * count);
+      std::copy(buffer.data() + rank * count, buffer.data() + (rank + 1) * count, temporary.begin());
+
+      for (auto distance = 1; distance < size; distance *= 2)
+      {
+        auto const num_blocks = std::min(distance, size - distance);
+        exchange(
+          make_buffer_like(buffer, temporary.data(), temporary.data() + num_blocks * count),
+          ::yampi::rank{(rank + size - distance) % size},
+          make_buffer_like(buffer, temporary.data() + distance * count, temporary.data() + (distance + num_blocks) * count),
+          ::yampi::rank{(rank + distance) % size},
+          communicator, environment);
+      }
+
+      for (auto index = 0; index < size; ++index)
+        std::copy(
+          temporary.data() + index * count, temporary.data() + (index + 1) * count,
+          buffer.data() + (rank + index) % size * count);
+    }
+  } // namespace collective_algorithm_detail
+}
+
+
+#endif
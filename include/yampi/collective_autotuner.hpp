@@ -0,0 +1,328 @@
+#ifndef YAMPI_COLLECTIVE_AUTOTUNER_HPP
+# define YAMPI_COLLECTIVE_AUTOTUNER_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <string>
+# include <map>
+# include <tuple>
+# include <istream>
+# include <ostream>
+# include <sstream>
+# include <stdexcept>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/collective_algorithm.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/wall_clock.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+
+
+// Autotuner of collective algorithms.
+//
+// Passing ::yampi::collective_algorithm::autotuned to all_reduce, broadcast, all_gather or reduce_scatter selects the
+// algorithm from the table of the ::yampi::collective_autotuner attached to the communicator (attached on the first
+// use, and deleted with the communicator). The table is keyed by the collective, the datatype, the operation and
+// whether it is commutative, the size class of the message (the bit width of the number of bytes) and the size of the
+// communicator. On a miss, every candidate algorithm runs num_trials() times on the data of the call, and the one with
+// the smallest time of the slowest process wins; all processes agree on the winner because they compare the same
+// maxima. Algorithms reducing elements in different orders on different processes (ring and rabenseifner, and
+// recursive_doubling for reduce_scatter) are no candidates for noncommutative operations.
+//
+// Tables can be saved to and restored from streams, so that later runs start tuned
+//
+//   auto& autotuner = ::yampi::collective_autotuner::of(communicator, environment);
+//   std::ifstream in{"yampi_tuning.csv"};
+//   if (in)
+//     autotuner.read(in); // on all processes, so that their tables agree
+//   ...
+//   if (communicator.rank(environment) == ::yampi::rank{0})
+//   {
+//     std::ofstream out{"yampi_tuning.csv"};
+//     autotuner.write(out);
+//   }
+//
+// Datatypes are keyed by their names (MPI_Type_get_name), and unnamed datatypes and user-defined operations by their
+// handles ("unnamed#<handle>" and "user#<handle>", of MPI_Type_c2f and MPI_Op_c2f). Handles are only valid in the run,
+// so entries keyed by handles are not written, and processes must create their unnamed datatypes and operations in
+// the same order to get the same keys. Name derived datatypes to keep their entries across runs.
+namespace yampi
+{
+  struct collective_autotuner_key
+  {
+    std::string collective;
+    std::string datatype;
+    std::string operation;
+    bool is_commutative;
+    int size_class;
+    int communicator_size;
+
+    bool operator<(collective_autotuner_key const& other) const
+    {
+      return std::tie(collective, datatype, operation, is_commutative, size_class, communicator_size)
+        < std::tie(
+            other.collective, other.datatype, other.operation, other.is_commutative, other.size_class,
+            other.communicator_size);
+    }
+  };
+
+  namespace collective_autotuner_detail
+  {
+    inline char const* name_of(::yampi::collective_algorithm const algorithm) noexcept
+    {
+      switch (algorithm)
+      {
+       case ::yampi::collective_algorithm::library: return "library";
+       case ::yampi::collective_algorithm::ring: return "ring";
+       case ::yampi::collective_algorithm::recursive_doubling: return "recursive_doubling";
+       case ::yampi::collective_algorithm::binomial_tree: return "binomial_tree";
+       case ::yampi::collective_algorithm::rabenseifner: return "rabenseifner";
+       case ::yampi::collective_algorithm::autotuned: return "autotuned";
+      }
+      return "";
+    }
+
+    inline std::string name_of(MPI_Op const mpi_op)
+    {
+      if (mpi_op == MPI_OP_NULL) return "none";
+      if (mpi_op == MPI_MAX) return "max";
+      if (mpi_op == MPI_MIN) return "min";
+      if (mpi_op == MPI_SUM) return "sum";
+      if (mpi_op == MPI_PROD) return "prod";
+      if (mpi_op == MPI_LAND) return "land";
+      if (mpi_op == MPI_BAND) return "band";
+      if (mpi_op == MPI_LOR) return "lor";
+      if (mpi_op == MPI_BOR) return "bor";
+      if (mpi_op == MPI_LXOR) return "lxor";
+      if (mpi_op == MPI_BXOR) return "bxor";
+      if (mpi_op == MPI_MAXLOC) return "maxloc";
+      if (mpi_op == MPI_MINLOC) return "minloc";
+      return std::string("user#") + std::to_string(MPI_Op_c2f(mpi_op));
+    }
+
+    inline std::string name_of(MPI_Datatype const mpi_datatype, ::yampi::environment const& environment)
+    {
+      char name[MPI_MAX_OBJECT_NAME];
+      int length;
+      auto const error_code = MPI_Type_get_name(mpi_datatype, name, std::addressof(length));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_autotuner_detail::name_of", environment};
+      return length > 0
+        ? std::string(name, length)
+        : std::string("unnamed#") + std::to_string(MPI_Type_c2f(mpi_datatype));
+    }
+
+    inline bool is_keyed_by_handle(::yampi::collective_autotuner_key const& key)
+    { return key.datatype.find('#') != std::string::npos or key.operation.find('#') != std::string::npos; }
+
+    // Whether algorithm gives the results of the collective of key
+    inline bool is_candidate(
+      ::yampi::collective_autotuner_key const& key, ::yampi::collective_algorithm const algorithm) noexcept
+    {
+      return key.is_commutative
+        or ::yampi::collective_algorithm_detail::is_order_preserving(algorithm, key.collective == "reduce_scatter");
+    }
+
+    inline int size_class_of(std::size_t num_bytes) noexcept
+    {
+      auto result = 0;
+      for (; num_bytes > 0u; num_bytes >>= 1u)
+        ++result;
+      return result;
+    }
+  } // namespace collective_autotuner_detail
+
+  class collective_autotuner
+  {
+    std::map< ::yampi::collective_autotuner_key, ::yampi::collective_algorithm > table_;
+    int num_trials_;
+
+   public:
+    static constexpr int default_num_trials = 5;
+
+    collective_autotuner() : table_{}, num_trials_{default_num_trials} { }
+
+    collective_autotuner(collective_autotuner const&) = delete;
+    collective_autotuner& operator=(collective_autotuner const&) = delete;
+    collective_autotuner(collective_autotuner&&) = delete;
+    collective_autotuner& operator=(collective_autotuner&&) = delete;
+
+    // Returns the autotuner attached to communicator, attaching a new one first if there is none
+    static collective_autotuner& of(
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      void* attribute;
+      int flag;
+      auto error_code
+        = MPI_Comm_get_attr(communicator.mpi_comm(), keyval(), std::addressof(attribute), std::addressof(flag));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_autotuner::of", environment};
+      if (static_cast<bool>(flag))
+        return *static_cast<collective_autotuner*>(attribute);
+
+      std::unique_ptr<collective_autotuner> autotuner_ptr{new collective_autotuner{}};
+      error_code = MPI_Comm_set_attr(communicator.mpi_comm(), keyval(), autotuner_ptr.get());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::collective_autotuner::of", environment};
+      return *autotuner_ptr.release();
+    }
+
+    static ::yampi::collective_autotuner_key make_key(
+      char const* collective, MPI_Datatype const mpi_datatype, MPI_Op const mpi_op, std::size_t const num_bytes,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      return ::yampi::collective_autotuner_key{
+        collective,
+        ::yampi::collective_autotuner_detail::name_of(mpi_datatype, environment),
+        ::yampi::collective_autotuner_detail::name_of(mpi_op),
+        ::yampi::collective_algorithm_detail::is_commutative(mpi_op, environment),
+        ::yampi::collective_autotuner_detail::size_class_of(num_bytes),
+        communicator.size(environment)};
+    }
+
+    int num_trials() const noexcept { return num_trials_; }
+    void num_trials(int const num_trials) noexcept { num_trials_ = num_trials; }
+
+    std::map< ::yampi::collective_autotuner_key, ::yampi::collective_algorithm > const& table() const noexcept
+    { return table_; }
+
+    void insert(::yampi::collective_autotuner_key const& key, ::yampi::collective_algorithm const algorithm)
+    {
+      assert(::yampi::collective_autotuner_detail::is_candidate(key, algorithm));
+      table_[key] = algorithm;
+    }
+
+    void clear() noexcept { table_.clear(); }
+
+    // Collective over communicator. run(algorithm) must run the collective by algorithm without changing the results
+    // of the call
+    template <typename Run>
+    ::yampi::collective_algorithm select(
+      ::yampi::collective_autotuner_key const& key, Run run,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const found = table_.find(key);
+      if (found != table_.end())
+        return found->second;
+
+      ::yampi::collective_algorithm const candidates[]
+        = {::yampi::collective_algorithm::library, ::yampi::collective_algorithm::ring,
+           ::yampi::collective_algorithm::recursive_doubling, ::yampi::collective_algorithm::binomial_tree,
+           ::yampi::collective_algorithm::rabenseifner};
+      auto result = ::yampi::collective_algorithm::library;
+      auto min_time = 0.0;
+      auto is_first = true;
+      for (auto const candidate: candidates)
+      {
+        if (not ::yampi::collective_autotuner_detail::is_candidate(key, candidate))
+          continue;
+
+        run(candidate); // warm-up
+
+        auto error_code = MPI_Barrier(communicator.mpi_comm());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::collective_autotuner::select", environment};
+        auto const start_time = ::yampi::wall_clock::now(environment);
+        for (auto trial = 0; trial < num_trials_; ++trial)
+          run(candidate);
+        auto const time = (::yampi::wall_clock::now(environment) - start_time).count();
+
+        auto max_time = 0.0;
+        error_code
+          = MPI_Allreduce(
+              std::addressof(time), std::addressof(max_time), 1, MPI_DOUBLE, MPI_MAX, communicator.mpi_comm());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::collective_autotuner::select", environment};
+
+        if (is_first or max_time < min_time)
+        {
+          result = candidate;
+          min_time = max_time;
+          is_first = false;
+        }
+      }
+
+      table_.emplace(key, result);
+      return result;
+    }
+
+    // Writes "collective,datatype,operation,is_commutative,size_class,communicator_size,algorithm" lines, except for
+    // the entries keyed by handles
+    void write(std::ostream& out) const
+    {
+      out << "collective,datatype,operation,is_commutative,size_class,communicator_size,algorithm\n";
+      for (auto const& entry: table_)
+        if (not ::yampi::collective_autotuner_detail::is_keyed_by_handle(entry.first))
+          out << entry.first.collective << ',' << entry.first.datatype << ',' << entry.first.operation << ','
+              << (entry.first.is_commutative ? 1 : 0) << ',' << entry.first.size_class << ',' << entry.first.communicator_size << ','
+              << ::yampi::collective_autotuner_detail::name_of(entry.second) << '\n';
+      out << std::flush;
+    }
+
+    // Adds the entries written by write, overwriting entries of the same keys
+    void read(std::istream& in)
+    {
+      std::string line;
+      std::getline(in, line); // header
+      while (std::getline(in, line))
+      {
+        if (line.empty())
+          continue;
+
+        std::istringstream line_stream{line};
+        ::yampi::collective_autotuner_key key;
+        std::string is_commutative, size_class, communicator_size, algorithm_name;
+        if (not (std::getline(line_stream, key.collective, ',') and std::getline(line_stream, key.datatype, ',')
+                 and std::getline(line_stream, key.operation, ',') and std::getline(line_stream, is_commutative, ',')
+                 and std::getline(line_stream, size_class, ',') and std::getline(line_stream, communicator_size, ',')
+                 and std::getline(line_stream, algorithm_name)))
+          throw std::runtime_error("yampi::collective_autotuner::read");
+        key.is_commutative = std::stoi(is_commutative) != 0;
+        key.size_class = std::stoi(size_class);
+        key.communicator_size = std::stoi(communicator_size);
+        auto const algorithm = algorithm_of(algorithm_name);
+        if (not ::yampi::collective_autotuner_detail::is_candidate(key, algorithm))
+          throw std::runtime_error("yampi::collective_autotuner::read");
+        table_[key] = algorithm;
+      }
+    }
+
+   private:
+    static ::yampi::collective_algorithm algorithm_of(std::string const& name)
+    {
+      ::yampi::collective_algorithm const algorithms[]
+        = {::yampi::collective_algorithm::library, ::yampi::collective_algorithm::ring,
+           ::yampi::collective_algorithm::recursive_doubling, ::yampi::collective_algorithm::binomial_tree,
+           ::yampi::collective_algorithm::rabenseifner};
+      for (auto const algorithm: algorithms)
+        if (name == ::yampi::collective_autotuner_detail::name_of(algorithm))
+          return algorithm;
+      throw std::runtime_error("yampi::collective_autotuner::read");
+    }
+
+    static int keyval() noexcept
+    {
+      static int const result
+        = []()
+          {
+            int keyval = MPI_KEYVAL_INVALID;
+            MPI_Comm_create_keyval(
+              MPI_COMM_NULL_COPY_FN, &collective_autotuner::delete_attribute, std::addressof(keyval), nullptr);
+            return keyval;
+          }();
+      return result;
+    }
+
+    static int delete_attribute(MPI_Comm, int, void* attribute, void*)
+    {
+      delete static_cast<collective_autotuner*>(attribute);
+      return MPI_SUCCESS;
+    }
+  };
+}
+
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef YAMPI_COMMUNICATION_MATRIX_HPP
+# define YAMPI_COMMUNICATION_MATRIX_HPP
+
+# include <cstddef>
+# include <vector>
+# include <ostream>
+# include <memory>
+# include <atomic>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/window_base.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/error.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Communication-matrix recorder.
+//
+// Compile with YAMPI_COMMUNICATION_MATRIX defined to make send, send_receive, put, get and accumulate
+// report their traffic to the yampi::communication_matrix attached to the communicator (or window) they use.
+// Without YAMPI_COMMUNICATION_MATRIX, the YAMPI_RECORD_* macros expand to nothing.
+//
+// Traffic is recorded at the side which knows both peers: sends and puts/accumulates at the origin,
+// gets at the origin as traffic from the target to the origin. Persistent and partitioned sends are not recorded,
+// neither at their creation nor at their starts. Only intracommunicators can have communication matrices. Recording
+// is thread-safe.
+namespace yampi
+{
+  namespace communication_matrix_detail
+  {
+    using counters = std::vector<std::atomic<unsigned long long>>;
+
+    inline std::vector<unsigned long long> load(::yampi::communication_matrix_detail::counters const& values)
+    {
+      std::vector<unsigned long long> result;
+      result.reserve(values.size());
+      for (auto const& value: values)
+        result.push_back(value.load(std::memory_order_relaxed));
+      return result;
+    }
+
+    // Counters are atomic, so that threads may record concurrently
+    struct state
+    {
+      MPI_Comm mpi_comm;
+      int size;
+      // indexed by destination
+      ::yampi::communication_matrix_detail::counters num_sent_bytes;
+      ::yampi::communication_matrix_detail::counters num_sent_messages;
+      // indexed by source, for data read by get
+      ::yampi::communication_matrix_detail::counters num_gotten_bytes;
+      ::yampi::communication_matrix_detail::counters num_gotten_messages;
+      std::atomic<bool> is_recording;
+
+      std::ostream* finalize_output_ptr;
+      ::yampi::rank finalize_root;
+      ::yampi::environment const* environment_ptr;
+
+      state(MPI_Comm const comm, int const num_processes, ::yampi::environment const& environment)
+        : mpi_comm{comm}, size{num_processes},
+          num_sent_bytes(static_cast<std::size_t>(num_processes)),
+          num_sent_messages(static_cast<std::size_t>(num_processes)),
+          num_gotten_bytes(static_cast<std::size_t>(num_processes)),
+          num_gotten_messages(static_cast<std::size_t>(num_processes)),
+          is_recording{true}, finalize_output_ptr{nullptr}, finalize_root{0},
+          environment_ptr{std::addressof(environment)}
+      { }
+
+      void record(int const destination, std::size_t const num_bytes) noexcept
+      {
+        if (not is_recording.load(std::memory_order_relaxed) or destination < 0 or destination >= size)
+          return;
+
+        num_sent_bytes[destination].fetch_add(num_bytes, std::memory_order_relaxed);
+        num_sent_messages[destination].fetch_add(1ull, std::memory_order_relaxed);
+      }
+
+      void record_get(int const source, std::size_t const num_bytes) noexcept
+      {
+        if (not is_recording.load(std::memory_order_relaxed) or source < 0 or source >= size)
+          return;
+
+        num_gotten_bytes[source].fetch_add(num_bytes, std::memory_order_relaxed);
+        num_gotten_messages[source].fetch_add(1ull, std::memory_order_relaxed);
+      }
+
+      void clear() noexcept
+      {
+        for (auto* values: {&num_sent_bytes, &num_sent_messages, &num_gotten_bytes, &num_gotten_messages})
+          for (auto& value: *values)
+            value.store(0ull, std::memory_order_relaxed);
+      }
+    };
+  } // namespace communication_matrix_detail
+
+  class communication_matrix
+  {
+    using state_type = ::yampi::communication_matrix_detail::state;
+    // shared with the attributes of the communicator, attached windows and MPI_COMM_SELF
+    std::shared_ptr<state_type> state_ptr_;
+
+   public:
+    communication_matrix(
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+      : state_ptr_{
+          std::make_shared<state_type>(communicator.mpi_comm(), communicator.size(environment), environment)}
+    {
+      int is_intercommunicator;
+      auto error_code = MPI_Comm_test_inter(state_ptr_->mpi_comm, std::addressof(is_intercommunicator));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::communication_matrix::communication_matrix", environment};
+      // ranks of destinations would be in the remote group
+      if (static_cast<bool>(is_intercommunicator))
+        throw ::yampi::error{MPI_ERR_COMM, "yampi::communication_matrix::communication_matrix", environment};
+
+      // a communicator has at most one communication_matrix: the previous one is detached
+      std::unique_ptr<std::shared_ptr<state_type>> attribute_ptr{new std::shared_ptr<state_type>{state_ptr_}};
+      error_code = MPI_Comm_set_attr(state_ptr_->mpi_comm, communicator_keyval(), attribute_ptr.get());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::communication_matrix::communication_matrix", environment};
+      attribute_ptr.release();
+    }
+
+    // Recording stops here, but the output requested by write_at_finalize is still written
+    ~communication_matrix() noexcept { state_ptr_->is_recording = false; }
+
+    communication_matrix(communication_matrix const&) = delete;
+    communication_matrix& operator=(communication_matrix const&) = delete;
+    communication_matrix(communication_matrix&&) = delete;
+    communication_matrix& operator=(communication_matrix&&) = delete;
+
+    // window should be created from the attached communicator, so that target ranks are the same
+    template <typename Window>
+    void attach(::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
+    {
+      std::unique_ptr<std::shared_ptr<state_type>> attribute_ptr{new std::shared_ptr<state_type>{state_ptr_}};
+      auto const error_code = MPI_Win_set_attr(window.mpi_win(), window_keyval(), attribute_ptr.get());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::communication_matrix::attach", environment};
+      attribute_ptr.release();
+    }
+
+    void record(::yampi::rank const destination, std::size_t const num_bytes) noexcept
+    { state_ptr_->record(destination.mpi_rank(), num_bytes); }
+
+    void clear() noexcept { state_ptr_->clear(); }
+
+    int size() const noexcept { return state_ptr_->size; }
+
+    // Collective. Returns size()*size() elements indexed by [source * size() + destination] on root,
+    // and an empty vector on the other processes
+    std::vector<unsigned long long> gather_bytes(
+      ::yampi::rank const root, ::yampi::environment const& environment) const
+    { return do_gather(*state_ptr_, state_ptr_->num_sent_bytes, state_ptr_->num_gotten_bytes, root, environment); }
+
+    std::vector<unsigned long long> gather_messages(
+      ::yampi::rank const root, ::yampi::environment const& environment) const
+    { return do_gather(*state_ptr_, state_ptr_->num_sent_messages, state_ptr_->num_gotten_messages, root, environment); }
+
+    // Collective. root writes "source,destination,bytes,messages" for each nonzero pair
+    void write(std::ostream& out, ::yampi::rank const root, ::yampi::environment const& environment) const
+    { do_write(*state_ptr_, out, root, environment); }
+
+    // Collective. write(out, root, environment) is called when environment finalizes MPI, even if *this is destroyed.
+    // out must be alive until then
+    void write_at_finalize(std::ostream& out, ::yampi::rank const root, ::yampi::environment const& environment)
+    {
+      auto const is_registered = state_ptr_->finalize_output_ptr != nullptr;
+      state_ptr_->finalize_output_ptr = std::addressof(out);
+      state_ptr_->finalize_root = root;
+      state_ptr_->environment_ptr = std::addressof(environment);
+      if (is_registered)
+        return;
+
+      // each matrix has a hook of its own, which keeps the state alive
+      auto const state_ptr = state_ptr_;
+      auto const error_code
+        = ::yampi::detail::at_finalize(
+            [state_ptr]()
+            {
+              if (state_ptr->mpi_comm != MPI_COMM_NULL)
+                do_write(
+                  *state_ptr, *state_ptr->finalize_output_ptr, state_ptr->finalize_root,
+                  *state_ptr->environment_ptr);
+            });
+      if (error_code != MPI_SUCCESS)
+      {
+        state_ptr_->finalize_output_ptr = nullptr;
+        throw ::yampi::error{error_code, "yampi::communication_matrix::write_at_finalize", environment};
+      }
+    }
+
+    static state_type* find_by_communicator(MPI_Comm const mpi_comm) noexcept
+    {
+      void* attribute;
+      int flag;
+      auto const error_code
+        = MPI_Comm_get_attr(mpi_comm, communicator_keyval(), std::addressof(attribute), std::addressof(flag));
+      return error_code == MPI_SUCCESS and static_cast<bool>(flag)
+        ? static_cast<std::shared_ptr<state_type>*>(attribute)->get()
+        : nullptr;
+    }
+
+    static state_type* find_by_window(MPI_Win const mpi_win) noexcept
+    {
+      void* attribute;
+      int flag;
+      auto const error_code
+        = MPI_Win_get_attr(mpi_win, window_keyval(), std::addressof(attribute), std::addressof(flag));
+      return error_code == MPI_SUCCESS and static_cast<bool>(flag)
+        ? static_cast<std::shared_ptr<state_type>*>(attribute)->get()
+        : nullptr;
+    }
+
+   private:
+    static std::vector<unsigned long long> do_gather(
+      state_type const& state,
+      ::yampi::communication_matrix_detail::counters const& sent_counters,
+      ::yampi::communication_matrix_detail::counters const& gotten_counters,
+      ::yampi::rank const root, ::yampi::environment const& environment)
+    {
+      if (state.mpi_comm == MPI_COMM_NULL)
+        throw ::yampi::error{MPI_ERR_COMM, "yampi::communication_matrix::do_gather", environment};
+
+      int present_rank;
+      MPI_Comm_rank(state.mpi_comm, std::addressof(present_rank));
+      auto const is_root = present_rank == root.mpi_rank();
+
+      auto const size = static_cast<std::size_t>(state.size);
+      std::vector<unsigned long long> sent_matrix(is_root ? size * size : 0u);
+      std::vector<unsigned long long> gotten_matrix(is_root ? size * size : 0u);
+      auto const sent = ::yampi::communication_matrix_detail::load(sent_counters);
+      auto const gotten = ::yampi::communication_matrix_detail::load(gotten_counters);
+
+      auto error_code
+        = MPI_Gather(
+            sent.data(), state.size, MPI_UNSIGNED_LONG_LONG,
+            sent_matrix.data(), state.size, MPI_UNSIGNED_LONG_LONG, root.mpi_rank(), state.mpi_comm);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::communication_matrix::do_gather", environment};
+      error_code
+        = MPI_Gather(
+            gotten.data(), state.size, MPI_UNSIGNED_LONG_LONG,
+            gotten_matrix.data(), state.size, MPI_UNSIGNED_LONG_LONG, root.mpi_rank(), state.mpi_comm);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::communication_matrix::do_gather", environment};
+
+      // gotten_matrix[destination * size + source] is the traffic from source to destination
+      if (is_root)
+        for (std::size_t source = 0u; source < size; ++source)
+          for (std::size_t destination = 0u; destination < size; ++destination)
+            sent_matrix[source * size + destination] += gotten_matrix[destination * size + source];
+
+      return sent_matrix;
+    }
+
+    static void do_write(
+      state_type const& state, std::ostream& out, ::yampi::rank const root, ::yampi::environment const& environment)
+    {
+      auto const bytes = do_gather(state, state.num_sent_bytes, state.num_gotten_bytes, root, environment);
+      auto const messages = do_gather(state, state.num_sent_messages, state.num_gotten_messages, root, environment);
+      if (bytes.empty())
+        return;
+
+      auto const size = static_cast<std::size_t>(state.size);
+      out << "source,destination,bytes,messages\n";
+      for (std::size_t source = 0u; source < size; ++source)
+        for (std::size_t destination = 0u; destination < size; ++destination)
+        {
+          auto const index = source * size + destination;
+          if (messages[index] != 0ull)
+            out << source << ',' << destination << ',' << bytes[index] << ',' << messages[index] << '\n';
+        }
+      out << std::flush;
+    }
+
+    static int communicator_keyval() noexcept
+    {
+      static int const result
+        = []()
+          {
+            int keyval = MPI_KEYVAL_INVALID;
+            MPI_Comm_create_keyval(
+              MPI_COMM_NULL_COPY_FN, &communication_matrix::delete_communicator_attribute,
+              std::addressof(keyval), nullptr);
+            return keyval;
+          }();
+      return result;
+    }
+
+    static int window_keyval() noexcept
+    {
+      static int const result
+        = []()
+          {
+            int keyval = MPI_KEYVAL_INVALID;
+            MPI_Win_create_keyval(
+              MPI_WIN_NULL_COPY_FN, &communication_matrix::delete_window_attribute,
+              std::addressof(keyval), nullptr);
+            return keyval;
+          }();
+      return result;
+    }
+
+    static int delete_communicator_attribute(MPI_Comm, int, void* attribute, void*)
+    {
+      std::unique_ptr<std::shared_ptr<state_type>> attribute_ptr{static_cast<std::shared_ptr<state_type>*>(attribute)};
+      (*attribute_ptr)->mpi_comm = MPI_COMM_NULL;
+      (*attribute_ptr)->is_recording = false;
+      return MPI_SUCCESS;
+    }
+
+    static int delete_window_attribute(MPI_Win, int, void* attribute, void*)
+    {
+      std::unique_ptr<std::shared_ptr<state_type>> attribute_ptr{static_cast<std::shared_ptr<state_type>*>(attribute)};
+      return MPI_SUCCESS;
+    }
+  }; // class communication_matrix
+
+  namespace communication_matrix_detail
+  {
+    inline void record_send(MPI_Comm const mpi_comm, int const destination, std::size_t const num_bytes) noexcept
+    {
+      if (auto const state_ptr = ::yampi::communication_matrix::find_by_communicator(mpi_comm))
+        state_ptr->record(destination, num_bytes);
+    }
+
+    inline void record_put(MPI_Win const mpi_win, int const target, std::size_t const num_bytes) noexcept
+    {
+      if (auto const state_ptr = ::yampi::communication_matrix::find_by_window(mpi_win))
+        state_ptr->record(target, num_bytes);
+    }
+
+    inline void record_get(MPI_Win const mpi_win, int const target, std::size_t const num_bytes) noexcept
+    {
+      if (auto const state_ptr = ::yampi::communication_matrix::find_by_window(mpi_win))
+        state_ptr->record_get(target, num_bytes);
+    }
+  } // namespace communication_matrix_detail
+} // namespace yampi
+
+
+# ifdef YAMPI_COMMUNICATION_MATRIX
+#   define YAMPI_RECORD_SEND(communicator, destination, num_bytes) \
+  ::yampi::communication_matrix_detail::record_send(communicator.mpi_comm(), destination.mpi_rank(), num_bytes)
+#   define YAMPI_RECORD_PUT(window, target, num_bytes) \
+  ::yampi::communication_matrix_detail::record_put(window.mpi_win(), target.mpi_rank(), num_bytes)
+#   define YAMPI_RECORD_GET(window, target, num_bytes) \
+  ::yampi::communication_matrix_detail::record_get(window.mpi_win(), target.mpi_rank(), num_bytes)
+# else // YAMPI_COMMUNICATION_MATRIX
+#   define YAMPI_RECORD_SEND(communicator, destination, num_bytes)
+#   define YAMPI_RECORD_PUT(window, target, num_bytes)
+#   define YAMPI_RECORD_GET(window, target, num_bytes)
+# endif // YAMPI_COMMUNICATION_MATRIX
+
+
+#endif
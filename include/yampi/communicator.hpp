@@ -15,6 +15,7 @@
 # include <yampi/tag.hpp>
 # include <yampi/color.hpp>
 # include <yampi/split_type.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -77,6 +78,7 @@ namespace yampi
       communicator const& other, ::yampi::group const& group, ::yampi::tag const tag,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator::create", 0u);
       MPI_Comm result;
       int const error_code
         = MPI_Comm_create_group(
@@ -18,6 +18,7 @@
 # include <yampi/color.hpp>
 # include <yampi/split_type.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 
 # if __cplusplus >= 201703L
 #   define YAMPI_is_nothrow_swappable std::is_nothrow_swappable
@@ -135,6 +136,7 @@ namespace yampi
    private:
     MPI_Comm duplicate(communicator_base const& other, ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::duplicate", 0u);
       MPI_Comm result;
       auto const error_code = MPI_Comm_dup(other.mpi_comm(), std::addressof(result));
       return error_code == MPI_SUCCESS
@@ -147,6 +149,7 @@ namespace yampi
       communicator_base const& other, ::yampi::information const& information,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::duplicate", 0u);
       MPI_Comm result;
       auto const error_code
         = MPI_Comm_dup_with_info(other.mpi_comm(), information.mpi_info(), std::addressof(result));
@@ -160,6 +163,7 @@ namespace yampi
       ::yampi::immediate_request& request,
       communicator_base const& other, ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::duplicate", 0u);
       MPI_Comm mpi_comm;
       MPI_Request mpi_request;
       auto const error_code = MPI_Comm_idup(other.mpi_comm(), std::addressof(mpi_comm), std::addressof(mpi_request));
@@ -175,6 +179,7 @@ namespace yampi
       communicator_base const& other, ::yampi::information const& information,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::duplicate", 0u);
       MPI_Comm mpi_comm;
       MPI_Request mpi_request;
       auto const error_code
@@ -190,6 +195,7 @@ namespace yampi
       communicator_base const& other, ::yampi::group const& group,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::create", 0u);
       MPI_Comm result;
       auto const error_code = MPI_Comm_create(other.mpi_comm(), group.mpi_group(), std::addressof(result));
       return error_code == MPI_SUCCESS
@@ -201,6 +207,7 @@ namespace yampi
       communicator_base const& other, ::yampi::color const color, int const key,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::split", 0u);
       MPI_Comm result;
       auto const error_code = MPI_Comm_split(other.mpi_comm(), color.mpi_color(), key, std::addressof(result));
       return error_code == MPI_SUCCESS
@@ -214,6 +221,7 @@ namespace yampi
       int const key, ::yampi::information const& information,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::communicator_base::split", 0u);
       MPI_Comm result;
       auto const error_code
         = MPI_Comm_split_type(other.mpi_comm(), split_type.mpi_split_type(), key, information.mpi_info(), std::addressof(result));
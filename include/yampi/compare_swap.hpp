@@ -14,6 +14,7 @@
 # include <yampi/has_predefined_datatype.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -27,9 +28,10 @@ namespace yampi
     ::yampi::rank const target, ::yampi::displacement const target_displacement,
     ::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::compare_swap", 0u);
     int const error_code
       = MPI_Compare_and_swap(
-          std::addressof(origin_value), std::addressof(compare_value), std::addressof(result_value), ::yampi::predefined_datatype<Value>(),
+          std::addressof(origin_value), std::addressof(compare_value), std::addressof(result_value), ::yampi::predefined_datatype<Value>().mpi_datatype(),
           target.mpi_rank(), target_displacement.mpi_displacement(),
           window.mpi_win());
     if (error_code != MPI_SUCCESS)
@@ -19,6 +19,8 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -34,13 +36,15 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::complete_exchange", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -52,15 +56,15 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Alltoall(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -72,15 +76,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::complete_exchange", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -91,14 +97,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Alltoall(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -112,9 +118,11 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::complete_exchange", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -139,13 +147,15 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::complete_exchange", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.remote_size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.remote_size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.remote_size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -157,15 +167,15 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Alltoall(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -177,15 +187,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::complete_exchange", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -196,14 +208,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Alltoall(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -218,13 +230,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * topology.num_neighbors(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * topology.num_neighbors(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * topology.num_neighbors(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -236,8 +249,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -249,15 +262,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -268,7 +282,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm());
 # endif // MPI_VERSION >= 4
@@ -285,13 +299,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -304,8 +319,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ialltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -319,15 +334,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -339,7 +355,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ialltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -354,9 +370,10 @@ namespace yampi
     ::yampi::immediate_request& request, ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -384,13 +401,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.remote_size(environment) <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.remote_size(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.remote_size(environment) <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -403,8 +421,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ialltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -418,15 +436,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -438,7 +457,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ialltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -455,13 +474,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 #   if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * topology.num_neighbors(environment) <= send_buffer.data());
 #   else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * topology.num_neighbors(environment) <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * topology.num_neighbors(environment) <= send_buffer.data());
 #   endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -474,8 +494,8 @@ namespace yampi
 #   else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ineighbor_alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm(), std::addressof(mpi_request));
 #   endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -489,15 +509,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
 #   if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 #   else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
 #   endif // MPI_VERSION >= 4
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 #   if MPI_VERSION >= 4
@@ -509,7 +530,7 @@ namespace yampi
 #   else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ineighbor_alltoall(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm(), std::addressof(mpi_request));
 #   endif // MPI_VERSION >= 4
@@ -529,6 +550,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -552,11 +574,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -576,9 +599,10 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -599,6 +623,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -622,11 +647,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -647,6 +673,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -670,11 +697,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -695,6 +723,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -717,11 +746,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -740,9 +770,10 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::buffer<Value> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -762,6 +793,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -784,11 +816,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -808,6 +841,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -830,11 +864,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::complete_exchange", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
 
     auto const num_neighbors = topology.num_neighbors(environment);
-    auto const receive_count = receive_buffer.count() / num_neighbors;
-    assert(receive_count * num_neighbors == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / num_neighbors;
+    assert(receive_count * num_neighbors == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -0,0 +1,545 @@
+#ifndef YAMPI_DATATYPE_LAYOUT_HPP
+# define YAMPI_DATATYPE_LAYOUT_HPP
+
+# include <cstddef>
+# include <vector>
+# include <limits>
+# include <utility>
+# include <memory>
+# include <type_traits>
+# include <mutex>
+
+# include <mpi.h>
+
+# include <boost/optional.hpp>
+
+# include <yampi/datatype.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Memory layouts of datatypes.
+//
+// ::yampi::flatten(datatype, environment) walks the constructors of datatype by MPI_Type_get_envelope and
+// MPI_Type_get_contents, and returns ::yampi::datatype_layout, the byte blocks (offset, length) of one element in the
+// order of its type map, where adjacent blocks are merged
+//
+//   auto const layout = ::yampi::flatten(datatype, environment);
+//   if (layout.is_complete())
+//     for (auto const& block: layout.blocks())
+//       // block.offset, block.length
+//
+// Layouts with more than max_num_blocks blocks, and those of datatypes built by unsupported constructors (darray and
+// Fortran types) are not complete.
+//
+// ::yampi::is_contiguous(datatype, environment) is true if consecutive elements of datatype fill one block of bytes.
+// The result is cached as an attribute of datatype, so that repeated queries on the same datatype are cheap. Queries
+// are thread-safe if MPI provides MPI_THREAD_MULTIPLE.
+//
+// If YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES is defined, sends of every mode, send_receive and receives of buffers with
+// such derived datatypes are transparently done as transfers of bytes. Because the type signatures are changed, the
+// macro assumes homogeneous processes, and both the sends and the receives of a message should be done by yampi.
+namespace yampi
+{
+  class datatype_layout
+  {
+   public:
+    struct block
+    {
+      MPI_Aint offset;
+      MPI_Aint length;
+    };
+
+   private:
+    std::vector<block> blocks_;
+    bool is_complete_;
+    MPI_Aint size_;
+    MPI_Aint lower_bound_;
+    MPI_Aint extent_;
+    MPI_Aint true_lower_bound_;
+    MPI_Aint true_extent_;
+
+   public:
+    datatype_layout(
+      std::vector<block>&& blocks, bool const is_complete, MPI_Aint const size,
+      MPI_Aint const lower_bound, MPI_Aint const extent,
+      MPI_Aint const true_lower_bound, MPI_Aint const true_extent) noexcept
+      : blocks_{std::move(blocks)}, is_complete_{is_complete}, size_{size},
+        lower_bound_{lower_bound}, extent_{extent}, true_lower_bound_{true_lower_bound}, true_extent_{true_extent}
+    { }
+
+    std::vector<block> const& blocks() const noexcept { return blocks_; }
+    bool is_complete() const noexcept { return is_complete_; }
+    MPI_Aint size() const noexcept { return size_; }
+    MPI_Aint lower_bound() const noexcept { return lower_bound_; }
+    MPI_Aint extent() const noexcept { return extent_; }
+    MPI_Aint true_lower_bound() const noexcept { return true_lower_bound_; }
+    MPI_Aint true_extent() const noexcept { return true_extent_; }
+
+    // one block without holes, and the next element begins just after it
+    bool is_contiguous() const noexcept
+    {
+      return is_complete_
+        and (size_ == 0 or (blocks_.size() == 1u and blocks_.front().length == size_ and extent_ == size_));
+    }
+  };
+
+  namespace datatype_layout_detail
+  {
+    class block_list
+    {
+      std::vector< ::yampi::datatype_layout::block > blocks_;
+      std::size_t max_num_blocks_;
+      bool is_complete_;
+
+     public:
+      explicit block_list(std::size_t const max_num_blocks)
+        : blocks_{}, max_num_blocks_{max_num_blocks}, is_complete_{true}
+      { }
+
+      std::vector< ::yampi::datatype_layout::block > const& blocks() const noexcept { return blocks_; }
+      std::vector< ::yampi::datatype_layout::block >&& release() noexcept { return std::move(blocks_); }
+      bool is_complete() const noexcept { return is_complete_; }
+      void mark_incomplete() noexcept { is_complete_ = false; }
+
+      void push(MPI_Aint const offset, MPI_Aint const length)
+      {
+        if (length == 0 or not is_complete_)
+          return;
+
+        if (not blocks_.empty() and blocks_.back().offset + blocks_.back().length == offset)
+          blocks_.back().length += length;
+        else if (blocks_.size() < max_num_blocks_)
+          blocks_.push_back(::yampi::datatype_layout::block{offset, length});
+        else
+          is_complete_ = false;
+      }
+
+      void append(block_list const& unit, MPI_Aint const displacement)
+      {
+        for (auto const& block: unit.blocks_)
+          push(displacement + block.offset, block.length);
+        is_complete_ = is_complete_ and unit.is_complete_;
+      }
+
+      // count copies of unit, the i-th of which is displaced by displacement + i * stride
+      void replicate(block_list const& unit, MPI_Aint const count, MPI_Aint const stride, MPI_Aint const displacement)
+      {
+        if (unit.blocks_.size() == 1u and unit.blocks_.front().length == stride)
+        {
+          push(displacement + unit.blocks_.front().offset, count * stride);
+          is_complete_ = is_complete_ and unit.is_complete_;
+          return;
+        }
+
+        for (auto index = MPI_Aint{0}; index < count and is_complete_; ++index)
+          append(unit, displacement + index * stride);
+        is_complete_ = is_complete_ and unit.is_complete_;
+      }
+    };
+
+    // datatypes returned by MPI_Type_get_contents should be freed unless they are named
+    class contents
+    {
+      std::vector<int> integers_;
+      std::vector<MPI_Aint> addresses_;
+      std::vector<MPI_Datatype> datatypes_;
+
+     public:
+      contents(
+        MPI_Datatype const mpi_datatype, int const num_integers, int const num_addresses, int const num_datatypes,
+        ::yampi::environment const& environment)
+        : integers_(static_cast<std::size_t>(num_integers)), addresses_(static_cast<std::size_t>(num_addresses)),
+          datatypes_(static_cast<std::size_t>(num_datatypes))
+      {
+        auto const error_code
+          = MPI_Type_get_contents(
+              mpi_datatype, num_integers, num_addresses, num_datatypes,
+              integers_.data(), addresses_.data(), datatypes_.data());
+        if (error_code != MPI_SUCCESS)
+        {
+          datatypes_.clear();
+          throw ::yampi::error{error_code, "yampi::flatten", environment};
+        }
+      }
+
+      contents(contents const&) = delete;
+      contents& operator=(contents const&) = delete;
+
+      ~contents() noexcept
+      {
+        for (auto& mpi_datatype: datatypes_)
+        {
+          int num_integers, num_addresses, num_datatypes, combiner;
+          if (MPI_Type_get_envelope(
+                mpi_datatype, std::addressof(num_integers), std::addressof(num_addresses),
+                std::addressof(num_datatypes), std::addressof(combiner)) == MPI_SUCCESS
+              and combiner != MPI_COMBINER_NAMED)
+            MPI_Type_free(std::addressof(mpi_datatype));
+        }
+      }
+
+      int integer(std::size_t const index) const { return integers_[index]; }
+      MPI_Aint address(std::size_t const index) const { return addresses_[index]; }
+      MPI_Datatype datatype(std::size_t const index) const { return datatypes_[index]; }
+    };
+
+    inline MPI_Aint extent_of(MPI_Datatype const mpi_datatype, ::yampi::environment const& environment)
+    {
+      MPI_Aint lower_bound, extent;
+      auto const error_code = MPI_Type_get_extent(mpi_datatype, std::addressof(lower_bound), std::addressof(extent));
+      return error_code == MPI_SUCCESS
+        ? extent
+        : throw ::yampi::error{error_code, "yampi::flatten", environment};
+    }
+
+    template <typename First, typename Second>
+    inline void flatten_pair(::yampi::datatype_layout_detail::block_list& result)
+    {
+      struct pair_type { First first; Second second; };
+      result.push(static_cast<MPI_Aint>(offsetof(pair_type, first)), static_cast<MPI_Aint>(sizeof(First)));
+      result.push(static_cast<MPI_Aint>(offsetof(pair_type, second)), static_cast<MPI_Aint>(sizeof(Second)));
+    }
+
+    inline void flatten_named(
+      MPI_Datatype const mpi_datatype, ::yampi::datatype_layout_detail::block_list& result,
+      ::yampi::environment const& environment)
+    {
+      if (mpi_datatype == MPI_FLOAT_INT)
+        ::yampi::datatype_layout_detail::flatten_pair<float, int>(result);
+      else if (mpi_datatype == MPI_DOUBLE_INT)
+        ::yampi::datatype_layout_detail::flatten_pair<double, int>(result);
+      else if (mpi_datatype == MPI_LONG_INT)
+        ::yampi::datatype_layout_detail::flatten_pair<long, int>(result);
+      else if (mpi_datatype == MPI_SHORT_INT)
+        ::yampi::datatype_layout_detail::flatten_pair<short, int>(result);
+      else if (mpi_datatype == MPI_LONG_DOUBLE_INT)
+        ::yampi::datatype_layout_detail::flatten_pair<long double, int>(result);
+      else
+      {
+        int size;
+        auto const error_code = MPI_Type_size(mpi_datatype, std::addressof(size));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::flatten", environment};
+
+        if (static_cast<MPI_Aint>(size) == ::yampi::datatype_layout_detail::extent_of(mpi_datatype, environment))
+          result.push(MPI_Aint{0}, static_cast<MPI_Aint>(size));
+        else
+          result.mark_incomplete();
+      }
+    }
+
+    inline ::yampi::datatype_layout_detail::block_list collect_blocks(
+      MPI_Datatype const mpi_datatype, std::size_t const max_num_blocks, ::yampi::environment const& environment);
+
+    // count blocks of lengths[i] elements of base_datatype displaced by displacements[i] bytes
+    template <typename LengthAt, typename DisplacementAt>
+    inline void flatten_blocks(
+      MPI_Datatype const base_datatype, int const count, LengthAt length_at, DisplacementAt displacement_at,
+      ::yampi::datatype_layout_detail::block_list& result, std::size_t const max_num_blocks,
+      ::yampi::environment const& environment)
+    {
+      auto const unit = ::yampi::datatype_layout_detail::collect_blocks(base_datatype, max_num_blocks, environment);
+      auto const extent = ::yampi::datatype_layout_detail::extent_of(base_datatype, environment);
+      for (auto index = 0; index < count and result.is_complete(); ++index)
+        result.replicate(
+          unit, static_cast<MPI_Aint>(length_at(index)), extent, static_cast<MPI_Aint>(displacement_at(index)));
+    }
+
+    inline void flatten_subarray(
+      ::yampi::datatype_layout_detail::contents const& contents,
+      ::yampi::datatype_layout_detail::block_list& result, std::size_t const max_num_blocks,
+      ::yampi::environment const& environment)
+    {
+      auto const num_dimensions = static_cast<std::size_t>(contents.integer(0u));
+      auto const is_c_order = contents.integer(3u * num_dimensions + 1u) == MPI_ORDER_C;
+      // the dimension varying fastest comes first
+      auto const integer_at
+        = [&contents, num_dimensions, is_c_order](std::size_t const kind, std::size_t const dimension)
+          {
+            return static_cast<MPI_Aint>(
+              contents.integer(
+                1u + kind * num_dimensions + (is_c_order ? num_dimensions - 1u - dimension : dimension)));
+          };
+
+      auto unit = ::yampi::datatype_layout_detail::collect_blocks(contents.datatype(0u), max_num_blocks, environment);
+      auto stride = ::yampi::datatype_layout_detail::extent_of(contents.datatype(0u), environment);
+      for (auto dimension = std::size_t{0u}; dimension < num_dimensions; ++dimension)
+      {
+        ::yampi::datatype_layout_detail::block_list rows{max_num_blocks};
+        rows.replicate(unit, integer_at(1u, dimension), stride, integer_at(2u, dimension) * stride);
+        unit = std::move(rows);
+        stride *= integer_at(0u, dimension);
+      }
+      result.append(unit, MPI_Aint{0});
+    }
+
+    inline ::yampi::datatype_layout_detail::block_list collect_blocks(
+      MPI_Datatype const mpi_datatype, std::size_t const max_num_blocks, ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_layout_detail::block_list result{max_num_blocks};
+
+      int num_integers, num_addresses, num_datatypes, combiner;
+      auto const error_code
+        = MPI_Type_get_envelope(
+            mpi_datatype, std::addressof(num_integers), std::addressof(num_addresses),
+            std::addressof(num_datatypes), std::addressof(combiner));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::flatten", environment};
+
+      if (combiner == MPI_COMBINER_NAMED)
+      {
+        ::yampi::datatype_layout_detail::flatten_named(mpi_datatype, result, environment);
+        return result;
+      }
+
+      ::yampi::datatype_layout_detail::contents const contents{
+        mpi_datatype, num_integers, num_addresses, num_datatypes, environment};
+      switch (combiner)
+      {
+       case MPI_COMBINER_DUP:
+       case MPI_COMBINER_RESIZED:
+        result.append(
+          ::yampi::datatype_layout_detail::collect_blocks(contents.datatype(0u), max_num_blocks, environment),
+          MPI_Aint{0});
+        break;
+       case MPI_COMBINER_CONTIGUOUS:
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), 1,
+          [&contents](int) { return contents.integer(0u); }, [](int) { return 0; },
+          result, max_num_blocks, environment);
+        break;
+       case MPI_COMBINER_VECTOR:
+       {
+        auto const stride
+          = static_cast<MPI_Aint>(contents.integer(2u))
+            * ::yampi::datatype_layout_detail::extent_of(contents.datatype(0u), environment);
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), contents.integer(0u),
+          [&contents](int) { return contents.integer(1u); },
+          [stride](int const index) { return static_cast<MPI_Aint>(index) * stride; },
+          result, max_num_blocks, environment);
+        break;
+       }
+       case MPI_COMBINER_HVECTOR:
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), contents.integer(0u),
+          [&contents](int) { return contents.integer(1u); },
+          [&contents](int const index) { return static_cast<MPI_Aint>(index) * contents.address(0u); },
+          result, max_num_blocks, environment);
+        break;
+       case MPI_COMBINER_INDEXED:
+       {
+        auto const count = contents.integer(0u);
+        auto const extent = ::yampi::datatype_layout_detail::extent_of(contents.datatype(0u), environment);
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), count,
+          [&contents](int const index) { return contents.integer(1u + index); },
+          [&contents, count, extent](int const index)
+          { return static_cast<MPI_Aint>(contents.integer(1u + count + index)) * extent; },
+          result, max_num_blocks, environment);
+        break;
+       }
+       case MPI_COMBINER_HINDEXED:
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), contents.integer(0u),
+          [&contents](int const index) { return contents.integer(1u + index); },
+          [&contents](int const index) { return contents.address(index); },
+          result, max_num_blocks, environment);
+        break;
+       case MPI_COMBINER_INDEXED_BLOCK:
+       {
+        auto const extent = ::yampi::datatype_layout_detail::extent_of(contents.datatype(0u), environment);
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), contents.integer(0u),
+          [&contents](int) { return contents.integer(1u); },
+          [&contents, extent](int const index) { return static_cast<MPI_Aint>(contents.integer(2u + index)) * extent; },
+          result, max_num_blocks, environment);
+        break;
+       }
+# if MPI_VERSION >= 3
+       case MPI_COMBINER_HINDEXED_BLOCK:
+        ::yampi::datatype_layout_detail::flatten_blocks(
+          contents.datatype(0u), contents.integer(0u),
+          [&contents](int) { return contents.integer(1u); },
+          [&contents](int const index) { return contents.address(index); },
+          result, max_num_blocks, environment);
+        break;
+# endif // MPI_VERSION >= 3
+       case MPI_COMBINER_STRUCT:
+        for (auto index = 0; index < contents.integer(0u) and result.is_complete(); ++index)
+          ::yampi::datatype_layout_detail::flatten_blocks(
+            contents.datatype(index), 1,
+            [&contents, index](int) { return contents.integer(1u + index); },
+            [&contents, index](int) { return contents.address(index); },
+            result, max_num_blocks, environment);
+        break;
+       case MPI_COMBINER_SUBARRAY:
+        ::yampi::datatype_layout_detail::flatten_subarray(contents, result, max_num_blocks, environment);
+        break;
+       default:
+        result.mark_incomplete();
+        break;
+      }
+
+      return result;
+    }
+
+    inline ::yampi::datatype_layout flatten(
+      MPI_Datatype const mpi_datatype, std::size_t const max_num_blocks, ::yampi::environment const& environment)
+    {
+      auto blocks = ::yampi::datatype_layout_detail::collect_blocks(mpi_datatype, max_num_blocks, environment);
+
+      int size;
+      MPI_Aint lower_bound, extent, true_lower_bound, true_extent;
+      auto error_code = MPI_Type_size(mpi_datatype, std::addressof(size));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::flatten", environment};
+      error_code = MPI_Type_get_extent(mpi_datatype, std::addressof(lower_bound), std::addressof(extent));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::flatten", environment};
+      error_code
+        = MPI_Type_get_true_extent(mpi_datatype, std::addressof(true_lower_bound), std::addressof(true_extent));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::flatten", environment};
+
+      auto const is_complete = blocks.is_complete();
+      return ::yampi::datatype_layout{
+        blocks.release(), is_complete, static_cast<MPI_Aint>(size),
+        lower_bound, extent, true_lower_bound, true_extent};
+    }
+
+    // offset of the first byte if the datatype is contiguous
+    struct contiguity
+    {
+      bool is_contiguous;
+      MPI_Aint offset;
+      MPI_Aint size;
+    };
+
+    inline int delete_contiguity(MPI_Datatype, int, void* attribute, void*)
+    {
+      delete static_cast< ::yampi::datatype_layout_detail::contiguity* >(attribute);
+      return MPI_SUCCESS;
+    }
+
+    // attributes of datatypes are deleted when the datatypes are freed, and the keyval is freed at MPI_Finalize
+    inline int contiguity_keyval(::yampi::environment const& environment)
+    {
+      static int const keyval
+        = [&environment]()
+          {
+            int keyval = MPI_KEYVAL_INVALID;
+            auto error_code
+              = MPI_Type_create_keyval(
+                  MPI_TYPE_NULL_COPY_FN, &::yampi::datatype_layout_detail::delete_contiguity,
+                  std::addressof(keyval), nullptr);
+            if (error_code != MPI_SUCCESS)
+              throw ::yampi::error{error_code, "yampi::is_contiguous", environment};
+
+            error_code
+              = ::yampi::detail::at_finalize([keyval]() mutable { MPI_Type_free_keyval(std::addressof(keyval)); });
+            if (error_code != MPI_SUCCESS)
+            {
+              MPI_Type_free_keyval(std::addressof(keyval));
+              throw ::yampi::error{error_code, "yampi::is_contiguous", environment};
+            }
+            return keyval;
+          }();
+      return keyval;
+    }
+
+    inline bool find_contiguity(
+      MPI_Datatype const mpi_datatype, int const keyval, ::yampi::datatype_layout_detail::contiguity& result,
+      ::yampi::environment const& environment)
+    {
+      void* attribute;
+      int is_found;
+      auto const error_code
+        = MPI_Type_get_attr(mpi_datatype, keyval, std::addressof(attribute), std::addressof(is_found));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::is_contiguous", environment};
+      if (is_found)
+        result = *static_cast< ::yampi::datatype_layout_detail::contiguity const* >(attribute);
+      return is_found;
+    }
+
+    // The attribute is set only once per datatype, because setting it again would delete the one other threads read
+    inline ::yampi::datatype_layout_detail::contiguity cached_contiguity(
+      MPI_Datatype const mpi_datatype, ::yampi::environment const& environment)
+    {
+      auto const keyval = ::yampi::datatype_layout_detail::contiguity_keyval(environment);
+
+      ::yampi::datatype_layout_detail::contiguity result;
+      if (::yampi::datatype_layout_detail::find_contiguity(mpi_datatype, keyval, result, environment))
+        return result;
+
+      static std::mutex mutex;
+      std::lock_guard<std::mutex> lock{mutex};
+      if (::yampi::datatype_layout_detail::find_contiguity(mpi_datatype, keyval, result, environment))
+        return result;
+
+      // two blocks are enough to know that the datatype is not contiguous
+      auto const layout = ::yampi::datatype_layout_detail::flatten(mpi_datatype, std::size_t{1u}, environment);
+      std::unique_ptr< ::yampi::datatype_layout_detail::contiguity > attribute{
+        new ::yampi::datatype_layout_detail::contiguity{
+          layout.is_contiguous(), layout.blocks().empty() ? MPI_Aint{0} : layout.blocks().front().offset,
+          layout.size()}};
+      auto const error_code = MPI_Type_set_attr(mpi_datatype, keyval, attribute.get());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::is_contiguous", environment};
+      return *attribute.release();
+    }
+
+    template <typename Value>
+    inline boost::optional< ::yampi::buffer<unsigned char> > to_byte_buffer(
+      ::yampi::buffer<Value> const, ::yampi::environment const&, std::true_type)
+    { return boost::none; }
+
+    template <typename Value>
+    inline boost::optional< ::yampi::buffer<unsigned char> > to_byte_buffer(
+      ::yampi::buffer<Value> const buffer, ::yampi::environment const& environment, std::false_type)
+    {
+      auto const contiguity
+        = ::yampi::datatype_layout_detail::cached_contiguity(buffer.datatype().mpi_datatype(), environment);
+      if (not contiguity.is_contiguous)
+        return boost::none;
+
+# if MPI_VERSION >= 4
+      auto const count = static_cast<MPI_Aint>(buffer.count().mpi_count());
+# else // MPI_VERSION >= 4
+      // byte counts exceeding INT_MAX are handled by <yampi/large_count.hpp>
+      auto const count = static_cast<MPI_Aint>(buffer.large_count());
+# endif // MPI_VERSION >= 4
+
+      using value_type = typename std::remove_cv<Value>::type;
+      auto const first
+        = reinterpret_cast<unsigned char*>(const_cast<value_type*>(buffer.data())) + contiguity.offset;
+      return ::yampi::buffer<unsigned char>{first, first + count * contiguity.size};
+    }
+
+    // buffers of predefined datatypes are already contiguous
+    template <typename Value>
+    inline boost::optional< ::yampi::buffer<unsigned char> > to_byte_buffer(
+      ::yampi::buffer<Value> const buffer, ::yampi::environment const& environment)
+    {
+      return ::yampi::datatype_layout_detail::to_byte_buffer(
+        buffer, environment, ::yampi::has_predefined_datatype<Value>{});
+    }
+  } // namespace datatype_layout_detail
+
+  inline ::yampi::datatype_layout flatten(
+    ::yampi::datatype const& datatype, ::yampi::environment const& environment,
+    std::size_t const max_num_blocks = std::numeric_limits<std::size_t>::max())
+  { return ::yampi::datatype_layout_detail::flatten(datatype.mpi_datatype(), max_num_blocks, environment); }
+
+  inline bool is_contiguous(::yampi::datatype const& datatype, ::yampi::environment const& environment)
+  {
+    return ::yampi::datatype_layout_detail::cached_contiguity(datatype.mpi_datatype(), environment).is_contiguous;
+  }
+}
+
+
+#endif
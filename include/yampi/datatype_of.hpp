@@ -0,0 +1,394 @@
+#ifndef YAMPI_DATATYPE_OF_HPP
+# define YAMPI_DATATYPE_OF_HPP
+
+# include <cstddef>
+# include <utility>
+# include <tuple>
+# include <array>
+# include <vector>
+# include <type_traits>
+# include <mutex>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/datatype.hpp>
+# include <yampi/predefined_datatype.hpp>
+# include <yampi/has_predefined_datatype.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Datatypes deduced from C++ types.
+//
+// ::yampi::datatype_of<T>(environment) returns the committed datatype of T, built on the first call and cached until
+// MPI is finalized. T may be
+//   - a type with a predefined datatype,
+//   - an enumeration (the datatype of its underlying type),
+//   - an array T[N] or std::array<T, N>,
+//   - std::pair or std::tuple, or
+//   - an aggregate class without base classes and with at most 16 members (C++17 or later),
+// where the elements and members are such types again. Members of aggregates are enumerated by structured bindings
+// after counting them by aggregate initialization, so arrays in aggregates must be std::array's. Members are found at
+// their offsets in a value-initialized T, so T must be default constructible. The extent of the datatype is always
+// sizeof(T).
+//
+// If T has no padding, the datatype is contiguous: N elements of the predefined datatype if all the members are of the
+// same one, or sizeof(T) MPI_BYTE's otherwise. Only types with padding get struct datatypes.
+//
+//   struct particle { std::array<double, 3> position; std::array<double, 3> velocity; int id; };
+//   std::vector<particle> particles(n);
+//   ::yampi::send(::yampi::make_buffer(particles.begin(), particles.end(), environment), destination, tag, communicator, environment);
+namespace yampi
+{
+  namespace datatype_of_detail
+  {
+    struct entry
+    {
+      ::yampi::datatype datatype;
+      // the predefined datatype of all the elements, or MPI_DATATYPE_NULL
+      MPI_Datatype element;
+    };
+
+    // Builds the datatype of sizeof_value bytes from its members. The member blocks are merged into one contiguous
+    // datatype if they cover all the bytes
+    inline ::yampi::datatype_of_detail::entry make_entry(
+      std::size_t const sizeof_value, std::vector<int> const& lengths, std::vector<MPI_Aint> const& displacements,
+      std::vector<MPI_Datatype> const& mpi_datatypes, MPI_Datatype const element,
+      ::yampi::environment const& environment)
+    {
+      MPI_Datatype struct_datatype;
+      auto error_code
+        = MPI_Type_create_struct(
+            static_cast<int>(lengths.size()), lengths.data(), displacements.data(), mpi_datatypes.data(),
+            std::addressof(struct_datatype));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+
+      int size;
+      error_code = MPI_Type_size(struct_datatype, std::addressof(size));
+      if (error_code != MPI_SUCCESS)
+      {
+        MPI_Type_free(std::addressof(struct_datatype));
+        throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+      }
+
+      MPI_Datatype result;
+      if (static_cast<std::size_t>(size) == sizeof_value)
+      {
+        MPI_Type_free(std::addressof(struct_datatype));
+
+        auto element_size = 1;
+        if (element != MPI_DATATYPE_NULL)
+        {
+          error_code = MPI_Type_size(element, std::addressof(element_size));
+          if (error_code != MPI_SUCCESS)
+            throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+          if (element_size == size)
+            return ::yampi::datatype_of_detail::entry{::yampi::datatype{element}, element};
+        }
+
+        error_code
+          = MPI_Type_contiguous(
+              size / element_size, element != MPI_DATATYPE_NULL ? element : MPI_BYTE, std::addressof(result));
+      }
+      else
+      {
+        error_code
+          = MPI_Type_create_resized(
+              struct_datatype, MPI_Aint{0}, static_cast<MPI_Aint>(sizeof_value), std::addressof(result));
+        MPI_Type_free(std::addressof(struct_datatype));
+      }
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+
+      error_code = MPI_Type_commit(std::addressof(result));
+      if (error_code != MPI_SUCCESS)
+      {
+        MPI_Type_free(std::addressof(result));
+        throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+      }
+      return ::yampi::datatype_of_detail::entry{::yampi::datatype{result}, element};
+    }
+
+    template <typename T>
+    ::yampi::datatype_of_detail::entry const& entry_of(::yampi::environment const& environment);
+
+    // Collects the blocks of the members of a value
+    template <typename Value>
+    class member_collector
+    {
+      Value const& value_;
+      ::yampi::environment const& environment_;
+      std::vector<int> lengths_;
+      std::vector<MPI_Aint> displacements_;
+      std::vector<MPI_Datatype> mpi_datatypes_;
+      MPI_Datatype element_;
+
+     public:
+      member_collector(Value const& value, ::yampi::environment const& environment)
+        : value_{value}, environment_{environment}, lengths_{}, displacements_{}, mpi_datatypes_{},
+          element_{MPI_DATATYPE_NULL}
+      { }
+
+      template <typename Member>
+      void operator()(Member const& member, int const length = 1)
+      {
+        auto const& member_entry
+          = ::yampi::datatype_of_detail::entry_of<typename std::remove_cv<Member>::type>(environment_);
+        element_
+          = mpi_datatypes_.empty() or element_ == member_entry.element ? member_entry.element : MPI_DATATYPE_NULL;
+
+        lengths_.push_back(length);
+        displacements_.push_back(
+          static_cast<MPI_Aint>(
+            reinterpret_cast<char const*>(std::addressof(member))
+            - reinterpret_cast<char const*>(std::addressof(value_))));
+        mpi_datatypes_.push_back(member_entry.datatype.mpi_datatype());
+      }
+
+      ::yampi::datatype_of_detail::entry make_entry() const
+      {
+        return ::yampi::datatype_of_detail::make_entry(
+          sizeof(Value), lengths_, displacements_, mpi_datatypes_, element_, environment_);
+      }
+    };
+
+    template <typename Function, typename... Members>
+    inline void call_each(Function& function, Members const&... members)
+    {
+      int dummy[] = {0, (function(members), 0)...};
+      static_cast<void>(dummy);
+    }
+
+    template <typename T>
+    struct is_std_array : std::false_type { };
+
+    template <typename T, std::size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type { };
+
+    // members<T>::for_each(value, function) calls function(member) for each member of value
+    template <typename T, typename Enable = void>
+    struct members
+    {
+      static constexpr bool value = false;
+    };
+
+    template <typename T1, typename T2>
+    struct members<std::pair<T1, T2>>
+    {
+      static constexpr bool value = true;
+
+      template <typename Function>
+      static void for_each(std::pair<T1, T2> const& pair, Function& function)
+      { ::yampi::datatype_of_detail::call_each(function, pair.first, pair.second); }
+    };
+
+    template <typename... Ts>
+    struct members<std::tuple<Ts...>>
+    {
+      static constexpr bool value = true;
+
+      template <typename Function>
+      static void for_each(std::tuple<Ts...> const& tuple, Function& function)
+      { for_each(tuple, function, std::index_sequence_for<Ts...>{}); }
+
+     private:
+      template <typename Function, std::size_t... indices>
+      static void for_each(std::tuple<Ts...> const& tuple, Function& function, std::index_sequence<indices...>)
+      { ::yampi::datatype_of_detail::call_each(function, std::get<indices>(tuple)...); }
+    };
+
+# if __cplusplus >= 201703L
+    // Converts to any type, to count the members of aggregates by aggregate initialization
+    struct any_member
+    {
+      template <typename T>
+      operator T() const noexcept;
+    };
+
+    template <typename T, typename Indices, typename Enable = void>
+    struct is_initializable_by : std::false_type { };
+
+    template <typename T, std::size_t... indices>
+    struct is_initializable_by<
+      T, std::index_sequence<indices...>,
+      std::void_t<decltype(T{(static_cast<void>(indices), ::yampi::datatype_of_detail::any_member{})...})>>
+      : std::true_type
+    { };
+
+    template <typename T, std::size_t N = 0u, typename Enable = void>
+    struct num_members
+      : std::integral_constant<std::size_t, N - 1u>
+    { };
+
+    template <typename T, std::size_t N>
+    struct num_members<
+      T, N, std::enable_if_t< ::yampi::datatype_of_detail::is_initializable_by<T, std::make_index_sequence<N>>::value >>
+      : ::yampi::datatype_of_detail::num_members<T, N + 1u>
+    { };
+
+    template <std::size_t N>
+    struct member_visitor;
+
+#   define YAMPI_MAKE_MEMBER_VISITOR(n, ...) \
+    template <>\
+    struct member_visitor<n>\
+    {\
+      template <typename Aggregate, typename Function>\
+      static void call(Aggregate const& aggregate, Function& function)\
+      {\
+        auto const& [__VA_ARGS__] = aggregate;\
+        ::yampi::datatype_of_detail::call_each(function, __VA_ARGS__);\
+      }\
+    };
+
+    YAMPI_MAKE_MEMBER_VISITOR(1, m0)
+    YAMPI_MAKE_MEMBER_VISITOR(2, m0, m1)
+    YAMPI_MAKE_MEMBER_VISITOR(3, m0, m1, m2)
+    YAMPI_MAKE_MEMBER_VISITOR(4, m0, m1, m2, m3)
+    YAMPI_MAKE_MEMBER_VISITOR(5, m0, m1, m2, m3, m4)
+    YAMPI_MAKE_MEMBER_VISITOR(6, m0, m1, m2, m3, m4, m5)
+    YAMPI_MAKE_MEMBER_VISITOR(7, m0, m1, m2, m3, m4, m5, m6)
+    YAMPI_MAKE_MEMBER_VISITOR(8, m0, m1, m2, m3, m4, m5, m6, m7)
+    YAMPI_MAKE_MEMBER_VISITOR(9, m0, m1, m2, m3, m4, m5, m6, m7, m8)
+    YAMPI_MAKE_MEMBER_VISITOR(10, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9)
+    YAMPI_MAKE_MEMBER_VISITOR(11, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10)
+    YAMPI_MAKE_MEMBER_VISITOR(12, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11)
+    YAMPI_MAKE_MEMBER_VISITOR(13, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12)
+    YAMPI_MAKE_MEMBER_VISITOR(14, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13)
+    YAMPI_MAKE_MEMBER_VISITOR(15, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14)
+    YAMPI_MAKE_MEMBER_VISITOR(16, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15)
+
+#   undef YAMPI_MAKE_MEMBER_VISITOR
+
+    template <typename T>
+    struct members<
+      T,
+      std::enable_if_t<
+        std::is_aggregate<T>::value and std::is_class<T>::value
+        and (not ::yampi::has_predefined_datatype<T>::value)
+        and (not ::yampi::datatype_of_detail::is_std_array<T>::value)>>
+    {
+      static constexpr bool value = true;
+
+      template <typename Function>
+      static void for_each(T const& aggregate, Function& function)
+      {
+        static_assert(
+          ::yampi::datatype_of_detail::num_members<T>::value >= 1u
+            and ::yampi::datatype_of_detail::num_members<T>::value <= 16u,
+          "The number of members of T must be from 1 to 16");
+        ::yampi::datatype_of_detail::member_visitor< ::yampi::datatype_of_detail::num_members<T>::value >::call(
+          aggregate, function);
+      }
+    };
+# endif // __cplusplus >= 201703L
+
+    template <typename T, std::size_t N, typename Collector>
+    inline void for_each_block(T const (&array)[N], Collector& collector)
+    { collector(array[0], static_cast<int>(N)); }
+
+    template <typename T, std::size_t N, typename Collector>
+    inline void for_each_block(std::array<T, N> const& array, Collector& collector)
+    {
+      static_assert(N > 0u, "std::array<T, 0> has no datatype");
+      collector(*array.data(), static_cast<int>(N));
+    }
+
+    template <typename T, typename Collector>
+    inline typename std::enable_if< ::yampi::datatype_of_detail::members<T>::value, void >::type
+    for_each_block(T const& value, Collector& collector)
+    { ::yampi::datatype_of_detail::members<T>::for_each(value, collector); }
+
+    template <typename T>
+    inline ::yampi::datatype_of_detail::entry make_entry(
+      std::true_type, ::yampi::environment const&)
+    {
+      auto const mpi_datatype = ::yampi::predefined_datatype<T>().mpi_datatype();
+      return ::yampi::datatype_of_detail::entry{::yampi::datatype{mpi_datatype}, mpi_datatype};
+    }
+
+    template <typename T>
+    inline ::yampi::datatype_of_detail::entry make_entry(
+      std::false_type, ::yampi::environment const& environment)
+    {
+      static_assert(
+        std::is_array<T>::value or ::yampi::datatype_of_detail::is_std_array<T>::value
+          or ::yampi::datatype_of_detail::members<T>::value,
+        "T must have a predefined datatype or be an enumeration, an array, std::pair, std::tuple or an aggregate");
+
+      T const value{};
+      ::yampi::datatype_of_detail::member_collector<T> collector{value, environment};
+      ::yampi::datatype_of_detail::for_each_block(value, collector);
+      return collector.make_entry();
+    }
+
+    struct finalized_datatypes
+    {
+      std::mutex mutex;
+      std::vector< ::yampi::datatype* > datatype_ptrs;
+    };
+
+    // The cached datatypes of all T's are freed by one hook at the beginning of MPI_Finalize. Cached objects are never
+    // destroyed, so the hook doesn't depend on the order of MPI_Finalize and the destruction of static objects
+    inline bool free_at_finalize(::yampi::datatype& datatype, ::yampi::environment const& environment)
+    {
+      static auto& finalized = *new ::yampi::datatype_of_detail::finalized_datatypes{};
+      static int const error_code
+        = ::yampi::detail::at_finalize(
+            []()
+            {
+              std::lock_guard<std::mutex> lock{finalized.mutex};
+              for (auto const datatype_ptr: finalized.datatype_ptrs)
+                *datatype_ptr = ::yampi::datatype{};
+              finalized.datatype_ptrs.clear();
+            });
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::datatype_of", environment};
+
+      std::lock_guard<std::mutex> lock{finalized.mutex};
+      finalized.datatype_ptrs.push_back(std::addressof(datatype));
+      return true;
+    }
+
+    template <typename T>
+    struct is_enum_without_predefined_datatype
+      : std::integral_constant<bool, std::is_enum<T>::value and (not ::yampi::has_predefined_datatype<T>::value)>
+    { };
+
+    template <typename T>
+    inline typename std::enable_if<
+      not ::yampi::datatype_of_detail::is_enum_without_predefined_datatype<T>::value,
+      ::yampi::datatype_of_detail::entry const&>::type
+    cached_entry_of(::yampi::environment const& environment)
+    {
+      static auto& result
+        = *new ::yampi::datatype_of_detail::entry{
+            ::yampi::datatype_of_detail::make_entry<T>(::yampi::has_predefined_datatype<T>{}, environment)};
+      static bool const is_freed_at_finalize
+        = ::yampi::datatype_of_detail::free_at_finalize(result.datatype, environment);
+      static_cast<void>(is_freed_at_finalize);
+      return result;
+    }
+
+    template <typename T>
+    inline typename std::enable_if<
+      ::yampi::datatype_of_detail::is_enum_without_predefined_datatype<T>::value,
+      ::yampi::datatype_of_detail::entry const&>::type
+    cached_entry_of(::yampi::environment const& environment)
+    { return ::yampi::datatype_of_detail::entry_of<typename std::underlying_type<T>::type>(environment); }
+
+    template <typename T>
+    inline ::yampi::datatype_of_detail::entry const& entry_of(::yampi::environment const& environment)
+    { return ::yampi::datatype_of_detail::cached_entry_of<T>(environment); }
+  } // namespace datatype_of_detail
+
+  template <typename T>
+  inline ::yampi::datatype const& datatype_of(::yampi::environment const& environment)
+  { return ::yampi::datatype_of_detail::entry_of<typename std::remove_cv<T>::type>(environment).datatype; }
+}
+
+
+#endif
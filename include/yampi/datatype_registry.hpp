@@ -0,0 +1,329 @@
+#ifndef YAMPI_DATATYPE_REGISTRY_HPP
+# define YAMPI_DATATYPE_REGISTRY_HPP
+
+# include <cstddef>
+# include <vector>
+# include <unordered_map>
+# include <functional>
+# include <mutex>
+# include <utility>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/datatype.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/count.hpp>
+# include <yampi/byte_displacement.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Registry of committed derived datatypes.
+//
+// ::yampi::datatype_registry::instance(environment).derive(arguments..., environment) returns the datatype which
+// ::yampi::datatype{arguments..., environment} would construct, creating and committing it only on the first call with
+// the same arguments. Contiguous, vector, hvector, indexed, hindexed, indexed block, hindexed block, struct and
+// subarray datatypes are supported. Repeated exchanges then reuse one datatype instead of creating and freeing one each
+// time
+//
+//   auto& registry = ::yampi::datatype_registry::instance(environment);
+//   for (...)
+//   {
+//     auto const& face_datatype
+//       = registry.derive(::yampi::predefined_datatype<double>(), ::yampi::strided_block{nx, nx * ny}, nz, environment);
+//     // communicate faces with face_datatype
+//   }
+//
+// Entries are keyed by the combiner, the integer arguments and the handles of the base datatypes, so base datatypes
+// must not be freed while entries derived from them are used. The instance is cleared at the beginning of
+// MPI_Finalize. All the member functions are thread-safe, but creating datatypes concurrently requires
+// MPI_THREAD_MULTIPLE.
+namespace yampi
+{
+  struct datatype_registry_key
+  {
+    int combiner;
+    std::vector<MPI_Count> integers;
+    std::vector<MPI_Datatype> datatypes;
+
+    bool operator==(datatype_registry_key const& other) const
+    { return combiner == other.combiner and integers == other.integers and datatypes == other.datatypes; }
+  };
+
+  struct datatype_registry_key_hash
+  {
+    std::size_t operator()(::yampi::datatype_registry_key const& key) const noexcept
+    {
+      auto result = std::hash<int>{}(key.combiner);
+      for (auto const integer: key.integers)
+        result = combine(result, std::hash<MPI_Count>{}(integer));
+      for (auto const mpi_datatype: key.datatypes)
+        result = combine(result, std::hash<MPI_Datatype>{}(mpi_datatype));
+      return result;
+    }
+
+   private:
+    static std::size_t combine(std::size_t const seed, std::size_t const hash) noexcept
+    { return seed ^ (hash + 0x9e3779b9u + (seed << 6u) + (seed >> 2u)); }
+  };
+
+  namespace datatype_registry_detail
+  {
+    inline MPI_Count integer_of(int const value) noexcept { return static_cast<MPI_Count>(value); }
+    inline MPI_Count integer_of(::yampi::count const& count) noexcept
+    { return static_cast<MPI_Count>(count.mpi_count()); }
+    inline MPI_Count integer_of(::yampi::byte_displacement const& byte_displacement) noexcept
+    { return static_cast<MPI_Count>(byte_displacement.mpi_byte_displacement()); }
+
+    template <typename Iterator>
+    inline void append(std::vector<MPI_Count>& integers, Iterator first, Iterator const last)
+    {
+      for (; first != last; ++first)
+        integers.push_back(::yampi::datatype_registry_detail::integer_of(*first));
+    }
+  } // namespace datatype_registry_detail
+
+  class datatype_registry
+  {
+    mutable std::mutex mutex_;
+    std::unordered_map< ::yampi::datatype_registry_key, ::yampi::datatype, ::yampi::datatype_registry_key_hash >
+      datatypes_;
+    std::size_t num_hits_;
+    std::size_t num_misses_;
+
+   public:
+    datatype_registry() : mutex_{}, datatypes_{}, num_hits_{0u}, num_misses_{0u} { }
+
+    datatype_registry(datatype_registry const&) = delete;
+    datatype_registry& operator=(datatype_registry const&) = delete;
+    datatype_registry(datatype_registry&&) = delete;
+    datatype_registry& operator=(datatype_registry&&) = delete;
+
+    // Returns the registry shared in the process, which is cleared at the beginning of MPI_Finalize. The instance is
+    // never destroyed, so that it is alive at MPI_Finalize after the destruction of static objects
+    static datatype_registry& instance(::yampi::environment const& environment)
+    {
+      static auto& result = *new datatype_registry{};
+      static int const error_code = ::yampi::detail::at_finalize([]() { result.clear(); });
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::datatype_registry::instance", environment};
+      return result;
+    }
+
+    // MPI_Type_contiguous
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype, ::yampi::count const count,
+      ::yampi::environment const& environment)
+    {
+      return find_or_derive(
+        ::yampi::datatype_registry_key{
+          MPI_COMBINER_CONTIGUOUS, {::yampi::datatype_registry_detail::integer_of(count)},
+          {base_datatype.mpi_datatype()}},
+        [&base_datatype, count, &environment]() { return ::yampi::datatype{base_datatype, count, environment}; });
+    }
+
+    // MPI_Type_vector
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::strided_block const& block, ::yampi::count const count,
+      ::yampi::environment const& environment)
+    {
+      return find_or_derive(
+        ::yampi::datatype_registry_key{
+          MPI_COMBINER_VECTOR,
+          {::yampi::datatype_registry_detail::integer_of(count),
+           ::yampi::datatype_registry_detail::integer_of(block.length()),
+           ::yampi::datatype_registry_detail::integer_of(block.stride())},
+          {base_datatype.mpi_datatype()}},
+        [&base_datatype, &block, count, &environment]()
+        { return ::yampi::datatype{base_datatype, block, count, environment}; });
+    }
+
+    // MPI_Type_create_hvector
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::heterogeneous_strided_block const& block, ::yampi::count const count,
+      ::yampi::environment const& environment)
+    {
+      return find_or_derive(
+        ::yampi::datatype_registry_key{
+          MPI_COMBINER_HVECTOR,
+          {::yampi::datatype_registry_detail::integer_of(count),
+           ::yampi::datatype_registry_detail::integer_of(block.length()),
+           ::yampi::datatype_registry_detail::integer_of(block.stride_bytes())},
+          {base_datatype.mpi_datatype()}},
+        [&base_datatype, &block, count, &environment]()
+        { return ::yampi::datatype{base_datatype, block, count, environment}; });
+    }
+
+    // MPI_Type_indexed
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::flexible_blocks const& blocks,
+      ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_registry_key key{MPI_COMBINER_INDEXED, {}, {base_datatype.mpi_datatype()}};
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.length_begin(), blocks.length_end());
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.displacement_begin(), blocks.displacement_end());
+      return find_or_derive(
+        std::move(key),
+        [&base_datatype, &blocks, &environment]() { return ::yampi::datatype{base_datatype, blocks, environment}; });
+    }
+
+    // MPI_Type_create_hindexed
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::heterogeneous_flexible_blocks const& blocks,
+      ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_registry_key key{MPI_COMBINER_HINDEXED, {}, {base_datatype.mpi_datatype()}};
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.length_begin(), blocks.length_end());
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.displacement_begin(), blocks.displacement_end());
+      return find_or_derive(
+        std::move(key),
+        [&base_datatype, &blocks, &environment]() { return ::yampi::datatype{base_datatype, blocks, environment}; });
+    }
+
+    // MPI_Type_create_indexed_block
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::fixed_blocks const& blocks,
+      ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_registry_key key{
+        MPI_COMBINER_INDEXED_BLOCK, {::yampi::datatype_registry_detail::integer_of(blocks.length())},
+        {base_datatype.mpi_datatype()}};
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.displacement_begin(), blocks.displacement_end());
+      return find_or_derive(
+        std::move(key),
+        [&base_datatype, &blocks, &environment]() { return ::yampi::datatype{base_datatype, blocks, environment}; });
+    }
+
+# if MPI_VERSION >= 3
+    // MPI_Type_create_hindexed_block
+    template <typename DerivedDatatype>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& base_datatype,
+      ::yampi::heterogeneous_fixed_blocks const& blocks,
+      ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_registry_key key{
+        MPI_COMBINER_HINDEXED_BLOCK, {::yampi::datatype_registry_detail::integer_of(blocks.length())},
+        {base_datatype.mpi_datatype()}};
+      ::yampi::datatype_registry_detail::append(key.integers, blocks.displacement_begin(), blocks.displacement_end());
+      return find_or_derive(
+        std::move(key),
+        [&base_datatype, &blocks, &environment]() { return ::yampi::datatype{base_datatype, blocks, environment}; });
+    }
+# endif // MPI_VERSION >= 3
+
+    // MPI_Type_create_struct
+    template <typename Datatype>
+    ::yampi::datatype const& derive(
+      ::yampi::heterogeneous_typed_flexible_blocks<Datatype> const& typed_blocks,
+      ::yampi::environment const& environment)
+    {
+      ::yampi::datatype_registry_key key{MPI_COMBINER_STRUCT, {}, {}};
+      ::yampi::datatype_registry_detail::append(
+        key.integers, typed_blocks.length_begin(), typed_blocks.length_end());
+      ::yampi::datatype_registry_detail::append(
+        key.integers, typed_blocks.displacement_begin(), typed_blocks.displacement_end());
+      key.datatypes.assign(
+        reinterpret_cast<MPI_Datatype const*>(typed_blocks.datatype_begin()),
+        reinterpret_cast<MPI_Datatype const*>(typed_blocks.datatype_end()));
+      return find_or_derive(
+        std::move(key), [&typed_blocks, &environment]() { return ::yampi::datatype{typed_blocks, environment}; });
+    }
+
+    // MPI_Type_create_subarray
+    template <
+      typename DerivedDatatype,
+      typename ContiguousIterator1, typename ContiguousIterator2,
+      typename ContiguousIterator3>
+    ::yampi::datatype const& derive(
+      ::yampi::datatype_base<DerivedDatatype> const& array_element_datatype,
+      ContiguousIterator1 const array_size_first,
+      ContiguousIterator1 const array_size_last,
+      ContiguousIterator2 const array_subsize_first,
+      ContiguousIterator3 const array_start_index_first,
+      ::yampi::environment const& environment)
+    {
+      auto const num_dimensions = array_size_last - array_size_first;
+      ::yampi::datatype_registry_key key{MPI_COMBINER_SUBARRAY, {}, {array_element_datatype.mpi_datatype()}};
+      ::yampi::datatype_registry_detail::append(key.integers, array_size_first, array_size_last);
+      ::yampi::datatype_registry_detail::append(
+        key.integers, array_subsize_first, array_subsize_first + num_dimensions);
+      ::yampi::datatype_registry_detail::append(
+        key.integers, array_start_index_first, array_start_index_first + num_dimensions);
+      return find_or_derive(
+        std::move(key),
+        [&array_element_datatype, array_size_first, array_size_last, array_subsize_first, array_start_index_first,
+         &environment]()
+        {
+          return ::yampi::datatype{
+            array_element_datatype, array_size_first, array_size_last, array_subsize_first, array_start_index_first,
+            environment};
+        });
+    }
+
+    std::size_t size() const
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return datatypes_.size();
+    }
+
+    std::size_t num_hits() const
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return num_hits_;
+    }
+
+    std::size_t num_misses() const
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return num_misses_;
+    }
+
+    void reset_statistics()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      num_hits_ = 0u;
+      num_misses_ = 0u;
+    }
+
+    // Frees all the datatypes. References returned by derive are invalidated
+    void clear()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      datatypes_.clear();
+    }
+
+   private:
+    // References to the elements of std::unordered_map are stable
+    template <typename Derive>
+    ::yampi::datatype const& find_or_derive(::yampi::datatype_registry_key&& key, Derive derive)
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto const found = datatypes_.find(key);
+      if (found != datatypes_.end())
+      {
+        ++num_hits_;
+        return found->second;
+      }
+
+      ++num_misses_;
+      return datatypes_.emplace(std::move(key), derive()).first->second;
+    }
+  };
+}
+
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef YAMPI_DETAIL_AT_FINALIZE_HPP
+# define YAMPI_DETAIL_AT_FINALIZE_HPP
+
+# include <utility>
+# include <memory>
+
+# include <mpi.h>
+
+
+// Hooks called at MPI_Finalize.
+//
+// ::yampi::detail::at_finalize(function) makes MPI_Finalize call function() before it does anything else, by setting
+// an attribute of MPI_COMM_SELF with a keyval of its own. Attributes of MPI_COMM_SELF are deleted at the beginning of
+// MPI_Finalize in the reverse order of their settings, so hooks registered later are called earlier, and MPI is still
+// usable in the hooks. Returns the error code of MPI.
+//
+// If function throws, MPI_Finalize gets MPI_ERR_OTHER.
+namespace yampi
+{
+  namespace detail
+  {
+    namespace at_finalize_detail
+    {
+      template <typename Function>
+      inline int delete_attribute(MPI_Comm, int keyval, void* attribute, void*)
+      {
+        std::unique_ptr<Function> function_ptr{static_cast<Function*>(attribute)};
+        auto result = MPI_SUCCESS;
+        try
+        {
+          (*function_ptr)();
+        }
+        catch (...)
+        {
+          result = MPI_ERR_OTHER;
+        }
+
+        MPI_Comm_free_keyval(std::addressof(keyval));
+        return result;
+      }
+    } // namespace at_finalize_detail
+
+    template <typename Function>
+    inline int at_finalize(Function function)
+    {
+      int keyval = MPI_KEYVAL_INVALID;
+      auto error_code
+        = MPI_Comm_create_keyval(
+            MPI_COMM_NULL_COPY_FN, &::yampi::detail::at_finalize_detail::delete_attribute<Function>,
+            std::addressof(keyval), nullptr);
+      if (error_code != MPI_SUCCESS)
+        return error_code;
+
+      std::unique_ptr<Function> function_ptr{new Function(std::move(function))};
+      error_code = MPI_Comm_set_attr(MPI_COMM_SELF, keyval, function_ptr.get());
+      if (error_code != MPI_SUCCESS)
+      {
+        MPI_Comm_free_keyval(std::addressof(keyval));
+        return error_code;
+      }
+
+      function_ptr.release();
+      return MPI_SUCCESS;
+    }
+  }
+}
+
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef YAMPI_DETAIL_RESTRICT_HPP
+# define YAMPI_DETAIL_RESTRICT_HPP
+
+
+// YAMPI_RESTRICT qualifies pointers which do not alias within the function, so that the compiler can vectorize loops
+// over them. It expands to nothing on compilers without __restrict. It is not undefined at the end of the headers
+// using it, since the include guard would keep it from being defined again.
+# if defined(__GNUC__) or defined(_MSC_VER)
+#   define YAMPI_RESTRICT __restrict
+# else
+#   define YAMPI_RESTRICT
+# endif
+
+
+#endif
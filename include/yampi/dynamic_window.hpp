@@ -12,6 +12,8 @@
 # include <yampi/window_base.hpp>
 # include <yampi/communicator.hpp>
 # include <yampi/information.hpp>
+# include <yampi/byte_displacement.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -22,8 +24,6 @@ namespace yampi
   {
     typedef ::yampi::window_base< ::yampi::dynamic_window > base_type;
 
-    MPI_Win mpi_win_;
-
    public:
     dynamic_window() = default;
     dynamic_window(dynamic_window const&) = delete;
@@ -42,11 +42,27 @@ namespace yampi
       : base_type{create(information.mpi_info(), communicator, environment)}
     { }
 
+    // The target displacement of attached memory is its address, ::yampi::addressof(*ptr, environment)
+    void attach(void* ptr, ::yampi::byte_displacement const num_bytes, ::yampi::environment const& environment) const
+    {
+      auto const error_code = MPI_Win_attach(mpi_win_, ptr, num_bytes.mpi_byte_displacement());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::dynamic_window::attach", environment};
+    }
+
+    void detach(void const* ptr, ::yampi::environment const& environment) const
+    {
+      auto const error_code = MPI_Win_detach(mpi_win_, ptr);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::dynamic_window::detach", environment};
+    }
+
    private:
     MPI_Win create(
       MPI_Info const& mpi_info,
       ::yampi::communicator const& communicator, ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::dynamic_window::create", 0u);
       MPI_Win result;
       int const error_code
         = MPI_Win_create_dynamic(mpi_info, communicator.mpi_comm(), std::addressof(result));
@@ -59,7 +75,7 @@ namespace yampi
     friend base_type;
 
     void do_reset(dynamic_window&& other, ::yampi::environment const& environment) { }
-    void do_swap(window& other) noexcept { }
+    void do_swap(dynamic_window& other) noexcept { }
   };
 }
 # endif // MPI_VERSION >= 3
@@ -78,7 +78,7 @@ namespace yampi
         pointer result;
         int const error_code1
           = MPI_Alloc_mem(static_cast<MPI_Aint>(n) * static_cast<MPI_Aint>(sizeof(T)), MPI_INFO_NULL, &result);
-        if (error_code1 == MPI_SUCCESS)
+        if (error_code1 != MPI_SUCCESS)
           throw ::yampi::allocate_error(error_code1);
 
         int const error_code2
@@ -148,7 +148,7 @@ namespace yampi
 
 
   template <typename T, bool uses_special_memory = true>
-  class dynamic_window_allocator<T, uses_special_memory>
+  class dynamic_window_allocator
   {
     ::yampi::dynamic_window* window_ptr_;
 
@@ -167,7 +167,7 @@ namespace yampi
 
     template <typename U>
     struct rebind
-    { typedef dynamic_window_allocator<U> other; };
+    { typedef dynamic_window_allocator<U, uses_special_memory> other; };
 
     dynamic_window_allocator()
       : window_ptr_{nullptr}
@@ -199,7 +199,7 @@ namespace yampi
     bool operator==(dynamic_window_allocator<U, uses_special_memory> const& other) const noexcept
     { return window_ptr_ == std::addressof(other.window()); }
 
-    ::yampi::dynamic_window const& window() const { return *window_ptr_; }
+    ::yampi::dynamic_window& window() const { return *window_ptr_; }
 
 
     pointer address(reference x) const { return std::addressof(x); }
@@ -238,13 +238,13 @@ namespace yampi
     constexpr bool operator==(dynamic_window_allocator const&) const noexcept
     { return true; }
 
-    template <typename T, uses_special_memory>
+    template <typename T>
     constexpr bool operator==(dynamic_window_allocator<T, uses_special_memory> const&) const noexcept
     { return true; }
 
     template <typename U>
     struct rebind
-    { typedef allocator<U> other; };
+    { typedef dynamic_window_allocator<U, uses_special_memory> other; };
   };
 
   template <typename T, typename U, bool uses_special_memory>
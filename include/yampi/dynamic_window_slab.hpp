@@ -0,0 +1,306 @@
+#ifndef YAMPI_DYNAMIC_WINDOW_SLAB_HPP
+# define YAMPI_DYNAMIC_WINDOW_SLAB_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <limits>
+# include <type_traits>
+# include <algorithm>
+# include <array>
+# include <vector>
+# include <memory>
+# include <utility>
+
+# include <mpi.h>
+
+# include <yampi/dynamic_window.hpp>
+# include <yampi/allocator.hpp> // allocate_error, deallocate_error
+# include <yampi/communicator_base.hpp>
+# include <yampi/address.hpp>
+# include <yampi/addressof.hpp>
+# include <yampi/byte_displacement.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+
+
+// Sub-allocator over a dynamic window.
+//
+// ::yampi::dynamic_window_slab allocates memory in large chunks with MPI_Alloc_mem, attaches each chunk to the window
+// once, and carves objects out of the chunks with power-of-two size classes. Deallocated objects are kept in free lists
+// of their size classes; chunks are detached only when the slab is destroyed, so addresses of objects (their target
+// displacements in the window) stay valid while they are allocated. Objects larger than a chunk get chunks of their own,
+// which are detached when the objects are deallocated.
+//
+// The window must outlive the slab. If the window has been freed (or moved from) before the slab is destroyed, the
+// chunks are only freed, because MPI_Win_free has implicitly detached them.
+//
+// ::yampi::dynamic_window_slab_allocator<T> is an allocator over a slab, for containers of remotely accessible objects.
+// Neither is thread-safe.
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  class dynamic_window_slab
+  {
+   public:
+    static constexpr std::size_t default_chunk_size = std::size_t{1u} << 20u;
+    static constexpr std::size_t min_object_size = std::size_t{1u} << 4u;
+
+   private:
+    static constexpr std::size_t num_size_classes = std::numeric_limits<std::size_t>::digits;
+
+    struct chunk
+    {
+      char* data;
+      std::size_t size;
+      bool is_dedicated;
+    };
+
+    ::yampi::dynamic_window* window_ptr_;
+    std::size_t chunk_size_;
+    std::vector<chunk> chunks_;
+    // chunks_.back() is carved from num_carved_bytes_ on, unless it is a dedicated chunk of a large object. Dedicated
+    // chunks are inserted in front of chunks_.back() if it is a shared chunk
+    std::size_t num_carved_bytes_;
+    std::array<std::vector<void*>, num_size_classes> free_lists_;
+    ::yampi::environment const* environment_ptr_;
+
+   public:
+    dynamic_window_slab(::yampi::dynamic_window& window, ::yampi::environment const& environment)
+      : dynamic_window_slab{window, default_chunk_size, environment}
+    { }
+
+    dynamic_window_slab(
+      ::yampi::dynamic_window& window, std::size_t const chunk_size, ::yampi::environment const& environment)
+      : window_ptr_{std::addressof(window)},
+        chunk_size_{std::max(size_of(size_class_of(chunk_size)), std::size_t{min_object_size})},
+        chunks_{}, num_carved_bytes_{0u}, free_lists_{}, environment_ptr_{std::addressof(environment)}
+    { }
+
+    ~dynamic_window_slab() noexcept
+    {
+      auto const is_window_alive = not window_ptr_->is_null();
+      for (auto const& chunk: chunks_)
+      {
+        if (is_window_alive)
+          MPI_Win_detach(window_ptr_->mpi_win(), chunk.data);
+        MPI_Free_mem(chunk.data);
+      }
+    }
+
+    dynamic_window_slab(dynamic_window_slab const&) = delete;
+    dynamic_window_slab& operator=(dynamic_window_slab const&) = delete;
+    dynamic_window_slab(dynamic_window_slab&&) = delete;
+    dynamic_window_slab& operator=(dynamic_window_slab&&) = delete;
+
+    ::yampi::dynamic_window& window() const noexcept { return *window_ptr_; }
+    std::size_t chunk_size() const noexcept { return chunk_size_; }
+
+    // Offsets of objects in chunks are multiples of their size classes, so objects are aligned as the chunks
+    // (by MPI_Alloc_mem) up to their size classes
+    void* allocate(std::size_t const num_bytes)
+    {
+      auto const size_class = size_class_of(std::max(num_bytes, std::size_t{min_object_size}));
+      auto const object_size = size_of(size_class);
+      if (object_size > chunk_size_)
+        return add_chunk(num_bytes, true).data;
+
+      auto& free_list = free_lists_[size_class];
+      if (not free_list.empty())
+      {
+        auto const result = free_list.back();
+        free_list.pop_back();
+        return result;
+      }
+
+      auto const offset = (num_carved_bytes_ + object_size - 1u) / object_size * object_size;
+      if (chunks_.empty() or chunks_.back().is_dedicated or offset + object_size > chunk_size_)
+      {
+        add_chunk(chunk_size_, false);
+        num_carved_bytes_ = object_size;
+        return chunks_.back().data;
+      }
+
+      num_carved_bytes_ = offset + object_size;
+      return chunks_.back().data + offset;
+    }
+
+    // num_bytes must be the same as that passed to allocate
+    void deallocate(void* ptr, std::size_t const num_bytes)
+    {
+      auto const size_class = size_class_of(std::max(num_bytes, std::size_t{min_object_size}));
+      if (size_of(size_class) <= chunk_size_)
+      {
+        free_lists_[size_class].push_back(ptr);
+        return;
+      }
+
+      auto const found
+        = std::find_if(chunks_.begin(), chunks_.end(), [ptr](chunk const& chunk) { return chunk.data == ptr; });
+      assert(found != chunks_.end());
+      auto const data = found->data;
+      // the chunk stays registered if detach throws
+      window_ptr_->detach(data, *environment_ptr_);
+      chunks_.erase(found);
+
+      auto const error_code = MPI_Free_mem(data);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::deallocate_error(error_code);
+    }
+
+    // Base addresses of the attached chunks, in the order of attachment
+    std::vector< ::yampi::address > chunk_addresses(::yampi::environment const& environment) const
+    {
+      std::vector< ::yampi::address > result;
+      result.reserve(chunks_.size());
+      for (auto const& chunk: chunks_)
+        result.push_back(::yampi::addressof(*chunk.data, environment));
+      return result;
+    }
+
+    // Collective over communicator. Returns chunk_addresses() of every process, indexed by rank, so that peers can
+    // check that remote addresses fall in attached memory. Only chunks attached before the call are published
+    std::vector<std::vector< ::yampi::address > > publish(
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment) const
+    {
+      std::vector<MPI_Aint> local_addresses;
+      local_addresses.reserve(chunks_.size());
+      for (auto const& address: chunk_addresses(environment))
+        local_addresses.push_back(address.mpi_address());
+
+      auto const size = communicator.size(environment);
+      std::vector<int> counts(size);
+      auto const count = static_cast<int>(local_addresses.size());
+      auto error_code
+        = MPI_Allgather(std::addressof(count), 1, MPI_INT, counts.data(), 1, MPI_INT, communicator.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::dynamic_window_slab::publish", environment};
+
+      std::vector<int> displacements(size);
+      auto total_count = 0;
+      for (auto rank = 0; rank < size; ++rank)
+      {
+        displacements[rank] = total_count;
+        total_count += counts[rank];
+      }
+
+      std::vector<MPI_Aint> all_addresses(total_count);
+      error_code
+        = MPI_Allgatherv(
+            local_addresses.data(), count, MPI_AINT,
+            all_addresses.data(), counts.data(), displacements.data(), MPI_AINT, communicator.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::dynamic_window_slab::publish", environment};
+
+      std::vector<std::vector< ::yampi::address > > result(size);
+      for (auto rank = 0; rank < size; ++rank)
+        for (auto index = displacements[rank]; index < displacements[rank] + counts[rank]; ++index)
+          result[rank].emplace_back(all_addresses[index]);
+      return result;
+    }
+
+   private:
+    static std::size_t size_class_of(std::size_t const num_bytes) noexcept
+    {
+      auto result = std::size_t{0u};
+      while (result + 1u < num_size_classes and size_of(result) < num_bytes)
+        ++result;
+      return result;
+    }
+
+    static constexpr std::size_t size_of(std::size_t const size_class) noexcept
+    { return std::size_t{1u} << size_class; }
+
+    chunk& add_chunk(std::size_t const num_bytes, bool const is_dedicated)
+    {
+      char* data;
+      auto const error_code = MPI_Alloc_mem(static_cast<MPI_Aint>(num_bytes), MPI_INFO_NULL, std::addressof(data));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::allocate_error(error_code);
+
+      try
+      {
+        window_ptr_->attach(data, ::yampi::byte_displacement{static_cast<MPI_Aint>(num_bytes)}, *environment_ptr_);
+        // dedicated chunks go in front of the shared chunk being carved
+        auto const position
+          = is_dedicated and not chunks_.empty() and not chunks_.back().is_dedicated
+            ? std::prev(chunks_.end()) : chunks_.end();
+        return *chunks_.insert(position, chunk{data, num_bytes, is_dedicated});
+      }
+      catch (...)
+      {
+        MPI_Free_mem(data);
+        throw;
+      }
+    }
+  };
+
+  template <typename T>
+  class dynamic_window_slab_allocator
+  {
+    ::yampi::dynamic_window_slab* slab_ptr_;
+
+   public:
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef void* void_pointer;
+    typedef void const* const_void_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template <typename U>
+    struct rebind
+    { typedef dynamic_window_slab_allocator<U> other; };
+
+    explicit dynamic_window_slab_allocator(::yampi::dynamic_window_slab& slab) noexcept
+      : slab_ptr_{std::addressof(slab)}
+    { }
+
+    template <typename U>
+    dynamic_window_slab_allocator(dynamic_window_slab_allocator<U> const& other) noexcept
+      : slab_ptr_{std::addressof(other.slab())}
+    { }
+
+    ::yampi::dynamic_window_slab& slab() const noexcept { return *slab_ptr_; }
+
+    pointer address(reference x) const { return std::addressof(x); }
+    const_pointer address(const_reference x) const { return std::addressof(x); }
+
+    pointer allocate(std::size_t const n, const_void_pointer = nullptr)
+    { return static_cast<pointer>(slab_ptr_->allocate(n * sizeof(T))); }
+
+    void deallocate(pointer ptr, std::size_t const n)
+    { slab_ptr_->deallocate(ptr, n * sizeof(T)); }
+
+    size_type max_size() const noexcept
+    { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    template <typename U, typename... Arguments>
+    void construct(U* ptr, Arguments&&... arguments)
+    { ::new((void *)ptr) U(std::forward<Arguments>(arguments)...); }
+
+    template <typename U>
+    void destroy(U* ptr) { ptr->~U(); }
+  };
+
+  template <typename T, typename U>
+  inline bool operator==(
+    ::yampi::dynamic_window_slab_allocator<T> const& lhs, ::yampi::dynamic_window_slab_allocator<U> const& rhs) noexcept
+  { return std::addressof(lhs.slab()) == std::addressof(rhs.slab()); }
+
+  template <typename T, typename U>
+  inline bool operator!=(
+    ::yampi::dynamic_window_slab_allocator<T> const& lhs, ::yampi::dynamic_window_slab_allocator<U> const& rhs) noexcept
+  { return not (lhs == rhs); }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -16,6 +16,7 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -31,13 +32,14 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -50,14 +52,14 @@ namespace yampi
     auto const error_code
       = MPI_Exscan(
           send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Exscan(
           const_cast<value_type*>(send_buffer.data()), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -73,7 +75,7 @@ namespace yampi
 # if MPI_VERSION >= 4
     assert(send_buffer.count().mpi_count() == 1);
 # else // MPI_VERSION >= 4
-    assert(send_buffer.count() == 1);
+    assert(send_buffer.large_count() == 1);
 # endif // MPI_VERSION >= 4
 
     typename std::remove_cv<SendValue>::type result;
@@ -87,6 +89,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Exscan_c(
@@ -95,7 +98,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Exscan(
-          MPI_IN_PLACE, buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          MPI_IN_PLACE, buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -110,13 +113,14 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -130,7 +134,7 @@ namespace yampi
     auto const error_code
       = MPI_Iexscan(
           send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -145,6 +149,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -154,7 +159,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iexscan(
-          MPI_IN_PLACE, buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          MPI_IN_PLACE, buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -171,6 +176,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -194,6 +200,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Exscan_init_c(
@@ -212,6 +219,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -235,6 +243,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::exclusive_scan", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Exscan_init_c(
@@ -11,6 +11,7 @@
 # include <yampi/assertion_mode.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -19,20 +20,20 @@ namespace yampi
     : public std::runtime_error
   {
    public:
-    unexpected_exposure_status_error()
+    explicit unexpected_exposure_status_error(::yampi::environment const&)
       : std::runtime_error{"Error occurred because of strange exposure member variables"}
     { }
   };
 
 
   struct defer_exposure_t { };
-  struct adapt_exposure_t { };
+  struct adopt_exposure_t { };
 # if __cplusplus >= 201703L
   inline constexpr ::yampi::defer_exposure_t defer_exposure{};
-  inline constexpr ::yampi::adapt_exposure_t adapt_exposure{};
+  inline constexpr ::yampi::adopt_exposure_t adopt_exposure{};
 # else
   constexpr ::yampi::defer_exposure_t defer_exposure{};
-  constexpr ::yampi::adapt_exposure_t adapt_exposure{};
+  constexpr ::yampi::adopt_exposure_t adopt_exposure{};
 # endif
 
   template <typename Window>
@@ -44,25 +45,36 @@ namespace yampi
     exposure_guard(exposure_guard const&) = delete;
     exposure_guard& operator=(exposure_guard const&) = delete;
 
-    ~exposure_guard() noexcept { MPI_Win_wait(window_.mpi_win()); }
+    ~exposure_guard() noexcept
+    {
+      MPI_Win_wait(window_.mpi_win());
+      YAMPI_PROFILE_END("yampi::exposure_guard");
+    }
 
     exposure_guard(::yampi::group const& group, ::yampi::window_base<Window>& window, ::yampi::environment const& environment)
       : window_{window}
-    { do_post(group, 0, environment); }
+    {
+      do_post(group, 0, environment);
+      YAMPI_PROFILE_BEGIN("yampi::exposure_guard");
+    }
 
     exposure_guard(
       ::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::window_base<Window>& window,
       ::yampi::environment const& environment)
       : window_{window}
-    { do_post(group, static_assert<int>(assertion), environment); }
+    {
+      do_post(group, static_cast<int>(assertion), environment);
+      YAMPI_PROFILE_BEGIN("yampi::exposure_guard");
+    }
 
     exposure_guard(::yampi::window_base<Window>& window, ::yampi::adopt_exposure_t const)
       : window_{window}
-    { }
+    { YAMPI_PROFILE_BEGIN("yampi::exposure_guard"); }
 
    private:
-    void do_post(::yampi::group const& group, int const assertion, ::yampi::environment const& environment) const
+    void do_post(::yampi::group const& group, int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::exposure_guard::do_post", 0u);
       int const error_code
         = MPI_Win_post(group.mpi_group(), assertion, window_.mpi_win());
       if (error_code != MPI_SUCCESS)
@@ -126,15 +138,16 @@ namespace yampi
       : window_ptr_{std::addressof(window)}, owns_{true}
     { }
 
-    void post(::yampi::group const& group, ::yampi::environment const& environment) const
+    void post(::yampi::group const& group, ::yampi::environment const& environment)
     { do_post(group, 0, environment); }
 
-    void post(::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::environment const& environment) const
+    void post(::yampi::group const& group, ::yampi::assertion_mode const assertion, ::yampi::environment const& environment)
     { do_post(group, static_cast<int>(assertion), environment); }
 
    private:
-    void do_post(::yampi::group const& group, int const assertion, ::yampi::environment const& environment) const
+    void do_post(::yampi::group const& group, int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::exposure::do_post", 0u);
       if (owns_)
         throw ::yampi::unexpected_exposure_status_error(environment);
 
@@ -145,8 +158,9 @@ namespace yampi
     }
 
    public:
-    void wait(::yampi::environment const& environment) const
+    void wait(::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::exposure::wait", 0u);
       if (not owns_)
         throw ::yampi::unexpected_exposure_status_error(environment);
 
@@ -156,7 +170,7 @@ namespace yampi
       owns_ = false;
     }
 
-    bool test(::yampi::environment const& environment) const
+    bool test(::yampi::environment const& environment)
     {
       if (not owns_)
         throw ::yampi::unexpected_exposure_status_error(environment);
@@ -172,7 +186,7 @@ namespace yampi
       return static_cast<bool>(result);
     }
 
-    void swap(exposure& other) noexcept
+    void swap(unique_exposure& other) noexcept
     {
       using std::swap;
       swap(window_ptr_, other.window_ptr_);
@@ -184,7 +198,7 @@ namespace yampi
   };
 
   template <typename Window>
-  inline void swap(::yampi::exposure<Window>& lhs, ::yampi::exposure<Window>& rhs) noexcept
+  inline void swap(::yampi::unique_exposure<Window>& lhs, ::yampi::unique_exposure<Window>& rhs) noexcept
   { lhs.swap(rhs); }
 }
 
@@ -7,6 +7,7 @@
 # include <yampi/assertion_mode.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -16,6 +17,7 @@ namespace yampi
     template <typename Derived>
     inline void fence(int const assertion, ::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::yampi_fence_detail::fence", 0u);
       int const error_code = MPI_Win_fence(assertion, window.mpi_win());
       if (error_code != MPI_SUCCESS)
         throw ::yampi::error(error_code, "yampi::yampi_fence_detail::fence", environment);
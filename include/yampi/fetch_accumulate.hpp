@@ -14,6 +14,7 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -27,6 +28,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::fetch_accumulate", ::yampi::profiler::num_bytes(origin_buffer, environment));
     assert(origin_buffer.data() != result_buffer.data());
 
 # if MPI_VERSION >= 4
@@ -39,9 +41,9 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Get_accumulate(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          result_buffer.data(), result_buffer.count(), result_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_buffer.count(environment), origin_buffer.datatype().mpi_datatype(),
+          result_buffer.data(), result_buffer.count(environment), result_buffer.datatype().mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(environment), target_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), window.mpi_win());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -58,6 +60,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::fetch_accumulate", ::yampi::profiler::num_bytes(origin_buffer, environment));
     assert(origin_buffer.data() != result_buffer.data());
 
     MPI_Request mpi_request;
@@ -71,9 +74,9 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Rget_accumulate(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          result_buffer.data(), result_buffer.count(), result_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_buffer.count(environment), origin_buffer.datatype().mpi_datatype(),
+          result_buffer.data(), result_buffer.count(environment), result_buffer.datatype().mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(environment), target_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), window.mpi_win(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -15,6 +15,7 @@
 # include <yampi/displacement.hpp>
 # include <yampi/binary_operation.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -29,11 +30,12 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::fetch_operate", 0u);
     assert(std::addressof(origin_value) != std::addressof(result_value));
 
     int const error_code
       = MPI_Fetch_and_op(
-          std::addressof(origin_value), std::addressof(result_value), ::yampi::predefined_datatype<Value>(),
+          std::addressof(origin_value), std::addressof(result_value), ::yampi::predefined_datatype<Value>().mpi_datatype(),
           target.mpi_rank(), target_displacement.mpi_displacement(),
           operation.mpi_op(), window.mpi_win());
     if (error_code != MPI_SUCCESS)
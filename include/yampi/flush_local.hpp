@@ -7,6 +7,7 @@
 # include <yampi/rank.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -15,6 +16,7 @@ namespace yampi
   template <typename Derived>
   inline void flush_local(::yampi::rank const rank, ::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::flush_local", 0u);
     int const error_code = MPI_Win_flush_local(rank.mpi_rank(), window.mpi_win());
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error(error_code, "yampi::flush_local", environment);
@@ -23,6 +25,7 @@ namespace yampi
   template <typename Derived>
   inline void flush_local(::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::flush_local", 0u);
     int const error_code = MPI_Win_flush_local_all(window.mpi_win());
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error(error_code, "yampi::flush_local", environment);
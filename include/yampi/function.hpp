@@ -0,0 +1,71 @@
+#ifndef YAMPI_FUNCTION_HPP
+# define YAMPI_FUNCTION_HPP
+
+# include <type_traits>
+# include <new>
+
+# include <mpi.h>
+
+# include <yampi/detail/restrict.hpp>
+
+
+// Binary functions over typed elements for user-defined operations.
+//
+// ::yampi::function<Value, Function, is_commutative> wraps a callable so that ::yampi::binary_operation can be built
+// from it. call is the MPI user function, generated for each Value and Function, and applies the callable to each pair
+// of elements as inout[i] = function(in[i], inout[i]) in a loop the compiler can vectorize
+//
+//   ::yampi::binary_operation operation{
+//     ::yampi::make_function<double>([](double const lhs, double const rhs) { return std::max(std::abs(lhs), std::abs(rhs)); }),
+//     environment};
+//
+// MPI passes no context to user functions, so Function must be stateless (e.g. a lambda without captures). Elements of
+// lower ranks are given as lhs if the operation is not commutative. Buffers reduced with the operation must consist of
+// Value's, i.e. their datatypes must have the extent sizeof(Value).
+namespace yampi
+{
+  template <typename Value, typename Function, bool is_commutative = true>
+  class function
+  {
+    static_assert(
+      std::is_empty<Function>::value and std::is_trivially_copyable<Function>::value,
+      "Function must be stateless");
+
+    // Closure types of lambdas aren't default constructible before C++20, so a copy is kept for call
+    static unsigned char* storage() noexcept
+    {
+      alignas(Function) static unsigned char result[sizeof(Function)];
+      return result;
+    }
+
+   public:
+    static constexpr bool commutative = is_commutative;
+
+    explicit function(Function const& function) noexcept
+    { ::new(static_cast<void*>(storage())) Function(function); }
+
+# if MPI_VERSION >= 4
+    static void call(void* in, void* inout, MPI_Count* length, MPI_Datatype*)
+# else // MPI_VERSION >= 4
+    static void call(void* in, void* inout, int* length, MPI_Datatype*)
+# endif // MPI_VERSION >= 4
+    { apply(static_cast<Value const*>(in), static_cast<Value*>(inout), *length); }
+
+   private:
+    // in and inout never overlap in MPI user functions
+    template <typename Size>
+    static void apply(Value const* YAMPI_RESTRICT in, Value* YAMPI_RESTRICT inout, Size const num_elements)
+    {
+      auto const function = *reinterpret_cast<Function const*>(storage());
+      for (auto index = Size{0}; index < num_elements; ++index)
+        inout[index] = function(in[index], inout[index]);
+    }
+  };
+
+  template <typename Value, bool is_commutative = true, typename Function>
+  inline ::yampi::function<Value, Function, is_commutative> make_function(Function const& function) noexcept
+  { return ::yampi::function<Value, Function, is_commutative>{function}; }
+}
+
+
+#endif
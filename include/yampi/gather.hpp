@@ -18,6 +18,8 @@
 # include <yampi/nonroot_call_on_root_error.hpp>
 # include <yampi/root_call_on_nonroot_error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -33,13 +35,15 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -51,15 +55,15 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -71,15 +75,17 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -90,14 +96,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -110,6 +116,8 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::gather"};
 
@@ -122,14 +130,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -143,12 +151,14 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::gather"};
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -173,6 +183,8 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gather_c(
@@ -182,14 +194,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gather(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -202,9 +214,11 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -226,6 +240,8 @@ namespace yampi
   template <typename ReceiveValue>
   inline void gather(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::gather", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::gather", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gather_c(
@@ -249,13 +265,14 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() * communicator.size(environment) <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() * communicator.size(environment) <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() * communicator.size(environment) <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -268,8 +285,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          std::addressof(*first), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -283,15 +300,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -303,7 +321,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_count, receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -318,6 +336,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::gather"};
 
@@ -331,7 +350,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -347,12 +366,13 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::gather"};
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -380,6 +400,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -390,7 +411,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igather(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, 0, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -405,9 +426,10 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -433,6 +455,7 @@ namespace yampi
     ::yampi::immediate_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -460,6 +483,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -483,11 +507,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -506,6 +531,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::gather"};
 
@@ -527,12 +553,13 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::gather"};
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -552,6 +579,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gather_init_c(
@@ -569,9 +597,10 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -589,6 +618,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gather_init_c(
@@ -607,6 +637,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ContiguousIterator const first, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -629,11 +660,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -652,6 +684,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::gather"};
 
@@ -673,12 +706,13 @@ namespace yampi
     ::yampi::buffer<Value> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::gather"};
 
     auto const size = communicator.size(environment);
-    auto const receive_count = receive_buffer.count() / size;
-    assert(receive_count * size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / size;
+    assert(receive_count * size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -698,6 +732,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gather_init_c(
@@ -714,9 +749,10 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", ::yampi::profiler::num_bytes(receive_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const receive_count = receive_buffer.count() / remote_size;
-    assert(receive_count * remote_size == receive_buffer.count());
+    auto const receive_count = receive_buffer.count(environment) / remote_size;
+    assert(receive_count * remote_size == receive_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -734,6 +770,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gather_init_c(
@@ -12,6 +12,9 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/communication_matrix.hpp>
+# include <yampi/large_count.hpp>
 
 
 namespace yampi
@@ -22,6 +25,8 @@ namespace yampi
     ::yampi::rank const target, ::yampi::target_buffer<TargetValue> const target_buffer,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::get", ::yampi::profiler::num_bytes(origin_buffer, environment));
+    YAMPI_RECORD_GET(window, target, ::yampi::profiler::num_bytes(origin_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Get_c(
@@ -29,10 +34,12 @@ namespace yampi
           target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count().mpi_count(), target_buffer.datatype().mpi_datatype(),
           window.mpi_win());
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const origin_arguments{origin_buffer, environment};
+    ::yampi::large_count_detail::count_and_datatype const target_arguments{target_buffer, environment};
     auto const error_code
       = MPI_Get(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_arguments.count(), origin_arguments.mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_arguments.count(), target_arguments.mpi_datatype(),
           window.mpi_win());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -47,6 +54,8 @@ namespace yampi
     ::yampi::rank const target, ::yampi::target_buffer<TargetValue> const target_buffer,
     ::yampi::window_base<Window> const& window, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::get", ::yampi::profiler::num_bytes(origin_buffer, environment));
+    YAMPI_RECORD_GET(window, target, ::yampi::profiler::num_bytes(origin_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -55,10 +64,12 @@ namespace yampi
           target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count().mpi_count(), target_buffer.datatype().mpi_datatype(),
           window.mpi_win(), std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const origin_arguments{origin_buffer, environment};
+    ::yampi::large_count_detail::count_and_datatype const target_arguments{target_buffer, environment};
     auto const error_code
       = MPI_Rget(
-          origin_buffer.data(), origin_buffer.count(), origin_buffer.datatype().mpi_datatype(),
-          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_buffer.count(), target_buffer.datatype().mpi_datatype(),
+          origin_buffer.data(), origin_arguments.count(), origin_arguments.mpi_datatype(),
+          target.mpi_rank(), target_buffer.displacement().mpi_displacement(), target_arguments.count(), target_arguments.mpi_datatype(),
           window.mpi_win(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
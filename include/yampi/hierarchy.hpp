@@ -0,0 +1,365 @@
+#ifndef YAMPI_HIERARCHY_HPP
+# define YAMPI_HIERARCHY_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <algorithm>
+# include <vector>
+# include <memory>
+# include <utility>
+# include <type_traits>
+
+# include <mpi.h>
+
+# include <yampi/communicator.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/group.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/color.hpp>
+# include <yampi/split_type.hpp>
+# include <yampi/window_array.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/synchronize.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+
+
+// Node-aware communicators.
+//
+// ::yampi::hierarchy splits a communicator (the parent) into node communicators, one for each shared-memory node (or
+// each color), and a leader communicator of the lowest-ranked process of each node. Nodes are indexed by the ranks of
+// their leaders in the leader communicator, in the order of the parent ranks of the leaders. Processes keep their
+// relative order of the parent in node communicators. Ranks in the node communicator of the calling process and in the
+// leader communicator are translated to those in the parent without communication.
+//
+// Construction is collective over the parent; build a hierarchy once and reuse it. The hierarchy keeps a duplicate of
+// the parent, so the parent may be freed before the hierarchy.
+//
+// Passing a hierarchy instead of a communicator to ::yampi::all_reduce, ::yampi::broadcast and ::yampi::all_gather
+// selects two-level algorithms: processes on a node combine their data in a window on shared memory, and only leaders
+// communicate across nodes. Messages smaller than threshold_bytes() (0 by default), buffers of datatypes with gaps or
+// nonzero lower bounds, and hierarchies with one process on each node fall back to the flat algorithms over parent().
+// The datatypes must have the same layout on all processes, so that all of them take the same path. all_reduce with
+// noncommutative operations also falls back unless is_blocked_by_node().
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  class hierarchy
+  {
+    ::yampi::communicator parent_communicator_;
+    ::yampi::communicator node_communicator_;
+    // null in non-leaders
+    ::yampi::communicator leader_communicator_;
+    int node_index_;
+    // node rank -> parent rank, for the node of the calling process
+    std::vector< ::yampi::rank > node_to_parent_;
+    // parent rank -> node rank, MPI_UNDEFINED for processes on the other nodes
+    std::vector< ::yampi::rank > parent_to_node_;
+    // node index -> parent rank of the leader
+    std::vector< ::yampi::rank > leaders_;
+    // node index -> number of processes on the node
+    std::vector<int> node_sizes_;
+    // parent ranks ordered by node index, then by node rank
+    std::vector< ::yampi::rank > ranks_by_node_;
+    // parent rank -> node index
+    std::vector<int> node_indices_;
+    // ranks_by_node_ is the identity
+    bool is_blocked_by_node_;
+    std::size_t threshold_bytes_;
+
+    // scratch of two-level algorithms, allocated by node rank 0 and always in a passive target epoch
+    ::yampi::window_array<char, true> shared_window_;
+    char* shared_data_;
+    std::size_t shared_capacity_;
+    // offset of the output of the previous operation
+    std::size_t output_first_;
+
+   public:
+    hierarchy(::yampi::communicator_base const& parent, ::yampi::environment const& environment)
+      : hierarchy{
+          parent,
+          ::yampi::communicator{
+            parent, ::yampi::shared_memory_split_type, parent.rank(environment).mpi_rank(), environment},
+          environment}
+    { }
+
+    // Processes of the same color are on the same "node", e.g. for sockets or for testing
+    hierarchy(
+      ::yampi::communicator_base const& parent, ::yampi::color const color, ::yampi::environment const& environment)
+      : hierarchy{
+          parent, ::yampi::communicator{parent, color, parent.rank(environment).mpi_rank(), environment},
+          environment}
+    { }
+
+   private:
+    hierarchy(
+      ::yampi::communicator_base const& parent, ::yampi::communicator&& node_communicator,
+      ::yampi::environment const& environment)
+      : parent_communicator_{parent, environment},
+        node_communicator_{std::move(node_communicator)},
+        leader_communicator_{
+          parent,
+          node_communicator_.rank(environment) == ::yampi::rank{0} ? ::yampi::color{0} : ::yampi::undefined_color,
+          parent.rank(environment).mpi_rank(), environment},
+        node_index_{0}, node_to_parent_{}, parent_to_node_{}, leaders_{}, node_sizes_{},
+        ranks_by_node_{}, node_indices_{}, is_blocked_by_node_{true}, threshold_bytes_{0u},
+        shared_window_{}, shared_data_{nullptr}, shared_capacity_{0u}, output_first_{0u}
+    {
+      ::yampi::group parent_group;
+      parent.group(parent_group, environment);
+      ::yampi::group node_group;
+      node_communicator_.group(node_group, environment);
+
+      auto const node_size = node_communicator_.size(environment);
+      node_to_parent_.resize(node_size);
+      translate(node_group, node_size, parent_group, node_to_parent_, environment);
+
+      auto const parent_size = parent.size(environment);
+      parent_to_node_.resize(parent_size);
+      translate(parent_group, parent_size, node_group, parent_to_node_, environment);
+
+      // leaders_ and ranks_by_node_ are sent as arrays of MPI_INT
+      static_assert(std::is_standard_layout< ::yampi::rank >::value, "yampi::rank must be standard-layout");
+      static_assert(sizeof(::yampi::rank) == sizeof(int), "yampi::rank must have the same size as int");
+
+      // leaders know the node index, the number of nodes, and the leaders, sizes and members of all nodes
+      int num_nodes = 0;
+      ranks_by_node_.resize(parent_size);
+      if (is_leader())
+      {
+        node_index_ = leader_communicator_.rank(environment).mpi_rank();
+        num_nodes = leader_communicator_.size(environment);
+
+        ::yampi::group leader_group;
+        leader_communicator_.group(leader_group, environment);
+        leaders_.resize(num_nodes);
+        translate(leader_group, num_nodes, parent_group, leaders_, environment);
+
+        node_sizes_.resize(num_nodes);
+        auto error_code
+          = MPI_Allgather(
+              std::addressof(node_size), 1, MPI_INT, node_sizes_.data(), 1, MPI_INT, leader_communicator_.mpi_comm());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::hierarchy::hierarchy", environment};
+
+        std::vector<int> displacements(num_nodes);
+        auto total_size = 0;
+        for (auto index = 0; index < num_nodes; ++index)
+        {
+          displacements[index] = total_size;
+          total_size += node_sizes_[index];
+        }
+
+        error_code
+          = MPI_Allgatherv(
+              node_to_parent_.data(), node_size, MPI_INT,
+              ranks_by_node_.data(), node_sizes_.data(), displacements.data(), MPI_INT,
+              leader_communicator_.mpi_comm());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::hierarchy::hierarchy", environment};
+      }
+
+      // ... and tell them to the other processes on the node
+      int header[2] = {node_index_, num_nodes};
+      broadcast_in_node(header, 2, environment);
+      node_index_ = header[0];
+      num_nodes = header[1];
+
+      leaders_.resize(num_nodes);
+      node_sizes_.resize(num_nodes);
+      broadcast_in_node(reinterpret_cast<int*>(leaders_.data()), num_nodes, environment);
+      broadcast_in_node(node_sizes_.data(), num_nodes, environment);
+      broadcast_in_node(reinterpret_cast<int*>(ranks_by_node_.data()), parent_size, environment);
+
+      node_indices_.resize(parent_size);
+      auto position = ranks_by_node_.begin();
+      for (auto index = 0; index < num_nodes; ++index)
+        for (auto const last = position + node_sizes_[index]; position != last; ++position)
+          node_indices_[position->mpi_rank()] = index;
+
+      for (auto rank = 0; rank < parent_size; ++rank)
+        is_blocked_by_node_ = is_blocked_by_node_ and ranks_by_node_[rank].mpi_rank() == rank;
+    }
+
+   public:
+    hierarchy(hierarchy const&) = delete;
+    hierarchy& operator=(hierarchy const&) = delete;
+    hierarchy(hierarchy&&) = default;
+    hierarchy& operator=(hierarchy&&) = delete;
+
+    ~hierarchy() noexcept
+    {
+      if (not shared_window_.is_null())
+        MPI_Win_unlock_all(shared_window_.mpi_win());
+    }
+
+   private:
+    static void translate(
+      ::yampi::group const& old_group, int const size, ::yampi::group const& new_group,
+      std::vector< ::yampi::rank >& result, ::yampi::environment const& environment)
+    {
+      std::vector< ::yampi::rank > old_ranks;
+      old_ranks.reserve(size);
+      for (auto rank = 0; rank < size; ++rank)
+        old_ranks.emplace_back(rank);
+      ::yampi::translate(old_group, old_ranks.begin(), old_ranks.end(), new_group, result.begin(), environment);
+    }
+
+    void broadcast_in_node(int* data, int const count, ::yampi::environment const& environment) const
+    {
+      auto const error_code = MPI_Bcast(data, count, MPI_INT, 0, node_communicator_.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::hierarchy::hierarchy", environment};
+    }
+
+   public:
+    // duplicate of the parent
+    ::yampi::communicator const& parent() const noexcept { return parent_communicator_; }
+    ::yampi::communicator const& node_communicator() const noexcept { return node_communicator_; }
+    ::yampi::communicator const& leader_communicator() const noexcept { return leader_communicator_; }
+
+    bool is_leader() const noexcept { return not leader_communicator_.is_null(); }
+
+    int num_nodes() const noexcept { return static_cast<int>(leaders_.size()); }
+    int node_index() const noexcept { return node_index_; }
+    int node_size() const noexcept { return static_cast<int>(node_to_parent_.size()); }
+    int node_size(int const node_index) const noexcept
+    { assert(node_index >= 0 and node_index < num_nodes()); return node_sizes_[node_index]; }
+    std::vector<int> const& node_sizes() const noexcept { return node_sizes_; }
+    // all nodes have the same number of processes
+    bool is_uniform() const noexcept
+    { return std::all_of(node_sizes_.begin(), node_sizes_.end(), [this](int const size) { return size == node_sizes_.front(); }); }
+
+    // rank in the parent of the process of node_rank on the node of the calling process
+    ::yampi::rank parent_rank(::yampi::rank const node_rank) const noexcept
+    {
+      assert(node_rank.mpi_rank() >= 0 and node_rank.mpi_rank() < node_size());
+      return node_to_parent_[node_rank.mpi_rank()];
+    }
+
+    // rank in the node communicator of the process of parent_rank, or MPI_UNDEFINED if it is on another node
+    ::yampi::rank node_rank(::yampi::rank const parent_rank) const noexcept
+    {
+      assert(parent_rank.mpi_rank() >= 0 and parent_rank.mpi_rank() < static_cast<int>(parent_to_node_.size()));
+      return parent_to_node_[parent_rank.mpi_rank()];
+    }
+
+    bool is_on_this_node(::yampi::rank const parent_rank) const noexcept
+    { return node_rank(parent_rank).mpi_rank() != MPI_UNDEFINED; }
+
+    // index of the node of the process of parent_rank
+    int node_index(::yampi::rank const parent_rank) const noexcept
+    {
+      assert(parent_rank.mpi_rank() >= 0 and parent_rank.mpi_rank() < static_cast<int>(node_indices_.size()));
+      return node_indices_[parent_rank.mpi_rank()];
+    }
+
+    // rank in the parent of the leader of the node of node_index, which is its rank in the leader communicator
+    ::yampi::rank leader(int const node_index) const noexcept
+    { assert(node_index >= 0 and node_index < num_nodes()); return leaders_[node_index]; }
+
+    // parent ranks ordered by node index, then by node rank
+    std::vector< ::yampi::rank > const& ranks_by_node() const noexcept { return ranks_by_node_; }
+    // each node has consecutive ranks of the parent, and nodes are in the order of the ranks
+    bool is_blocked_by_node() const noexcept { return is_blocked_by_node_; }
+
+    // Minimum message size in bytes for the two-level algorithms
+    std::size_t threshold_bytes() const noexcept { return threshold_bytes_; }
+    void threshold_bytes(std::size_t const threshold_bytes) noexcept { threshold_bytes_ = threshold_bytes; }
+
+    bool uses_two_level(std::size_t const num_bytes) const noexcept
+    {
+      return num_bytes >= threshold_bytes_
+        and std::any_of(node_sizes_.begin(), node_sizes_.end(), [](int const size) { return size > 1; });
+    }
+
+    // Collective over the node communicator with the same arguments. Returns memory shared by the processes on the
+    // node: num_input_bytes bytes for data the processes store before the first synchronize_node(), and
+    // num_output_bytes bytes for the results. Processes may load results from the output after the last
+    // synchronize_node() of an operation, as long as the next operation stores to its input only
+    std::pair<char*, char*> shared_buffers(
+      std::size_t const num_input_bytes, std::size_t const num_output_bytes, ::yampi::environment const& environment)
+    {
+      // some processes may still be loading from the output of the previous operation
+      if (num_input_bytes + num_output_bytes > shared_capacity_)
+      {
+        auto const capacity = std::max(num_input_bytes + num_output_bytes, 2u * shared_capacity_);
+        if (not shared_window_.is_null())
+        {
+          synchronize_node(environment);
+          auto const error_code = MPI_Win_unlock_all(shared_window_.mpi_win());
+          if (error_code != MPI_SUCCESS)
+            throw ::yampi::error{error_code, "yampi::hierarchy::shared_buffers", environment};
+        }
+        shared_data_ = nullptr;
+        shared_capacity_ = 0u;
+
+        shared_window_.reset(
+          node_communicator_.rank(environment) == ::yampi::rank{0} ? capacity : std::size_t{0u},
+          node_communicator_, environment);
+        auto const error_code = MPI_Win_lock_all(MPI_MODE_NOCHECK, shared_window_.mpi_win());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::hierarchy::shared_buffers", environment};
+
+        shared_data_ = shared_window_.shared_segment(::yampi::rank{0}, environment).data();
+        shared_capacity_ = capacity;
+      }
+      else if (num_input_bytes > output_first_)
+        synchronize_node(environment);
+
+      output_first_ = shared_capacity_ - num_output_bytes;
+      return std::make_pair(shared_data_, shared_data_ + output_first_);
+    }
+
+    // Collective over the node communicator. Stores to the shared buffer before this call are visible to loads after
+    // this call
+    void synchronize_node(::yampi::environment const& environment) const
+    { ::yampi::synchronize_barrier(shared_window_, node_communicator_, environment); }
+  };
+
+  namespace hierarchy_detail
+  {
+    inline MPI_Aint extent_of(MPI_Datatype const mpi_datatype, ::yampi::environment const& environment)
+    {
+      MPI_Aint lower_bound, extent;
+      auto const error_code = MPI_Type_get_extent(mpi_datatype, std::addressof(lower_bound), std::addressof(extent));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::hierarchy_detail::extent_of", environment};
+      assert(lower_bound == MPI_Aint{0});
+      return extent;
+    }
+
+    // Whether elements of the datatype fill their extents from the beginning of the buffer without gaps, so that the
+    // two-level algorithms may copy count * extent bytes of the buffer
+    inline bool is_dense(MPI_Datatype const mpi_datatype, ::yampi::environment const& environment)
+    {
+      int size;
+      MPI_Aint lower_bound, extent, true_lower_bound, true_extent;
+      auto error_code = MPI_Type_size(mpi_datatype, std::addressof(size));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::hierarchy_detail::is_dense", environment};
+      error_code = MPI_Type_get_extent(mpi_datatype, std::addressof(lower_bound), std::addressof(extent));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::hierarchy_detail::is_dense", environment};
+      error_code
+        = MPI_Type_get_true_extent(mpi_datatype, std::addressof(true_lower_bound), std::addressof(true_extent));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::hierarchy_detail::is_dense", environment};
+
+      return lower_bound == MPI_Aint{0} and true_lower_bound == MPI_Aint{0}
+        and static_cast<MPI_Aint>(size) == extent and true_extent == extent;
+    }
+
+    inline bool uses_two_level(
+      ::yampi::hierarchy const& hierarchy, std::size_t const num_bytes, MPI_Datatype const mpi_datatype,
+      ::yampi::environment const& environment)
+    {
+      return hierarchy.uses_two_level(num_bytes)
+        and ::yampi::hierarchy_detail::is_dense(mpi_datatype, environment);
+    }
+  } // namespace hierarchy_detail
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -5,7 +5,11 @@
 
 # include <mpi.h>
 
+# include <boost/optional.hpp>
+
 # include <yampi/request_base.hpp>
+# include <yampi/status.hpp>
+# include <yampi/environment.hpp>
 
 
 namespace yampi
@@ -27,6 +31,18 @@ namespace yampi
     immediate_request(immediate_request&&) = default;
     immediate_request& operator=(immediate_request&&) = default;
     ~immediate_request() noexcept = default;
+
+    ::yampi::status wait(::yampi::environment const& environment)
+    { return base_type::do_wait< ::yampi::immediate_request >(environment); }
+
+    void wait(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { base_type::do_wait< ::yampi::immediate_request >(::yampi::ignore_status, environment); }
+
+    boost::optional< ::yampi::status > test(::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::immediate_request >(environment); }
+
+    bool test(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::immediate_request >(::yampi::ignore_status, environment); }
   };
 }
 
@@ -15,6 +15,7 @@
 # include <yampi/group.hpp>
 # include <yampi/color.hpp>
 # include <yampi/split_type.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -50,6 +51,7 @@ namespace yampi
       ::yampi::communicator const& peer_communicator, ::yampi::rank const remote_leader,
       ::yampi::tag const tag, ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::intercommunicator::create", 0u);
       MPI_Comm result;
       int const error_code
         = MPI_Intercomm_create(
@@ -80,6 +82,7 @@ namespace yampi
       ::yampi::communicator& communicator, bool const is_higher_rank_preferred,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::intercommunicator::merge", 0u);
       MPI_Comm result;
       int const error_code
         = MPI_Intercomm_merge(mpi_comm_, static_cast<int>(is_higher_rank_preferred), std::addressof(result));
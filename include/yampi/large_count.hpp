@@ -0,0 +1,131 @@
+#ifndef YAMPI_LARGE_COUNT_HPP
+# define YAMPI_LARGE_COUNT_HPP
+
+# include <cstddef>
+# include <limits>
+# include <algorithm>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/datatype.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+
+
+// Emulation of large counts before MPI-4.
+//
+// Before MPI-4, counts of MPI functions are int's. ::yampi::buffer<T> and ::yampi::target_buffer<T> keep the number
+// of their elements as large_count(), and the following wrappers handle more than INT_MAX elements
+//   send of any mode, receive, broadcast and put/get pass one element of a contiguous datatype of all the elements,
+//   where the type signature is unchanged, and
+//   blocking reduce and all_reduce split the reduction into chunks of at most INT_MAX elements, because predefined
+//   operations are not defined on derived datatypes.
+// The other wrappers use count(environment), which throws ::yampi::error with MPI_ERR_COUNT for more than INT_MAX
+// elements.
+# if MPI_VERSION < 4
+namespace yampi
+{
+  namespace large_count_detail
+  {
+    constexpr std::ptrdiff_t max_count = static_cast<std::ptrdiff_t>(std::numeric_limits<int>::max());
+
+    // count elements, count = num_chunks * max_count + remainder, as a struct of a datatype of num_chunks chunks
+    // and a block of remainder elements
+    inline ::yampi::datatype make_contiguous_datatype(
+      MPI_Datatype const element_datatype, std::ptrdiff_t const count, ::yampi::environment const& environment)
+    {
+      auto const num_chunks = count / ::yampi::large_count_detail::max_count;
+      auto const remainder = static_cast<int>(count % ::yampi::large_count_detail::max_count);
+
+      MPI_Datatype chunk;
+      auto error_code
+        = MPI_Type_contiguous(
+            static_cast<int>(::yampi::large_count_detail::max_count), element_datatype, std::addressof(chunk));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::large_count_detail::make_contiguous_datatype", environment};
+
+      MPI_Datatype chunks;
+      error_code = MPI_Type_contiguous(static_cast<int>(num_chunks), chunk, std::addressof(chunks));
+      MPI_Type_free(std::addressof(chunk));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::large_count_detail::make_contiguous_datatype", environment};
+
+      auto result = chunks;
+      if (remainder > 0)
+      {
+        MPI_Aint lower_bound, extent;
+        error_code = MPI_Type_get_extent(element_datatype, std::addressof(lower_bound), std::addressof(extent));
+        if (error_code == MPI_SUCCESS)
+        {
+          int const block_lengths[2] = {1, remainder};
+          MPI_Aint const displacements[2]
+            = {MPI_Aint{0}, static_cast<MPI_Aint>(num_chunks * ::yampi::large_count_detail::max_count) * extent};
+          MPI_Datatype const mpi_datatypes[2] = {chunks, element_datatype};
+          error_code
+            = MPI_Type_create_struct(2, block_lengths, displacements, mpi_datatypes, std::addressof(result));
+        }
+        MPI_Type_free(std::addressof(chunks));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::error{error_code, "yampi::large_count_detail::make_contiguous_datatype", environment};
+      }
+
+      error_code = MPI_Type_commit(std::addressof(result));
+      if (error_code != MPI_SUCCESS)
+      {
+        MPI_Type_free(std::addressof(result));
+        throw ::yampi::error{error_code, "yampi::large_count_detail::make_contiguous_datatype", environment};
+      }
+      return ::yampi::datatype{result};
+    }
+
+    // count and datatype to be passed to MPI functions
+    class count_and_datatype
+    {
+      int count_;
+      MPI_Datatype mpi_datatype_;
+      ::yampi::datatype large_datatype_;
+
+     public:
+      template <typename Buffer>
+      count_and_datatype(Buffer const& buffer, ::yampi::environment const& environment)
+        : count_{static_cast<int>(std::min(buffer.large_count(), ::yampi::large_count_detail::max_count))},
+          mpi_datatype_{buffer.datatype().mpi_datatype()}, large_datatype_{}
+      {
+        if (buffer.large_count() <= ::yampi::large_count_detail::max_count)
+          return;
+
+        // MPI allows freeing the datatype before the completion of nonblocking operations
+        large_datatype_
+          = ::yampi::large_count_detail::make_contiguous_datatype(mpi_datatype_, buffer.large_count(), environment);
+        count_ = 1;
+        mpi_datatype_ = large_datatype_.mpi_datatype();
+      }
+
+      int count() const noexcept { return count_; }
+      MPI_Datatype mpi_datatype() const noexcept { return mpi_datatype_; }
+    };
+
+    // function(offset, count) is called for each chunk of at most max_count elements, and at least once even if count
+    // is zero. The first error code is returned
+    template <typename Function>
+    inline int for_each_chunk(std::ptrdiff_t const count, Function function)
+    {
+      auto offset = std::ptrdiff_t{0};
+      do
+      {
+        auto const chunk_count = std::min(count - offset, ::yampi::large_count_detail::max_count);
+        auto const error_code = function(offset, static_cast<int>(chunk_count));
+        if (error_code != MPI_SUCCESS)
+          return error_code;
+        offset += chunk_count;
+      }
+      while (offset < count);
+      return MPI_SUCCESS;
+    }
+  } // namespace large_count_detail
+}
+# endif // MPI_VERSION < 4
+
+
+#endif
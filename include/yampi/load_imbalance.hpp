@@ -0,0 +1,207 @@
+#ifndef YAMPI_LOAD_IMBALANCE_HPP
+# define YAMPI_LOAD_IMBALANCE_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <map>
+# include <utility>
+# include <mutex>
+# include <limits>
+# include <algorithm>
+# include <ostream>
+# include <sstream>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/communicator_base.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/wall_clock.hpp>
+
+
+// Load-imbalance meter.
+//
+// Compile with YAMPI_LOAD_IMBALANCE defined to make blocking barrier, broadcast, all_reduce, reduce, gather, all_gather
+// and complete_exchange synchronize the communicator with an extra MPI_Barrier before the operation itself.
+// The time each process waits in it, i.e. how much earlier than the last process it arrived, is recorded to
+// ::yampi::load_imbalance_meter::instance(), keyed by call site and operation.
+// Call sites are named by ::yampi::load_imbalance_site (or YAMPI_LOAD_IMBALANCE_SITE) in the calling thread, e.g.
+//
+//   {
+//     YAMPI_LOAD_IMBALANCE_SITE("solver::residual");
+//     ::yampi::all_reduce(...);
+//   }
+//
+// Without YAMPI_LOAD_IMBALANCE, the YAMPI_*LOAD_IMBALANCE* macros expand to nothing.
+namespace yampi
+{
+  namespace load_imbalance_detail
+  {
+    inline char const*& current_site() noexcept
+    {
+      thread_local char const* result = "";
+      return result;
+    }
+  }
+
+  class load_imbalance_site
+  {
+    char const* previous_site_;
+
+   public:
+    // name must be alive until the destructor is called
+    explicit load_imbalance_site(char const* name) noexcept
+      : previous_site_{::yampi::load_imbalance_detail::current_site()}
+    { ::yampi::load_imbalance_detail::current_site() = name; }
+
+    ~load_imbalance_site() noexcept { ::yampi::load_imbalance_detail::current_site() = previous_site_; }
+
+    load_imbalance_site(load_imbalance_site const&) = delete;
+    load_imbalance_site& operator=(load_imbalance_site const&) = delete;
+    load_imbalance_site(load_imbalance_site&&) = delete;
+    load_imbalance_site& operator=(load_imbalance_site&&) = delete;
+  };
+
+  // wait times in seconds
+  struct load_imbalance_statistics
+  {
+    unsigned long long num_calls;
+    double min_wait;
+    double max_wait;
+    double total_wait;
+
+    double mean_wait() const noexcept { return num_calls == 0ull ? 0.0 : total_wait / static_cast<double>(num_calls); }
+  };
+
+  class load_imbalance_meter
+  {
+   public:
+    // (call site, operation), e.g. ("solver::residual", "yampi::all_reduce")
+    using key_type = std::pair<std::string, std::string>;
+    using map_type = std::map<key_type, ::yampi::load_imbalance_statistics>;
+
+   private:
+    mutable std::mutex mutex_;
+    map_type statistics_;
+
+    load_imbalance_meter() = default;
+
+   public:
+    load_imbalance_meter(load_imbalance_meter const&) = delete;
+    load_imbalance_meter& operator=(load_imbalance_meter const&) = delete;
+
+    static ::yampi::load_imbalance_meter& instance()
+    {
+      static ::yampi::load_imbalance_meter result;
+      return result;
+    }
+
+    void record(char const* site, char const* where, ::yampi::wall_clock::duration const wait)
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto& statistics
+        = statistics_.emplace(
+            key_type{site, where},
+            ::yampi::load_imbalance_statistics{
+              0ull, std::numeric_limits<double>::max(), 0.0, 0.0}).first->second;
+      ++statistics.num_calls;
+      statistics.min_wait = std::min(statistics.min_wait, wait.count());
+      statistics.max_wait = std::max(statistics.max_wait, wait.count());
+      statistics.total_wait += wait.count();
+    }
+
+    void clear()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      statistics_.clear();
+    }
+
+    map_type statistics() const
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return statistics_;
+    }
+
+    // Collective over communicator. root writes "site,operation,rank,calls,min_wait_s,max_wait_s,mean_wait_s"
+    // for each call site and operation recorded in each process
+    void write(
+      std::ostream& out, ::yampi::rank const root,
+      ::yampi::communicator_base const& communicator, ::yampi::environment const& environment) const
+    {
+      auto const present_rank = communicator.rank(environment);
+
+      std::ostringstream rows;
+      rows.precision(out.precision());
+      for (auto const& site_statistics: statistics())
+        rows
+          << site_statistics.first.first << ',' << site_statistics.first.second << ',' << present_rank.mpi_rank() << ','
+          << site_statistics.second.num_calls << ',' << site_statistics.second.min_wait << ','
+          << site_statistics.second.max_wait << ',' << site_statistics.second.mean_wait() << '\n';
+      auto const local_rows = rows.str();
+
+      auto const is_root = present_rank == root;
+      std::vector<int> lengths(is_root ? communicator.size(environment) : 0);
+      auto const length = static_cast<int>(local_rows.size());
+      auto error_code
+        = MPI_Gather(
+            std::addressof(length), 1, MPI_INT, lengths.data(), 1, MPI_INT, root.mpi_rank(), communicator.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::load_imbalance_meter::write", environment};
+
+      std::vector<int> displacements(lengths.size());
+      auto total_length = 0;
+      for (auto index = std::size_t{0u}; index < lengths.size(); ++index)
+      {
+        displacements[index] = total_length;
+        total_length += lengths[index];
+      }
+
+      std::vector<char> all_rows(is_root ? total_length : 0);
+      error_code
+        = MPI_Gatherv(
+            local_rows.data(), length, MPI_CHAR,
+            all_rows.data(), lengths.data(), displacements.data(), MPI_CHAR, root.mpi_rank(), communicator.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::load_imbalance_meter::write", environment};
+
+      if (not is_root)
+        return;
+
+      out << "site,operation,rank,calls,min_wait_s,max_wait_s,mean_wait_s\n";
+      out.write(all_rows.data(), static_cast<std::streamsize>(all_rows.size()));
+      out << std::flush;
+    }
+  };
+
+  namespace load_imbalance_detail
+  {
+    inline void measure(
+      char const* where, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+    {
+      auto const arrival = ::yampi::wall_clock::now(environment);
+      auto const error_code = MPI_Barrier(communicator.mpi_comm());
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, where, environment};
+
+      ::yampi::load_imbalance_meter::instance().record(
+        ::yampi::load_imbalance_detail::current_site(), where, ::yampi::wall_clock::now(environment) - arrival);
+    }
+  } // namespace load_imbalance_detail
+} // namespace yampi
+
+
+# ifdef YAMPI_LOAD_IMBALANCE
+#   define YAMPI_MEASURE_LOAD_IMBALANCE(where, communicator, environment) \
+  ::yampi::load_imbalance_detail::measure(where, communicator, environment)
+#   define YAMPI_LOAD_IMBALANCE_SITE(name) \
+  ::yampi::load_imbalance_site const yampi_load_imbalance_site_{name}
+# else // YAMPI_LOAD_IMBALANCE
+#   define YAMPI_MEASURE_LOAD_IMBALANCE(where, communicator, environment)
+#   define YAMPI_LOAD_IMBALANCE_SITE(name)
+# endif // YAMPI_LOAD_IMBALANCE
+
+
+#endif
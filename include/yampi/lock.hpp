@@ -11,6 +11,7 @@
 # include <yampi/assertion_mode.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -19,20 +20,20 @@ namespace yampi
     : public std::runtime_error
   {
    public:
-    unexpected_lock_status_error()
+    explicit unexpected_lock_status_error(::yampi::environment const&)
       : std::runtime_error{"Error occurred because of strange lock member variables"}
     { }
   };
 
 
   struct defer_lock_t { };
-  struct adapt_lock_t { };
+  struct adopt_lock_t { };
 # if __cplusplus >= 201703L
   inline constexpr ::yampi::defer_lock_t defer_lock{};
-  inline constexpr ::yampi::adapt_lock_t adapt_lock{};
+  inline constexpr ::yampi::adopt_lock_t adopt_lock{};
 # else
   constexpr ::yampi::defer_lock_t defer_lock{};
-  constexpr ::yampi::adapt_lock_t adapt_lock{};
+  constexpr ::yampi::adopt_lock_t adopt_lock{};
 # endif
 
   template <typename Window>
@@ -45,25 +46,36 @@ namespace yampi
     lock_guard(lock_guard const&) = delete;
     lock_guard& operator=(lock_guard const&) = delete;
 
-    ~lock_guard() noexcept { MPI_Win_unlock(rank_.mpi_rank(), window_.mpi_win()); }
+    ~lock_guard() noexcept
+    {
+      MPI_Win_unlock(rank_.mpi_rank(), window_.mpi_win());
+      YAMPI_PROFILE_END("yampi::lock_guard");
+    }
 
     lock_guard(::yampi::rank const rank, ::yampi::window_base<Window>& window, ::yampi::environment const& environment)
       : rank_{rank}, window_{window}
-    { do_lock(0, environment); }
+    {
+      do_lock(0, environment);
+      YAMPI_PROFILE_BEGIN("yampi::lock_guard");
+    }
 
     lock_guard(
       ::yampi::rank const rank, ::yampi::assertion_mode const assertion, ::yampi::window_base<Window>& window,
       ::yampi::environment const& environment)
       : rank_{rank}, window_{window}
-    { do_lock(static_cast<int>(assertion), environment); }
+    {
+      do_lock(static_cast<int>(assertion), environment);
+      YAMPI_PROFILE_BEGIN("yampi::lock_guard");
+    }
 
     lock_guard(::yampi::rank const rank, ::yampi::window_base<Window>& window, ::yampi::adopt_lock_t const)
       : rank_{rank}, window_{window}
-    { }
+    { YAMPI_PROFILE_BEGIN("yampi::lock_guard"); }
 
    private:
-    void do_lock(int const assertion, ::yampi::environment const& environment) const
+    void do_lock(int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::lock_guard::do_lock", 0u);
       int const error_code
         = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, rank_.mpi_rank(), assertion, window_.mpi_win());
       if (error_code != MPI_SUCCESS)
@@ -132,17 +144,18 @@ namespace yampi
       : rank_{rank}, window_ptr_{std::addressof(window)}, owns_{true}
     { }
 
-    void lock(::yampi::environment const& environment) const
+    void lock(::yampi::environment const& environment)
     { do_lock(0, environment); }
 
-    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment) const
+    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment)
     { do_lock(static_cast<int>(assertion), environment); }
 
    private:
-    void do_lock(int const assertion, ::yampi::environment const& environment) const
+    void do_lock(int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::unique_lock::do_lock", 0u);
       if (owns_)
-        throw ::yampi::unexpected_lock_status_error(environment):
+        throw ::yampi::unexpected_lock_status_error(environment);
 
       int const error_code
         = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, rank_.mpi_rank(), assertion, window_ptr_->mpi_win());
@@ -152,8 +165,9 @@ namespace yampi
     }
 
    public:
-    void unlock(::yampi::environment const& environment) const
+    void unlock(::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::unique_lock::unlock", 0u);
       if (not owns_)
         throw ::yampi::unexpected_lock_status_error(environment);
 
@@ -240,17 +254,18 @@ namespace yampi
       : rank_{rank}, window_ptr_{std::addressof(window)}, owns_{true}
     { }
 
-    void lock(::yampi::environment const& environment) const
+    void lock(::yampi::environment const& environment)
     { do_lock(0, environment); }
 
-    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment) const
+    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment)
     { do_lock(static_cast<int>(assertion), environment); }
 
    private:
-    void do_lock(int const assertion, ::yampi::environment const& environment) const
+    void do_lock(int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::shared_lock::do_lock", 0u);
       if (owns_)
-        throw ::yampi::unexpected_lock_status_error(environment):
+        throw ::yampi::unexpected_lock_status_error(environment);
 
       int const error_code
         = MPI_Win_lock(MPI_LOCK_SHARED, rank_.mpi_rank(), assertion, window_ptr_->mpi_win());
@@ -260,8 +275,9 @@ namespace yampi
     }
 
    public:
-    void unlock(::yampi::environment const& environment) const
+    void unlock(::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::shared_lock::unlock", 0u);
       if (not owns_)
         throw ::yampi::unexpected_lock_status_error(environment);
 
@@ -342,17 +358,18 @@ namespace yampi
       : window_ptr_{std::addressof(window)}, owns_{true}
     { }
 
-    void lock(::yampi::environment const& environment) const
+    void lock(::yampi::environment const& environment)
     { do_lock(0, environment); }
 
-    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment) const
+    void lock(::yampi::assertion_mode const assertion, ::yampi::environment const& environment)
     { do_lock(static_cast<int>(assertion), environment); }
 
    private:
-    void do_lock(int const assertion, ::yampi::environment const& environment) const
+    void do_lock(int const assertion, ::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::all_shared_lock::do_lock", 0u);
       if (owns_)
-        throw ::yampi::unexpected_lock_status_error(environment):
+        throw ::yampi::unexpected_lock_status_error(environment);
 
       int const error_code = MPI_Win_lock_all(assertion, window_ptr_->mpi_win());
       if (error_code != MPI_SUCCESS)
@@ -361,8 +378,9 @@ namespace yampi
     }
 
    public:
-    void unlock(::yampi::environment const& environment) const
+    void unlock(::yampi::environment const& environment)
     {
+      YAMPI_PROFILE_SCOPE("yampi::all_shared_lock::unlock", 0u);
       if (not owns_)
         throw ::yampi::unexpected_lock_status_error(environment);
 
@@ -18,6 +18,7 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -32,6 +33,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Allgatherv_c(
@@ -44,7 +46,7 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Allgatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
@@ -52,7 +54,7 @@ namespace yampi
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Allgatherv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm());
@@ -68,6 +70,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Allgatherv_c(
@@ -96,6 +99,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_allgatherv_c(
@@ -108,7 +112,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_allgatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm());
@@ -125,6 +129,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -138,7 +143,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iallgatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           communicator.mpi_comm(), std::addressof(mpi_request));
@@ -156,6 +161,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -187,6 +193,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -200,7 +207,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ineighbor_allgatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           topology.communicator().mpi_comm(), std::addressof(mpi_request));
@@ -220,6 +227,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allgatherv_init_c(
@@ -242,6 +250,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allgatherv_init_c(
@@ -264,6 +273,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_allgatherv_init_c(
@@ -285,6 +295,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allgatherv_init_c(
@@ -307,6 +318,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Allgatherv_init_c(
@@ -328,6 +340,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_all_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_allgatherv_init_c(
@@ -17,6 +17,7 @@
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -31,6 +32,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Alltoallv_c(
@@ -70,6 +72,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, true> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Alltoallw_c(
@@ -111,6 +114,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Alltoallv_c(
@@ -138,6 +142,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, true> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Alltoallw_c(
@@ -173,6 +178,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_alltoallv_c(
@@ -203,6 +209,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Neighbor_alltoallw_c(
@@ -236,6 +243,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -269,6 +277,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, true> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -304,6 +313,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -334,6 +344,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, true> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -365,6 +376,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -398,6 +410,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -435,6 +448,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallv_init_c(
@@ -459,6 +473,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallw_init_c(
@@ -484,6 +499,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallv_init_c(
@@ -505,6 +521,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, true> receive_buffer, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallw_init_c(
@@ -527,6 +544,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_alltoallv_init_c(
@@ -551,6 +569,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_alltoallw_init_c(
@@ -575,6 +594,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallv_init_c(
@@ -598,6 +618,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, true> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallw_init_c(
@@ -623,6 +644,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallv_init_c(
@@ -644,6 +666,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, true> receive_buffer,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Alltoallw_init_c(
@@ -665,6 +688,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_alltoallv_init_c(
@@ -688,6 +712,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, true> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::topology<Topology> const& topology, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_complete_exchange", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Neighbor_alltoallw_init_c(
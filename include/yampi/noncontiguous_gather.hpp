@@ -17,6 +17,7 @@
 # include <yampi/nonroot_call_on_root_error.hpp>
 # include <yampi/root_call_on_nonroot_error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -32,6 +33,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gatherv_c(
@@ -44,7 +46,7 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
@@ -52,7 +54,7 @@ namespace yampi
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gatherv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
@@ -66,6 +68,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error("yampi::noncontiguos_gather");
 
@@ -78,14 +81,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gatherv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -99,6 +102,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_gather"};
 
@@ -129,6 +133,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gatherv_c(
@@ -138,14 +143,14 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Gatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Gatherv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
@@ -158,6 +163,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gatherv_c(
@@ -182,6 +188,7 @@ namespace yampi
   template <typename ReceiveValue>
   inline void noncontiguous_gather(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Gatherv_c(
@@ -205,6 +212,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -218,7 +226,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           receive_buffer.data(), receive_buffer.count_first(),
           receive_buffer.displacement_first(), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
@@ -234,6 +242,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::noncontiguos_gather"};
 
@@ -247,7 +256,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -263,6 +272,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_gather"};
 
@@ -296,6 +306,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -306,7 +317,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Igatherv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -321,6 +332,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -349,6 +361,7 @@ namespace yampi
     ::yampi::immediate_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -376,6 +389,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -396,6 +410,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error("yampi::noncontiguos_gather");
 
@@ -417,6 +432,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_gather"};
 
@@ -441,6 +457,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -458,6 +475,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -477,6 +495,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -495,6 +514,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -515,6 +535,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error("yampi::noncontiguos_gather");
 
@@ -536,6 +557,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_gather"};
 
@@ -560,6 +582,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -577,6 +600,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<ReceiveValue, false> receive_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
@@ -596,6 +620,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_gather", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Gatherv_init_c(
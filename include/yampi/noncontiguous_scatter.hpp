@@ -17,6 +17,7 @@
 # include <yampi/nonroot_call_on_root_error.hpp>
 # include <yampi/root_call_on_nonroot_error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -32,6 +33,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatterv_c(
@@ -46,7 +48,7 @@ namespace yampi
       = MPI_Scatterv(
           send_buffer.data(), send_buffer.count_first(),
           send_buffer.displacement_first(), send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
@@ -54,7 +56,7 @@ namespace yampi
       = MPI_Scatterv(
           const_cast<value_type*>(send_buffer.data()), const_cast<int*>(send_buffer.count_first()),
           const_cast<int*>(send_buffer.displacement_first()), send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -66,6 +68,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::noncontiguous_scatter"};
 
@@ -79,7 +82,7 @@ namespace yampi
     auto const error_code
       = MPI_Scatterv(
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -92,6 +95,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_scatter"};
 
@@ -130,6 +134,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatterv_c(
@@ -140,7 +145,7 @@ namespace yampi
     auto const error_code
       = MPI_Scatterv(
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -152,6 +157,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatterv_c(
@@ -183,6 +189,7 @@ namespace yampi
 
   inline void noncontiguous_scatter(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatterv_c(
@@ -206,6 +213,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -221,7 +229,7 @@ namespace yampi
       = MPI_Iscatterv(
           send_buffer.data(), send_buffer.count_first(),
           send_buffer.displacement_first(), send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -235,6 +243,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::noncontiguous_scatter"};
 
@@ -249,7 +258,7 @@ namespace yampi
     auto const error_code
       = MPI_Iscatterv(
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -264,6 +273,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_scatter"};
 
@@ -297,6 +307,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -308,7 +319,7 @@ namespace yampi
     auto const error_code
       = MPI_Iscatterv(
           nullptr, nullptr, nullptr, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -322,6 +333,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -349,6 +361,7 @@ namespace yampi
     ::yampi::immediate_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -376,6 +389,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -396,6 +410,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::noncontiguous_scatter"};
 
@@ -417,6 +432,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_scatter"};
 
@@ -441,6 +457,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -458,6 +475,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -476,6 +494,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -494,6 +513,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -514,6 +534,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::noncontiguous_scatter"};
 
@@ -535,6 +556,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<Value, false> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::noncontiguous_scatter"};
 
@@ -559,6 +581,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -576,6 +599,7 @@ namespace yampi
     ::yampi::noncontiguous_buffer<SendValue, false> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -594,6 +618,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::noncontiguous_scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatterv_init_c(
@@ -0,0 +1,334 @@
+#ifndef YAMPI_PACK_HPP
+# define YAMPI_PACK_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstring>
+# include <iterator>
+# include <vector>
+# include <type_traits>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/datatype.hpp>
+# include <yampi/count.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/detail/restrict.hpp>
+
+
+// Packing.
+//
+// ::yampi::pack_size(buffer, communicator, environment) and ::yampi::pack(buffer, out_first, out_last, position,
+// communicator, environment) wrap MPI_Pack_size and MPI_Pack; pack writes buffer to the bytes [out_first, out_last)
+// from position and returns the position after the written bytes. ::yampi::unpack (<yampi/unpack.hpp>) is the
+// inverse.
+//
+// Layouts of derived datatypes of Value's can also be packed into contiguous Value's in user space, without
+// datatypes, by
+//   ::yampi::pack(data, strided_block, count, out)                  // as MPI_Type_vector
+//   ::yampi::pack(data, flexible_blocks, out)                       // as MPI_Type_indexed
+//   ::yampi::pack(data, fixed_blocks, out)                          // as MPI_Type_create_indexed_block
+//   ::yampi::pack(data, size_first, size_last, subsize_first, start_index_first, out) // as MPI_Type_create_subarray
+// which return the end of the packed Value's. Blocks which are adjacent in memory are copied together by std::memcpy,
+// and short blocks (e.g. columns) by loops the compiler can vectorize, where many MPI libraries pack an element at a
+// time. Value must be trivially copyable.
+//
+//   std::vector<double> face(ny * nz);
+//   ::yampi::pack(
+//     field.data() + i, ::yampi::strided_block{::yampi::count{1}, ::yampi::count{nx}}, ::yampi::count{ny * nz},
+//     face.data());
+//   ::yampi::send(::yampi::make_buffer(face.begin(), face.end()), destination, tag, communicator, environment);
+namespace yampi
+{
+  namespace pack_detail
+  {
+    inline std::ptrdiff_t to_ptrdiff(int const value) noexcept { return static_cast<std::ptrdiff_t>(value); }
+    inline std::ptrdiff_t to_ptrdiff(::yampi::count const& count) noexcept
+    { return static_cast<std::ptrdiff_t>(count.mpi_count()); }
+
+    // Blocks shorter than this are copied element by element, because calling std::memcpy costs more
+    constexpr std::size_t min_memcpy_bytes = 64u;
+
+    // Copies num_blocks blocks of length Value's whose first elements are from_stride and to_stride Value's apart
+    template <typename Value>
+    inline void copy_blocks(
+      Value const* YAMPI_RESTRICT from, Value* YAMPI_RESTRICT to,
+      std::ptrdiff_t num_blocks, std::ptrdiff_t length,
+      std::ptrdiff_t const from_stride, std::ptrdiff_t const to_stride) noexcept
+    {
+      static_assert(std::is_trivially_copyable<Value>::value, "Value must be trivially copyable");
+      if (num_blocks <= 0 or length <= 0)
+        return;
+
+      // adjacent blocks are one block
+      if (from_stride == length and to_stride == length)
+      {
+        length *= num_blocks;
+        num_blocks = 1;
+      }
+
+      if (length == 1)
+        for (auto block = std::ptrdiff_t{0}; block < num_blocks; ++block)
+          to[block * to_stride] = from[block * from_stride];
+      else if (static_cast<std::size_t>(length) * sizeof(Value) < ::yampi::pack_detail::min_memcpy_bytes)
+        for (auto block = std::ptrdiff_t{0}; block < num_blocks; ++block)
+          for (auto index = std::ptrdiff_t{0}; index < length; ++index)
+            to[block * to_stride + index] = from[block * from_stride + index];
+      else
+        for (auto block = std::ptrdiff_t{0}; block < num_blocks; ++block)
+          std::memcpy(
+            to + block * to_stride, from + block * from_stride, static_cast<std::size_t>(length) * sizeof(Value));
+    }
+
+    // Calls copy(displacement, length) for each run of blocks adjacent in memory, merging the runs
+    template <typename DisplacementIterator, typename LengthOf, typename Copy>
+    inline void for_each_run(
+      DisplacementIterator displacement_first, DisplacementIterator const displacement_last,
+      LengthOf length_of, Copy copy)
+    {
+      auto run_displacement = std::ptrdiff_t{0};
+      auto run_length = std::ptrdiff_t{0};
+      for (auto index = std::ptrdiff_t{0}; displacement_first != displacement_last; ++displacement_first, ++index)
+      {
+        auto const displacement = ::yampi::pack_detail::to_ptrdiff(*displacement_first);
+        auto const length = length_of(index);
+        if (length <= 0)
+          continue;
+
+        if (run_length > 0 and run_displacement + run_length == displacement)
+          run_length += length;
+        else
+        {
+          if (run_length > 0)
+            copy(run_displacement, run_length);
+          run_displacement = displacement;
+          run_length = length;
+        }
+      }
+      if (run_length > 0)
+        copy(run_displacement, run_length);
+    }
+
+    // C-order subarray of the array of sizes as runs of run_length contiguous Value's: the dimensions from
+    // run_dimension on are covered by a run, and the ones before are iterated
+    class subarray_layout
+    {
+      std::vector<std::ptrdiff_t> sizes_;
+      std::vector<std::ptrdiff_t> subsizes_;
+      std::vector<std::ptrdiff_t> start_indices_;
+      std::vector<std::ptrdiff_t> strides_;
+      std::size_t run_dimension_;
+      std::ptrdiff_t run_length_;
+      std::ptrdiff_t num_elements_;
+
+     public:
+      template <typename ContiguousIterator1, typename ContiguousIterator2, typename ContiguousIterator3>
+      subarray_layout(
+        ContiguousIterator1 size_first, ContiguousIterator1 const size_last,
+        ContiguousIterator2 subsize_first, ContiguousIterator3 start_index_first)
+        : sizes_{}, subsizes_{}, start_indices_{}, strides_{}, run_dimension_{0u}, run_length_{1}, num_elements_{1}
+      {
+        for (; size_first != size_last; ++size_first, ++subsize_first, ++start_index_first)
+        {
+          sizes_.push_back(::yampi::pack_detail::to_ptrdiff(*size_first));
+          subsizes_.push_back(::yampi::pack_detail::to_ptrdiff(*subsize_first));
+          start_indices_.push_back(::yampi::pack_detail::to_ptrdiff(*start_index_first));
+          assert(subsizes_.back() >= 0 and start_indices_.back() >= 0);
+          assert(start_indices_.back() + subsizes_.back() <= sizes_.back());
+          num_elements_ *= subsizes_.back();
+        }
+
+        strides_.assign(sizes_.size(), 1);
+        for (auto dimension = sizes_.size(); dimension > 1u; --dimension)
+          strides_[dimension - 2u] = strides_[dimension - 1u] * sizes_[dimension - 1u];
+
+        run_dimension_ = sizes_.size();
+        while (run_dimension_ > 0u)
+        {
+          --run_dimension_;
+          run_length_ *= subsizes_[run_dimension_];
+          if (subsizes_[run_dimension_] != sizes_[run_dimension_])
+            break;
+        }
+      }
+
+      std::ptrdiff_t num_elements() const noexcept { return num_elements_; }
+
+      // Calls copy(displacement, num_blocks, stride, length) for each row of runs along the dimension just before
+      // run_dimension
+      template <typename Copy>
+      void for_each_row(Copy copy) const
+      {
+        if (num_elements_ == 0)
+          return;
+
+        auto base_displacement = std::ptrdiff_t{0};
+        for (auto dimension = std::size_t{0u}; dimension < sizes_.size(); ++dimension)
+          base_displacement += start_indices_[dimension] * strides_[dimension];
+
+        if (run_dimension_ == 0u)
+        {
+          copy(base_displacement, std::ptrdiff_t{1}, run_length_, run_length_);
+          return;
+        }
+
+        auto const row_dimension = run_dimension_ - 1u;
+        std::vector<std::ptrdiff_t> indices(row_dimension, 0);
+        while (true)
+        {
+          auto displacement = base_displacement;
+          for (auto dimension = std::size_t{0u}; dimension < row_dimension; ++dimension)
+            displacement += indices[dimension] * strides_[dimension];
+          copy(displacement, subsizes_[row_dimension], strides_[row_dimension], run_length_);
+
+          auto dimension = row_dimension;
+          while (dimension > 0u and ++indices[dimension - 1u] == subsizes_[dimension - 1u])
+            indices[--dimension] = 0;
+          if (dimension == 0u)
+            return;
+        }
+      }
+    };
+  } // namespace pack_detail
+
+  // MPI_Pack_size
+  template <typename Value>
+  inline std::size_t pack_size(
+    ::yampi::buffer<Value> const buffer,
+    ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+  {
+# if MPI_VERSION >= 4
+    MPI_Count result;
+    auto const error_code
+      = MPI_Pack_size_c(
+          buffer.count().mpi_count(), buffer.datatype().mpi_datatype(), communicator.mpi_comm(),
+          std::addressof(result));
+# else // MPI_VERSION >= 4
+    int result;
+    auto const error_code
+      = MPI_Pack_size(
+          buffer.count(environment), buffer.datatype().mpi_datatype(), communicator.mpi_comm(), std::addressof(result));
+# endif // MPI_VERSION >= 4
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::pack_size", environment};
+    return static_cast<std::size_t>(result);
+  }
+
+  // MPI_Pack
+  template <typename Value, typename ContiguousIterator>
+  inline std::size_t pack(
+    ::yampi::buffer<Value> const buffer,
+    ContiguousIterator const out_first, ContiguousIterator const out_last, std::size_t const position,
+    ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+  {
+    static_assert(
+      sizeof(typename std::iterator_traits<ContiguousIterator>::value_type) == 1u,
+      "The value type of ContiguousIterator must be a byte");
+    assert(out_last >= out_first);
+    YAMPI_PROFILE_SCOPE("yampi::pack", ::yampi::profiler::num_bytes(buffer, environment));
+
+    // some implementations reject null pointers even if nothing is written
+    char empty_out;
+    auto const out
+      = out_first == out_last
+        ? static_cast<void*>(std::addressof(empty_out))
+        : static_cast<void*>(std::addressof(*out_first));
+# if MPI_VERSION >= 4
+    auto result = static_cast<MPI_Count>(position);
+    auto const error_code
+      = MPI_Pack_c(
+          buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
+          out, static_cast<MPI_Count>(out_last - out_first), std::addressof(result), communicator.mpi_comm());
+# elif MPI_VERSION >= 3
+    auto result = static_cast<int>(position);
+    auto const error_code
+      = MPI_Pack(
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
+          out, static_cast<int>(out_last - out_first), std::addressof(result), communicator.mpi_comm());
+# else // MPI_VERSION
+    using value_type = typename std::remove_cv<Value>::type;
+    auto result = static_cast<int>(position);
+    auto const error_code
+      = MPI_Pack(
+          const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
+          out, static_cast<int>(out_last - out_first), std::addressof(result), communicator.mpi_comm());
+# endif // MPI_VERSION
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::pack", environment};
+    return static_cast<std::size_t>(result);
+  }
+
+  // as MPI_Type_vector
+  template <typename Value>
+  inline Value* pack(
+    Value const* data, ::yampi::strided_block const& block, ::yampi::count const count, Value* out) noexcept
+  {
+    auto const length = ::yampi::pack_detail::to_ptrdiff(block.length());
+    auto const num_blocks = ::yampi::pack_detail::to_ptrdiff(count);
+    ::yampi::pack_detail::copy_blocks(
+      data, out, num_blocks, length, ::yampi::pack_detail::to_ptrdiff(block.stride()), length);
+    return out + num_blocks * length;
+  }
+
+  // as MPI_Type_indexed
+  template <typename Value>
+  inline Value* pack(Value const* data, ::yampi::flexible_blocks const& blocks, Value* out) noexcept
+  {
+    auto const length_first = blocks.length_begin();
+    ::yampi::pack_detail::for_each_run(
+      blocks.displacement_begin(), blocks.displacement_end(),
+      [length_first](std::ptrdiff_t const index) { return ::yampi::pack_detail::to_ptrdiff(length_first[index]); },
+      [data, &out](std::ptrdiff_t const displacement, std::ptrdiff_t const length)
+      {
+        ::yampi::pack_detail::copy_blocks(data + displacement, out, std::ptrdiff_t{1}, length, length, length);
+        out += length;
+      });
+    return out;
+  }
+
+  // as MPI_Type_create_indexed_block
+  template <typename Value>
+  inline Value* pack(Value const* data, ::yampi::fixed_blocks const& blocks, Value* out) noexcept
+  {
+    auto const length = ::yampi::pack_detail::to_ptrdiff(blocks.length());
+    ::yampi::pack_detail::for_each_run(
+      blocks.displacement_begin(), blocks.displacement_end(),
+      [length](std::ptrdiff_t) { return length; },
+      [data, &out](std::ptrdiff_t const displacement, std::ptrdiff_t const run_length)
+      {
+        ::yampi::pack_detail::copy_blocks(
+          data + displacement, out, std::ptrdiff_t{1}, run_length, run_length, run_length);
+        out += run_length;
+      });
+    return out;
+  }
+
+  // as MPI_Type_create_subarray with MPI_ORDER_C
+  template <typename Value, typename ContiguousIterator1, typename ContiguousIterator2, typename ContiguousIterator3>
+  inline Value* pack(
+    Value const* data,
+    ContiguousIterator1 const array_size_first, ContiguousIterator1 const array_size_last,
+    ContiguousIterator2 const array_subsize_first, ContiguousIterator3 const array_start_index_first,
+    Value* out)
+  {
+    ::yampi::pack_detail::subarray_layout const layout{
+      array_size_first, array_size_last, array_subsize_first, array_start_index_first};
+    layout.for_each_row(
+      [data, &out](
+        std::ptrdiff_t const displacement, std::ptrdiff_t const num_runs, std::ptrdiff_t const stride,
+        std::ptrdiff_t const run_length)
+      {
+        ::yampi::pack_detail::copy_blocks(data + displacement, out, num_runs, run_length, stride, run_length);
+        out += num_runs * run_length;
+      });
+    return out;
+  }
+}
+
+
+#endif
@@ -7,10 +7,13 @@
 
 # include <mpi.h>
 
+# include <boost/optional.hpp>
+
 # include <yampi/partition.hpp>
 # include <yampi/startable_request.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/status.hpp>
 
 # if MPI_VERSION >= 4
 namespace yampi
@@ -33,6 +36,18 @@ namespace yampi
     partitioned_request& operator=(partitioned_request&&) = default;
     ~partitioned_request() noexcept = default;
 
+    ::yampi::status wait(::yampi::environment const& environment)
+    { return base_type::do_wait< ::yampi::partitioned_request >(environment); }
+
+    void wait(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { base_type::do_wait< ::yampi::partitioned_request >(::yampi::ignore_status, environment); }
+
+    boost::optional< ::yampi::status > test(::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::partitioned_request >(environment); }
+
+    bool test(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::partitioned_request >(::yampi::ignore_status, environment); }
+
     void ready(::yampi::partition const partition, ::yampi::environment const& environment)
     {
       auto const error_code = MPI_Pready(partition.mpi_partition(), mpi_request_);
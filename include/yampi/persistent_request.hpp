@@ -5,7 +5,11 @@
 
 # include <mpi.h>
 
+# include <boost/optional.hpp>
+
 # include <yampi/startable_request.hpp>
+# include <yampi/status.hpp>
+# include <yampi/environment.hpp>
 
 
 namespace yampi
@@ -27,6 +31,18 @@ namespace yampi
     persistent_request(persistent_request&&) = default;
     persistent_request& operator=(persistent_request&&) = default;
     ~persistent_request() noexcept = default;
+
+    ::yampi::status wait(::yampi::environment const& environment)
+    { return base_type::do_wait< ::yampi::persistent_request >(environment); }
+
+    void wait(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { base_type::do_wait< ::yampi::persistent_request >(::yampi::ignore_status, environment); }
+
+    boost::optional< ::yampi::status > test(::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::persistent_request >(environment); }
+
+    bool test(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    { return base_type::do_test< ::yampi::persistent_request >(::yampi::ignore_status, environment); }
   };
 }
 
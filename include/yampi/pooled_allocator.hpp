@@ -0,0 +1,312 @@
+#ifndef YAMPI_POOLED_ALLOCATOR_HPP
+# define YAMPI_POOLED_ALLOCATOR_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <limits>
+# include <type_traits>
+# include <array>
+# include <vector>
+# include <mutex>
+# include <memory>
+# include <utility>
+
+# include <mpi.h>
+
+# include <yampi/is_initialized.hpp>
+# include <yampi/is_finalized.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/allocator.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Caching allocator over MPI_Alloc_mem.
+//
+// ::yampi::pooled_allocator<T> is a drop-in replacement of ::yampi::allocator<T>. Sizes are rounded up to powers of two
+// (at least memory_pool::min_block_size bytes), and deallocated blocks are kept in per-size free lists of
+// ::yampi::memory_pool for reuse, so that memory registered by RDMA-capable MPIs is not registered again.
+// Blocks larger than memory_pool::max_block_size bytes are not cached.
+// Cached blocks are returned with MPI_Free_mem by memory_pool::release(), or at MPI_Finalize.
+//
+// The pool of ::yampi::pooled_allocator<T> is shared in the process and protected by a mutex, so the allocators can be
+// used from any thread. ::yampi::pooled_allocator<T, false> uses a separate pool without locking, which must never be
+// used by more than one thread at a time.
+namespace yampi
+{
+  struct memory_pool_statistics
+  {
+    // allocations served from/not from the free lists
+    unsigned long long num_hits;
+    unsigned long long num_misses;
+    // bytes in the free lists, and bytes allocated by MPI_Alloc_mem and not yet deallocated
+    std::size_t num_held_bytes;
+    std::size_t num_used_bytes;
+
+    double hit_rate() const noexcept
+    { return num_hits + num_misses == 0ull ? 0.0 : static_cast<double>(num_hits) / static_cast<double>(num_hits + num_misses); }
+  };
+
+  namespace pooled_allocator_detail
+  {
+    struct null_mutex
+    {
+      void lock() noexcept { }
+      void unlock() noexcept { }
+    };
+  }
+
+  template <bool is_thread_safe>
+  class memory_pool
+  {
+   public:
+    static constexpr std::size_t min_block_size = std::size_t{1u} << 6u;
+    static constexpr std::size_t max_block_size = std::size_t{1u} << 30u;
+
+   private:
+    static constexpr std::size_t num_size_classes = 25u; // 2^6, 2^7, ..., 2^30
+
+    using mutex_type
+      = typename std::conditional<is_thread_safe, std::mutex, ::yampi::pooled_allocator_detail::null_mutex>::type;
+
+    mutable mutex_type mutex_;
+    std::array<std::vector<void*>, num_size_classes> free_lists_;
+    std::size_t max_held_bytes_;
+    ::yampi::memory_pool_statistics statistics_;
+    bool is_finalized_;
+
+    memory_pool()
+      : mutex_{}, free_lists_{}, max_held_bytes_{std::numeric_limits<std::size_t>::max()},
+        statistics_{0ull, 0ull, 0u, 0u}, is_finalized_{false}
+    {
+      // without the hook, cached blocks would outlive MPI_Finalize
+      auto const error_code = ::yampi::detail::at_finalize([this]() { finalize(); });
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::allocate_error(error_code);
+    }
+
+   public:
+    memory_pool(memory_pool const&) = delete;
+    memory_pool& operator=(memory_pool const&) = delete;
+
+    // MPI must be initialized when this is called first. The instance is never destroyed, so that cached blocks are
+    // freed at MPI_Finalize even after the destruction of static objects. Throws ::yampi::allocate_error if the hook
+    // which frees them cannot be registered
+    static ::yampi::memory_pool<is_thread_safe>& instance()
+    {
+      static auto& result = *new ::yampi::memory_pool<is_thread_safe>{};
+      return result;
+    }
+
+    void* allocate(std::size_t const num_bytes)
+    {
+      auto const size_class = size_class_of(num_bytes);
+      auto const block_size = size_class < num_size_classes ? block_size_of(size_class) : num_bytes;
+
+      {
+        std::lock_guard<mutex_type> lock{mutex_};
+        if (size_class < num_size_classes and not free_lists_[size_class].empty())
+        {
+          auto const result = free_lists_[size_class].back();
+          free_lists_[size_class].pop_back();
+          ++statistics_.num_hits;
+          statistics_.num_held_bytes -= block_size;
+          return result;
+        }
+        ++statistics_.num_misses;
+      }
+
+      void* result;
+      auto const error_code = MPI_Alloc_mem(static_cast<MPI_Aint>(block_size), MPI_INFO_NULL, std::addressof(result));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::allocate_error(error_code);
+
+      std::lock_guard<mutex_type> lock{mutex_};
+      statistics_.num_used_bytes += block_size;
+      return result;
+    }
+
+    // num_bytes must be the same as that passed to allocate
+    void deallocate(void* ptr, std::size_t const num_bytes)
+    {
+      auto const size_class = size_class_of(num_bytes);
+      auto const block_size = size_class < num_size_classes ? block_size_of(size_class) : num_bytes;
+
+      {
+        std::lock_guard<mutex_type> lock{mutex_};
+        // MPI_Free_mem must not be called after MPI_Finalize
+        if (is_finalized_)
+          return;
+
+        if (size_class < num_size_classes and statistics_.num_held_bytes + block_size <= max_held_bytes_)
+        {
+          free_lists_[size_class].push_back(ptr);
+          statistics_.num_held_bytes += block_size;
+          return;
+        }
+        statistics_.num_used_bytes -= block_size;
+      }
+
+      auto const error_code = MPI_Free_mem(ptr);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::deallocate_error(error_code);
+    }
+
+    // Frees all cached blocks
+    void release()
+    {
+      std::lock_guard<mutex_type> lock{mutex_};
+      do_release();
+    }
+
+    // Cached blocks exceeding max_held_bytes are freed on deallocation
+    void max_held_bytes(std::size_t const max_held_bytes)
+    {
+      std::lock_guard<mutex_type> lock{mutex_};
+      max_held_bytes_ = max_held_bytes;
+    }
+
+    std::size_t max_held_bytes() const
+    {
+      std::lock_guard<mutex_type> lock{mutex_};
+      return max_held_bytes_;
+    }
+
+    ::yampi::memory_pool_statistics statistics() const
+    {
+      std::lock_guard<mutex_type> lock{mutex_};
+      return statistics_;
+    }
+
+   private:
+    static std::size_t size_class_of(std::size_t const num_bytes) noexcept
+    {
+      auto result = std::size_t{0u};
+      for (auto block_size = min_block_size; block_size < num_bytes and result < num_size_classes; block_size <<= 1u)
+        ++result;
+      return result;
+    }
+
+    static constexpr std::size_t block_size_of(std::size_t const size_class) noexcept
+    { return min_block_size << size_class; }
+
+    void do_release()
+    {
+      auto error_code = MPI_SUCCESS;
+      for (auto size_class = std::size_t{0u}; size_class < num_size_classes; ++size_class)
+      {
+        for (auto const ptr: free_lists_[size_class])
+        {
+          auto const free_error_code = MPI_Free_mem(ptr);
+          if (free_error_code != MPI_SUCCESS)
+            error_code = free_error_code;
+        }
+
+        auto const num_bytes = free_lists_[size_class].size() * block_size_of(size_class);
+        statistics_.num_held_bytes -= num_bytes;
+        statistics_.num_used_bytes -= num_bytes;
+        free_lists_[size_class].clear();
+      }
+
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::deallocate_error(error_code);
+    }
+
+    // called at the beginning of MPI_Finalize
+    void finalize()
+    {
+      std::lock_guard<mutex_type> lock{mutex_};
+      is_finalized_ = true;
+      do_release();
+    }
+  };
+
+  template <typename T, bool is_thread_safe = true>
+  class pooled_allocator
+  {
+   public:
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef void* void_pointer;
+    typedef void const* const_void_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    template <typename U>
+    struct rebind
+    { typedef pooled_allocator<U, is_thread_safe> other; };
+
+    pooled_allocator()
+    {
+      if (not ::yampi::is_initialized())
+        throw ::yampi::not_yet_initialized_error(); // defined in allocator.hpp
+
+      if (::yampi::is_finalized())
+        throw ::yampi::already_finalized_error(); // defined in environment.hpp
+    }
+
+    explicit pooled_allocator(::yampi::environment const&) noexcept { }
+
+    pooled_allocator(pooled_allocator const&) noexcept { }
+
+    template <typename U>
+    pooled_allocator(pooled_allocator<U, is_thread_safe> const&) noexcept { }
+
+    pointer address(reference x) const { return std::addressof(x); }
+    const_pointer address(const_reference x) const { return std::addressof(x); }
+
+    pointer allocate(std::size_t const n, const_void_pointer = nullptr)
+    {
+      assert(::yampi::is_initialized());
+      return static_cast<pointer>(::yampi::memory_pool<is_thread_safe>::instance().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(pointer ptr, std::size_t const n)
+    { ::yampi::memory_pool<is_thread_safe>::instance().deallocate(ptr, n * sizeof(T)); }
+
+    size_type max_size() const noexcept
+    { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    template <typename U, typename... Arguments>
+    void construct(U* ptr, Arguments&&... arguments)
+    { ::new((void *)ptr) U(std::forward<Arguments>(arguments)...); }
+
+    void destroy(pointer ptr) { ((T*)ptr)->~T(); }
+    template <typename U>
+    void destroy(U* ptr) { ptr->~U(); }
+  };
+
+  template <bool is_thread_safe>
+  class pooled_allocator<void, is_thread_safe>
+  {
+   public:
+    typedef void* pointer;
+    typedef void const* const_pointer;
+    typedef void* void_pointer;
+    typedef void const* const_void_pointer;
+    typedef void value_type;
+
+    template <typename U>
+    struct rebind
+    { typedef pooled_allocator<U, is_thread_safe> other; };
+  };
+
+
+  template <typename T, typename U, bool is_thread_safe>
+  inline constexpr bool operator==(
+    ::yampi::pooled_allocator<T, is_thread_safe> const&, ::yampi::pooled_allocator<U, is_thread_safe> const&) noexcept
+  { return true; }
+
+  template <typename T, typename U, bool is_thread_safe>
+  inline constexpr bool operator!=(
+    ::yampi::pooled_allocator<T, is_thread_safe> const&, ::yampi::pooled_allocator<U, is_thread_safe> const&) noexcept
+  { return false; }
+}
+
+
+#endif
@@ -14,6 +14,7 @@
 # include <yampi/status.hpp>
 # include <yampi/error.hpp>
 # include <yampi/message.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -22,6 +23,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Status mpi_status;
     int flag;
     auto const error_code
@@ -39,6 +41,7 @@ namespace yampi
   inline boost::optional< ::yampi::status > probe_test(
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Status mpi_status;
     int flag;
     auto const error_code
@@ -56,6 +59,7 @@ namespace yampi
   inline boost::optional< ::yampi::status > probe_test(
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Status mpi_status;
     int flag;
     auto const error_code
@@ -73,6 +77,7 @@ namespace yampi
   inline boost::optional< ::yampi::status > probe_test(
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Status mpi_status;
     int flag;
     auto const error_code
@@ -93,6 +98,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     int flag;
     auto const error_code
       = MPI_Iprobe(
@@ -108,6 +114,7 @@ namespace yampi
     ::yampi::ignore_status_t const ignore_status,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     int flag;
     auto const error_code
       = MPI_Iprobe(
@@ -123,6 +130,7 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     int flag;
     auto const error_code
       = MPI_Iprobe(
@@ -138,6 +146,7 @@ namespace yampi
     ::yampi::ignore_status_t const ignore_status,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     int flag;
     auto const error_code
       = MPI_Iprobe(
@@ -154,6 +163,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     int flag;
@@ -174,6 +184,7 @@ namespace yampi
     ::yampi::return_message_t const return_message,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     int flag;
@@ -194,6 +205,7 @@ namespace yampi
     ::yampi::return_message_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     int flag;
@@ -214,6 +226,7 @@ namespace yampi
     ::yampi::return_message_t const return_message,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     int flag;
@@ -235,6 +248,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     int flag;
     auto const error_code
@@ -253,6 +267,7 @@ namespace yampi
     ::yampi::return_message_t const return_message, ::yampi::ignore_status_t const ignore_status,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     int flag;
     auto const error_code
@@ -271,6 +286,7 @@ namespace yampi
     ::yampi::return_message_t const, ::yampi::ignore_status_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     int flag;
     auto const error_code
@@ -289,6 +305,7 @@ namespace yampi
     ::yampi::return_message_t const return_message, ::yampi::ignore_status_t const ignore_status,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_test", 0u);
     MPI_Message mpi_message;
     int flag;
     auto const error_code
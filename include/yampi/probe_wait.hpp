@@ -12,6 +12,7 @@
 # include <yampi/status.hpp>
 # include <yampi/error.hpp>
 # include <yampi/message.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -20,6 +21,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Status mpi_status;
     auto const error_code
       = MPI_Probe(source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), std::addressof(mpi_status));
@@ -33,6 +35,7 @@ namespace yampi
     ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Status mpi_status;
     auto const error_code
       = MPI_Probe(source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(mpi_status));
@@ -46,6 +49,7 @@ namespace yampi
     ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Status mpi_status;
     auto const error_code
       = MPI_Probe(MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), std::addressof(mpi_status));
@@ -57,6 +61,7 @@ namespace yampi
 
   inline ::yampi::status probe_wait(::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Status mpi_status;
     auto const error_code
       = MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(mpi_status));
@@ -72,6 +77,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     auto const error_code
       = MPI_Probe(source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 
@@ -83,6 +89,7 @@ namespace yampi
     ::yampi::ignore_status_t const ignore_status,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     auto const error_code
       = MPI_Probe(source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 
@@ -94,6 +101,7 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     auto const error_code
       = MPI_Probe(MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 
@@ -105,6 +113,7 @@ namespace yampi
     ::yampi::ignore_status_t const ignore_status,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     auto const error_code
       = MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 
@@ -117,6 +126,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     auto const error_code
@@ -134,6 +144,7 @@ namespace yampi
     ::yampi::return_message_t const return_message,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     auto const error_code
@@ -151,6 +162,7 @@ namespace yampi
     ::yampi::return_message_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     auto const error_code
@@ -168,6 +180,7 @@ namespace yampi
     ::yampi::return_message_t const return_message,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     MPI_Status mpi_status;
     auto const error_code
@@ -186,6 +199,7 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     auto const error_code
       = MPI_Mprobe(
@@ -201,6 +215,7 @@ namespace yampi
     ::yampi::return_message_t const return_message, ::yampi::ignore_status_t const ignore_status,
     ::yampi::rank const source, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     auto const error_code
       = MPI_Mprobe(
@@ -216,6 +231,7 @@ namespace yampi
     ::yampi::return_message_t const, ::yampi::ignore_status_t const,
     ::yampi::tag const tag, ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     auto const error_code
       = MPI_Mprobe(
@@ -231,6 +247,7 @@ namespace yampi
     ::yampi::return_message_t const return_message, ::yampi::ignore_status_t const ignore_status,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::probe_wait", 0u);
     MPI_Message mpi_message;
     auto const error_code
       = MPI_Mprobe(
@@ -0,0 +1,113 @@
+#ifndef YAMPI_PROFILER_HPP
+# define YAMPI_PROFILER_HPP
+
+# include <cstddef>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/count.hpp>
+# include <yampi/datatype.hpp>
+# include <yampi/predefined_datatype.hpp>
+
+
+// Opt-in profiling hook.
+//
+// Define YAMPI_PROFILER as the name of a policy type before including any yampi header, e.g.
+//
+//   struct my_profiler
+//   {
+//     static void begin(::yampi::profiler::event const& event);
+//     static void end(::yampi::profiler::event const& event) noexcept;
+//   };
+//   # define YAMPI_PROFILER my_profiler
+//   # include <yampi/send.hpp>
+//
+// The policy must be declared before the first yampi header. Every communication function, wait and test of requests,
+// and creation of communicators and windows then calls my_profiler::begin on entry and my_profiler::end on exit (also
+// when an exception is thrown).
+// RMA epochs of lock_guard, access_guard and exposure_guard are reported in the same way,
+// from the end of their constructors to their destructors.
+// Without YAMPI_PROFILER, YAMPI_PROFILE_SCOPE expands to nothing and its arguments are not evaluated.
+namespace yampi
+{
+  namespace profiler
+  {
+    struct event
+    {
+      // the same string passed to ::yampi::error, e.g. "yampi::send"
+      char const* where;
+      // count() * datatype().size() of the first buffer argument, or 0 if the function has no buffer
+      std::size_t num_bytes;
+    };
+
+    template <typename Profiler>
+    class scoped_event
+    {
+      ::yampi::profiler::event event_;
+
+     public:
+      scoped_event(char const* where, std::size_t const num_bytes)
+        : event_{where, num_bytes}
+      { Profiler::begin(event_); }
+
+      ~scoped_event() noexcept { Profiler::end(event_); }
+
+      scoped_event(scoped_event const&) = delete;
+      scoped_event& operator=(scoped_event const&) = delete;
+      scoped_event(scoped_event&&) = delete;
+      scoped_event& operator=(scoped_event&&) = delete;
+    }; // class scoped_event<Profiler>
+
+    namespace profiler_detail
+    {
+      inline std::size_t to_size(int const count) noexcept
+      { return static_cast<std::size_t>(count); }
+
+      inline std::size_t to_size(::yampi::count const& count) noexcept
+      { return static_cast<std::size_t>(count.mpi_count()); }
+
+      // large_count() of ::yampi::buffer<T> and ::yampi::target_buffer<T> before MPI-4 (see <yampi/large_count.hpp>)
+      template <typename Buffer>
+      inline auto count_of(Buffer const& buffer, int) noexcept
+        -> decltype(static_cast<std::size_t>(buffer.large_count()))
+      { return static_cast<std::size_t>(buffer.large_count()); }
+
+      template <typename Buffer>
+      inline std::size_t count_of(Buffer const& buffer, long) noexcept
+      { return ::yampi::profiler::profiler_detail::to_size(buffer.count()); }
+
+      inline std::size_t datatype_size(::yampi::datatype const& datatype, ::yampi::environment const& environment)
+      { return ::yampi::profiler::profiler_detail::to_size(datatype.size(environment)); }
+
+      template <typename T>
+      inline constexpr std::size_t datatype_size(
+        ::yampi::predefined_datatype<T> const&, ::yampi::environment const&) noexcept
+      { return sizeof(T); }
+    } // namespace profiler_detail
+
+    // Buffer is ::yampi::buffer<T>, or anything else having count() and datatype()
+    template <typename Buffer>
+    inline std::size_t num_bytes(Buffer const& buffer, ::yampi::environment const& environment)
+    {
+      return ::yampi::profiler::profiler_detail::count_of(buffer, 0)
+        * ::yampi::profiler::profiler_detail::datatype_size(buffer.datatype(), environment);
+    }
+  } // namespace profiler
+} // namespace yampi
+
+
+# ifdef YAMPI_PROFILER
+#   define YAMPI_PROFILE_SCOPE(where, num_bytes) \
+  ::yampi::profiler::scoped_event<YAMPI_PROFILER> const yampi_profiler_scoped_event_{where, num_bytes}
+// for events spanning several calls, such as RMA epochs of lock_guard, access_guard and exposure_guard
+#   define YAMPI_PROFILE_BEGIN(where) YAMPI_PROFILER::begin(::yampi::profiler::event{where, 0u})
+#   define YAMPI_PROFILE_END(where) YAMPI_PROFILER::end(::yampi::profiler::event{where, 0u})
+# else // YAMPI_PROFILER
+#   define YAMPI_PROFILE_SCOPE(where, num_bytes)
+#   define YAMPI_PROFILE_BEGIN(where)
+#   define YAMPI_PROFILE_END(where)
+# endif // YAMPI_PROFILER
+
+
+#endif
@@ -15,6 +15,9 @@
 # include <yampi/message.hpp>
 # include <yampi/immediate_request.hpp>
 # include <yampi/persistent_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/datatype_layout.hpp>
+# include <yampi/large_count.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/partitioned_request.hpp>
 #   include <yampi/partitioned_buffer.hpp>
@@ -30,6 +33,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(*bytes, source, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -37,9 +45,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION >= 4
     return error_code == MPI_SUCCESS
@@ -52,6 +61,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(*bytes, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -59,9 +73,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION >= 4
     return error_code == MPI_SUCCESS
@@ -74,6 +89,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(*bytes, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -81,9 +101,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION >= 4
     return error_code == MPI_SUCCESS
@@ -96,6 +117,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(*bytes, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -103,9 +129,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION >= 4
     return error_code == MPI_SUCCESS
@@ -119,6 +146,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::message& message,
     ::yampi::environment const& environment)
   {
+#   ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(*bytes, message, environment);
+#   endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 #   if MPI_VERSION >= 4
     auto const error_code
@@ -126,9 +158,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           std::addressof(message.mpi_message()), std::addressof(stat));
 #   else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Mrecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           std::addressof(message.mpi_message()), std::addressof(stat));
 #   endif // MPI_VERSION >= 4
     return error_code == MPI_SUCCESS
@@ -144,15 +177,21 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(::yampi::ignore_status, *bytes, source, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Recv_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -165,15 +204,21 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(::yampi::ignore_status, *bytes, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Recv_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -186,15 +231,21 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(::yampi::ignore_status, *bytes, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Recv_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -207,15 +258,21 @@ namespace yampi
     ::yampi::buffer<Value> buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(::yampi::ignore_status, *bytes, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Recv_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -229,15 +286,21 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::message& message,
     ::yampi::environment const& environment)
   {
+#   ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(::yampi::ignore_status, *bytes, message, environment);
+#   endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
 #   if MPI_VERSION >= 4
     auto const error_code
       = MPI_Mrecv_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           std::addressof(message.mpi_message()), MPI_STATUS_IGNORE);
 #   else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Mrecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           std::addressof(message.mpi_message()), MPI_STATUS_IGNORE);
 #   endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -252,6 +315,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, source, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -260,9 +328,10 @@ namespace yampi
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Irecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -277,6 +346,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -285,9 +359,10 @@ namespace yampi
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Irecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -302,6 +377,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -310,9 +390,10 @@ namespace yampi
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Irecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -326,6 +407,11 @@ namespace yampi
     ::yampi::immediate_request& request, ::yampi::buffer<Value> buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -334,9 +420,10 @@ namespace yampi
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Irecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -352,6 +439,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::message& message,
     ::yampi::environment const& environment)
   {
+#   ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, message, environment);
+#   endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 #   if MPI_VERSION >= 4
     auto const error_code
@@ -359,9 +451,10 @@ namespace yampi
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           std::addressof(message.mpi_message()), std::addressof(mpi_request));
 #   else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Imrecv(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           std::addressof(message.mpi_message()), std::addressof(mpi_request));
 #   endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -377,6 +470,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, source, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -385,9 +483,10 @@ namespace yampi
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv_init(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -402,6 +501,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -410,9 +514,10 @@ namespace yampi
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv_init(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -427,6 +532,11 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -435,9 +545,10 @@ namespace yampi
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv_init(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -451,6 +562,11 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::buffer<Value> buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::receive(request, *bytes, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::receive", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -459,9 +575,10 @@ namespace yampi
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 4
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Recv_init(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -479,6 +596,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::receive", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Precv_init(
@@ -497,6 +615,7 @@ namespace yampi
     ::yampi::partitioned_buffer<Value> buffer, ::yampi::rank const source, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::receive", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Precv_init(
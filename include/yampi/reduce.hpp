@@ -2,6 +2,7 @@
 # define YAMPI_REDUCE_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <type_traits>
 # include <iterator>
 # include <memory>
@@ -18,6 +19,9 @@
 # include <yampi/error.hpp>
 # include <yampi/nonroot_call_on_root_error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/load_imbalance.hpp>
+# include <yampi/large_count.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -34,13 +38,15 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -51,16 +57,21 @@ namespace yampi
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
     auto const error_code
-      = MPI_Reduce(
-          send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          send_buffer.large_count(),
+          [&send_buffer, first, &operation, root, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Reduce(
+              send_buffer.data() + offset, std::addressof(*first) + offset,
+              count, send_buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+          });
 # else //MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Reduce(
           const_cast<value_type*>(send_buffer.data()), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # endif //MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -73,6 +84,8 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::reduce"};
 
@@ -84,16 +97,21 @@ namespace yampi
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
     auto const error_code
-      = MPI_Reduce(
-          send_buffer.data(), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          send_buffer.large_count(),
+          [&send_buffer, &operation, root, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Reduce(
+              send_buffer.data() + offset, nullptr,
+              count, send_buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+          });
 # else //MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Reduce(
           const_cast<value_type*>(send_buffer.data()), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # endif //MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -106,6 +124,8 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = communicator.rank(environment) == root
@@ -116,14 +136,20 @@ namespace yampi
             buffer.data(), nullptr, buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
             operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 4
-    auto const error_code
-      = communicator.rank(environment) == root
-        ? MPI_Reduce(
-            MPI_IN_PLACE, buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
-            operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm())
-        : MPI_Reduce(
-            buffer.data(), nullptr, buffer.count(), buffer.datatype().mpi_datatype(),
-            operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+    auto const is_root = communicator.rank(environment) == root;
+    auto const error_code
+      = ::yampi::large_count_detail::for_each_chunk(
+          buffer.large_count(),
+          [&buffer, &operation, root, &communicator, is_root](std::ptrdiff_t const offset, int const count)
+          {
+            return is_root
+              ? MPI_Reduce(
+                  MPI_IN_PLACE, buffer.data() + offset, count, buffer.datatype().mpi_datatype(),
+                  operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm())
+              : MPI_Reduce(
+                  buffer.data() + offset, nullptr, count, buffer.datatype().mpi_datatype(),
+                  operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+          });
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error{error_code, "yampi::reduce", environment};
@@ -136,6 +162,8 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Reduce_c(
@@ -144,16 +172,21 @@ namespace yampi
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
     auto const error_code
-      = MPI_Reduce(
-          send_buffer.data(), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          send_buffer.large_count(),
+          [&send_buffer, &operation, root, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Reduce(
+              send_buffer.data() + offset, nullptr,
+              count, send_buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
+          });
 # else //MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Reduce(
           const_cast<value_type*>(send_buffer.data()), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm());
 # endif //MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -166,6 +199,8 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(receive_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Reduce_c(
@@ -174,10 +209,15 @@ namespace yampi
           operation.mpi_op(), MPI_ROOT, communicator.mpi_comm());
 # else // MPI_VERSION >= 4
     auto const error_code
-      = MPI_Reduce(
-          nullptr, receive_buffer.data(),
-          receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
-          operation.mpi_op(), MPI_ROOT, communicator.mpi_comm());
+      = ::yampi::large_count_detail::for_each_chunk(
+          receive_buffer.large_count(),
+          [&receive_buffer, &operation, &communicator](std::ptrdiff_t const offset, int const count)
+          {
+            return MPI_Reduce(
+              nullptr, receive_buffer.data() + offset,
+              count, receive_buffer.datatype().mpi_datatype(),
+              operation.mpi_op(), MPI_ROOT, communicator.mpi_comm());
+          });
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error{error_code, "yampi::reduce", environment};
@@ -185,6 +225,8 @@ namespace yampi
 
   inline void reduce(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_MEASURE_LOAD_IMBALANCE("yampi::reduce", communicator, environment);
+    YAMPI_PROFILE_SCOPE("yampi::reduce", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Reduce_c(
@@ -209,13 +251,14 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count().mpi_count() <= send_buffer.data());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.count() <= send_buffer.data());
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + send_buffer.large_count() <= send_buffer.data());
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -230,7 +273,7 @@ namespace yampi
     auto const error_code
       = MPI_Ireduce(
           send_buffer.data(), std::addressof(*first),
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -246,6 +289,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::reduce"};
 
@@ -261,7 +305,7 @@ namespace yampi
     auto const error_code
       = MPI_Ireduce(
           send_buffer.data(), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -277,6 +321,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -293,11 +338,11 @@ namespace yampi
     auto const error_code
       = communicator.rank(environment) == root
         ? MPI_Ireduce(
-            MPI_IN_PLACE, buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+            MPI_IN_PLACE, buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
             operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm(),
             std::addressof(mpi_request))
         : MPI_Ireduce(
-            buffer.data(), nullptr, buffer.count(), buffer.datatype().mpi_datatype(),
+            buffer.data(), nullptr, buffer.count(environment), buffer.datatype().mpi_datatype(),
             operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm(),
             std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -313,6 +358,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -325,7 +371,7 @@ namespace yampi
     auto const error_code
       = MPI_Ireduce(
           send_buffer.data(), nullptr,
-          send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), root.mpi_rank(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -340,6 +386,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::binary_operation const& operation,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -352,7 +399,7 @@ namespace yampi
     auto const error_code
       = MPI_Ireduce(
           nullptr, receive_buffer.data(),
-          receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), MPI_ROOT, communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
@@ -365,6 +412,7 @@ namespace yampi
     ::yampi::immediate_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -395,6 +443,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -420,6 +469,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::reduce"};
 
@@ -443,6 +493,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = communicator.rank(environment) == root
@@ -467,6 +518,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -486,6 +538,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -502,6 +555,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -522,6 +576,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to SendValue");
@@ -546,6 +601,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::reduce"};
 
@@ -568,6 +624,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = communicator.rank(environment) == root
@@ -591,6 +648,7 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::binary_operation const& operation, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -609,6 +667,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::binary_operation const& operation,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -625,6 +684,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Reduce_init_c(
@@ -0,0 +1,292 @@
+#ifndef YAMPI_REDUCE_LOCAL_HPP
+# define YAMPI_REDUCE_LOCAL_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <type_traits>
+# if defined(__AVX2__) or defined(__AVX512F__)
+#   include <immintrin.h>
+# endif
+
+# include <mpi.h>
+
+# include <yampi/buffer.hpp>
+# include <yampi/binary_operation.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/detail/restrict.hpp>
+
+
+// Local reduction.
+//
+// ::yampi::reduce_local(in_buffer, inout_buffer, operation, environment) computes inout = in op inout elementwise, as
+// MPI_Reduce_local. Sums, products, maxima and minima of float, double and int are computed by the kernels below,
+// vectorized with AVX-512 or AVX2 if the code is compiled for them (e.g. -mavx512f or -mavx2) and with loops the
+// compiler can vectorize otherwise; the other combinations are passed to MPI_Reduce_local. Each element is computed by
+// a single addition, multiplication or comparison as in MPI_Reduce_local, so vectorization doesn't change results.
+//
+// The user-space collectives (<yampi/collective_algorithm.hpp>) and the two-level all_reduce reduce with these kernels.
+namespace yampi
+{
+  namespace reduce_local_detail
+  {
+# if defined(__AVX512F__)
+    // Maxima and minima are computed by the zero-masking intrinsics with full masks because GCC warns the unmasked
+    // ones of uninitialized variables
+    template <typename Value>
+    struct simd;
+
+    template <>
+    struct simd<float>
+    {
+      using type = __m512;
+      static constexpr std::size_t width = 16u;
+      static type load(float const* data) noexcept { return _mm512_loadu_ps(data); }
+      static void store(float* data, type const value) noexcept { _mm512_storeu_ps(data, value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm512_add_ps(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm512_mul_ps(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm512_maskz_max_ps(0xFFFF, lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm512_maskz_min_ps(0xFFFF, lhs, rhs); }
+    };
+
+    template <>
+    struct simd<double>
+    {
+      using type = __m512d;
+      static constexpr std::size_t width = 8u;
+      static type load(double const* data) noexcept { return _mm512_loadu_pd(data); }
+      static void store(double* data, type const value) noexcept { _mm512_storeu_pd(data, value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm512_add_pd(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm512_mul_pd(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm512_maskz_max_pd(0xFF, lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm512_maskz_min_pd(0xFF, lhs, rhs); }
+    };
+
+    template <>
+    struct simd<int>
+    {
+      using type = __m512i;
+      static constexpr std::size_t width = 16u;
+      static type load(int const* data) noexcept { return _mm512_loadu_si512(data); }
+      static void store(int* data, type const value) noexcept { _mm512_storeu_si512(data, value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm512_add_epi32(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm512_mullo_epi32(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm512_maskz_max_epi32(0xFFFF, lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm512_maskz_min_epi32(0xFFFF, lhs, rhs); }
+    };
+#   define YAMPI_REDUCE_LOCAL_HAS_SIMD
+# elif defined(__AVX2__)
+    template <typename Value>
+    struct simd;
+
+    template <>
+    struct simd<float>
+    {
+      using type = __m256;
+      static constexpr std::size_t width = 8u;
+      static type load(float const* data) noexcept { return _mm256_loadu_ps(data); }
+      static void store(float* data, type const value) noexcept { _mm256_storeu_ps(data, value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm256_max_ps(lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm256_min_ps(lhs, rhs); }
+    };
+
+    template <>
+    struct simd<double>
+    {
+      using type = __m256d;
+      static constexpr std::size_t width = 4u;
+      static type load(double const* data) noexcept { return _mm256_loadu_pd(data); }
+      static void store(double* data, type const value) noexcept { _mm256_storeu_pd(data, value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm256_add_pd(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm256_mul_pd(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm256_max_pd(lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm256_min_pd(lhs, rhs); }
+    };
+
+    template <>
+    struct simd<int>
+    {
+      using type = __m256i;
+      static constexpr std::size_t width = 8u;
+      static type load(int const* data) noexcept { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data)); }
+      static void store(int* data, type const value) noexcept
+      { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value); }
+      static type plus(type const lhs, type const rhs) noexcept { return _mm256_add_epi32(lhs, rhs); }
+      static type multiplies(type const lhs, type const rhs) noexcept { return _mm256_mullo_epi32(lhs, rhs); }
+      static type maximum(type const lhs, type const rhs) noexcept { return _mm256_max_epi32(lhs, rhs); }
+      static type minimum(type const lhs, type const rhs) noexcept { return _mm256_min_epi32(lhs, rhs); }
+    };
+#   define YAMPI_REDUCE_LOCAL_HAS_SIMD
+# endif
+
+    // The scalar operations must give the same results as the vector ones (e.g. _mm256_max_ps(lhs, rhs) returns rhs
+    // if either is NaN)
+    struct plus
+    {
+      // to wrap around as the vector addition instead of overflowing
+      template <typename Value>
+      static Value apply(Value const lhs, Value const rhs) noexcept
+      {
+        using unsigned_value = typename std::make_unsigned<Value>::type;
+        return static_cast<Value>(static_cast<unsigned_value>(lhs) + static_cast<unsigned_value>(rhs));
+      }
+
+      static float apply(float const lhs, float const rhs) noexcept { return lhs + rhs; }
+      static double apply(double const lhs, double const rhs) noexcept { return lhs + rhs; }
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+      template <typename Value>
+      static typename simd<Value>::type apply_simd(
+        typename simd<Value>::type const lhs, typename simd<Value>::type const rhs) noexcept
+      { return simd<Value>::plus(lhs, rhs); }
+# endif
+    };
+
+    struct multiplies
+    {
+      // to wrap around as the vector multiplication instead of overflowing
+      template <typename Value>
+      static Value apply(Value const lhs, Value const rhs) noexcept
+      {
+        using unsigned_value = typename std::make_unsigned<Value>::type;
+        return static_cast<Value>(static_cast<unsigned_value>(lhs) * static_cast<unsigned_value>(rhs));
+      }
+
+      static float apply(float const lhs, float const rhs) noexcept { return lhs * rhs; }
+      static double apply(double const lhs, double const rhs) noexcept { return lhs * rhs; }
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+      template <typename Value>
+      static typename simd<Value>::type apply_simd(
+        typename simd<Value>::type const lhs, typename simd<Value>::type const rhs) noexcept
+      { return simd<Value>::multiplies(lhs, rhs); }
+# endif
+    };
+
+    struct maximum
+    {
+      template <typename Value>
+      static Value apply(Value const lhs, Value const rhs) noexcept { return lhs > rhs ? lhs : rhs; }
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+      template <typename Value>
+      static typename simd<Value>::type apply_simd(
+        typename simd<Value>::type const lhs, typename simd<Value>::type const rhs) noexcept
+      { return simd<Value>::maximum(lhs, rhs); }
+# endif
+    };
+
+    struct minimum
+    {
+      template <typename Value>
+      static Value apply(Value const lhs, Value const rhs) noexcept { return lhs < rhs ? lhs : rhs; }
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+      template <typename Value>
+      static typename simd<Value>::type apply_simd(
+        typename simd<Value>::type const lhs, typename simd<Value>::type const rhs) noexcept
+      { return simd<Value>::minimum(lhs, rhs); }
+# endif
+    };
+
+    template <typename Operation, typename Value>
+    inline void apply(Value const* YAMPI_RESTRICT in, Value* YAMPI_RESTRICT inout, std::size_t const count) noexcept
+    {
+      auto index = std::size_t{0u};
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+      for (; index + simd<Value>::width <= count; index += simd<Value>::width)
+        simd<Value>::store(
+          inout + index,
+          Operation::template apply_simd<Value>(simd<Value>::load(in + index), simd<Value>::load(inout + index)));
+# endif
+      for (; index < count; ++index)
+        inout[index] = Operation::apply(in[index], inout[index]);
+    }
+
+    template <typename Value>
+    inline bool apply(Value const* in, Value* inout, std::size_t const count, MPI_Op const mpi_op) noexcept
+    {
+      if (mpi_op == MPI_SUM)
+        ::yampi::reduce_local_detail::apply< ::yampi::reduce_local_detail::plus >(in, inout, count);
+      else if (mpi_op == MPI_PROD)
+        ::yampi::reduce_local_detail::apply< ::yampi::reduce_local_detail::multiplies >(in, inout, count);
+      else if (mpi_op == MPI_MAX)
+        ::yampi::reduce_local_detail::apply< ::yampi::reduce_local_detail::maximum >(in, inout, count);
+      else if (mpi_op == MPI_MIN)
+        ::yampi::reduce_local_detail::apply< ::yampi::reduce_local_detail::minimum >(in, inout, count);
+      else
+        return false;
+      return true;
+    }
+
+    // Returns false if no kernel is for mpi_datatype and mpi_op
+    inline bool apply_kernel(
+      void const* in, void* inout, std::size_t const count,
+      MPI_Datatype const mpi_datatype, MPI_Op const mpi_op) noexcept
+    {
+      if (mpi_datatype == MPI_FLOAT)
+        return ::yampi::reduce_local_detail::apply(
+          static_cast<float const*>(in), static_cast<float*>(inout), count, mpi_op);
+      if (mpi_datatype == MPI_DOUBLE)
+        return ::yampi::reduce_local_detail::apply(
+          static_cast<double const*>(in), static_cast<double*>(inout), count, mpi_op);
+      if (mpi_datatype == MPI_INT)
+        return ::yampi::reduce_local_detail::apply(
+          static_cast<int const*>(in), static_cast<int*>(inout), count, mpi_op);
+      return false;
+    }
+
+    // inout = in op inout for count elements of mpi_datatype
+    template <typename Count>
+    inline void reduce_local(
+      void const* in, void* inout, Count const count, MPI_Datatype const mpi_datatype, MPI_Op const mpi_op,
+      ::yampi::environment const& environment)
+    {
+      if (count == Count{0}
+          or ::yampi::reduce_local_detail::apply_kernel(
+               in, inout, static_cast<std::size_t>(count), mpi_datatype, mpi_op))
+        return;
+
+# if MPI_VERSION >= 4
+      auto const error_code = MPI_Reduce_local_c(in, inout, static_cast<MPI_Count>(count), mpi_datatype, mpi_op);
+# elif MPI_VERSION >= 3
+      auto const error_code = MPI_Reduce_local(in, inout, static_cast<int>(count), mpi_datatype, mpi_op);
+# else // MPI_VERSION >= 3
+      auto const error_code
+        = MPI_Reduce_local(const_cast<void*>(in), inout, static_cast<int>(count), mpi_datatype, mpi_op);
+# endif // MPI_VERSION >= 3
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::reduce_local", environment};
+    }
+  } // namespace reduce_local_detail
+
+  template <typename Value>
+  inline void reduce_local(
+    ::yampi::buffer<Value> const in_buffer, ::yampi::buffer<Value> inout_buffer,
+    ::yampi::binary_operation const& operation, ::yampi::environment const& environment)
+  {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_local", ::yampi::profiler::num_bytes(in_buffer, environment));
+    assert(in_buffer.count(environment) == inout_buffer.count(environment));
+# if MPI_VERSION >= 4
+    assert(
+      in_buffer.data() + in_buffer.count().mpi_count() <= inout_buffer.data()
+      or inout_buffer.data() + inout_buffer.count().mpi_count() <= in_buffer.data());
+    ::yampi::reduce_local_detail::reduce_local(
+      in_buffer.data(), inout_buffer.data(), inout_buffer.count().mpi_count(), inout_buffer.datatype().mpi_datatype(),
+      operation.mpi_op(), environment);
+# else // MPI_VERSION >= 4
+    assert(
+      in_buffer.data() + in_buffer.large_count() <= inout_buffer.data()
+      or inout_buffer.data() + inout_buffer.large_count() <= in_buffer.data());
+    ::yampi::reduce_local_detail::reduce_local(
+      in_buffer.data(), inout_buffer.data(), inout_buffer.count(environment), inout_buffer.datatype().mpi_datatype(),
+      operation.mpi_op(), environment);
+# endif // MPI_VERSION >= 4
+  }
+}
+
+
+# ifdef YAMPI_REDUCE_LOCAL_HAS_SIMD
+#   undef YAMPI_REDUCE_LOCAL_HAS_SIMD
+# endif
+
+#endif
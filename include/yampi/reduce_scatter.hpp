@@ -4,6 +4,8 @@
 # include <cassert>
 # include <type_traits>
 # include <iterator>
+# include <algorithm>
+# include <vector>
 # include <memory>
 
 # include <mpi.h>
@@ -11,11 +13,16 @@
 # include <yampi/buffer.hpp>
 # include <yampi/communicator_base.hpp>
 # include <yampi/communicator.hpp>
+# include <yampi/binary_operation.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/in_place.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/collective_algorithm.hpp>
+# include <yampi/collective_autotuner.hpp>
+# include <yampi/scratch_buffer.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -31,6 +38,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to Value");
@@ -38,8 +46,8 @@ namespace yampi
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment));
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
-    assert(send_buffer.count() == communicator.size(environment));
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
+    assert(send_buffer.large_count() == communicator.size(environment));
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -69,14 +77,15 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment) * receive_buffer.count().mpi_count());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
-    assert(send_buffer.count() == communicator.size(environment) * receive_buffer.count());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
+    assert(send_buffer.large_count() == communicator.size(environment) * receive_buffer.large_count());
 # endif // MPI_VERSION >= 4
-    assert(send_buffer.datatype() == receive_buffer.datatype());
+    assert(send_buffer.datatype().mpi_datatype() == receive_buffer.datatype().mpi_datatype());
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -86,13 +95,13 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Reduce_scatter_block(
-          send_buffer.data(), receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Reduce_scatter_block(
-          const_cast<value_type*>(send_buffer.data()), receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -105,9 +114,10 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = buffer.count() / size;
-    assert(receive_count * size == buffer.count());
+    auto const receive_count = buffer.count(environment) / size;
+    assert(receive_count * size == buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -137,6 +147,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to Value");
@@ -144,8 +155,8 @@ namespace yampi
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment));
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
-    assert(send_buffer.count() == communicator.size(environment));
+    assert(send_buffer.data() + send_buffer.large_count() <= std::addressof(*first) or std::addressof(*first) + 1 <= send_buffer.data());
+    assert(send_buffer.large_count() == communicator.size(environment));
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -172,14 +183,15 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment) * receive_buffer.count().mpi_count());
 # else // MPI_VERSION >= 4
-    assert(send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data());
-    assert(send_buffer.count() == communicator.size(environment) * receive_buffer.count());
+    assert(send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data());
+    assert(send_buffer.large_count() == communicator.size(environment) * receive_buffer.large_count());
 # endif // MPI_VERSION >= 4
-    assert(send_buffer.datatype() == receive_buffer.datatype());
+    assert(send_buffer.datatype().mpi_datatype() == receive_buffer.datatype().mpi_datatype());
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -190,7 +202,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Ireduce_scatter_block(
-          send_buffer.data(), receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           operation.mpi_op(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -205,9 +217,10 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = buffer.count() / size;
-    assert(receive_count * size == buffer.count());
+    auto const receive_count = buffer.count(environment) / size;
+    assert(receive_count * size == buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -235,6 +248,7 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to Value");
@@ -258,9 +272,10 @@ namespace yampi
     ::yampi::binary_operation const& operation, ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment) * receive_buffer.count().mpi_count());
-    assert(send_buffer.datatype() == receive_buffer.datatype());
+    assert(send_buffer.datatype().mpi_datatype() == receive_buffer.datatype().mpi_datatype());
 
     MPI_Request mpi_request;
     auto const error_code
@@ -280,9 +295,10 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = buffer.count() / size;
-    assert(receive_count * size == buffer.count());
+    auto const receive_count = buffer.count(environment) / size;
+    assert(receive_count * size == buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -302,6 +318,7 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, typename std::remove_cv<SendValue>::type>::value,
       "value_type of ContiguousIterator must be the same to Value");
@@ -325,9 +342,10 @@ namespace yampi
     ::yampi::binary_operation const& operation,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data());
     assert(send_buffer.count().mpi_count() == communicator.size(environment) * receive_buffer.count().mpi_count());
-    assert(send_buffer.datatype() == receive_buffer.datatype());
+    assert(send_buffer.datatype().mpi_datatype() == receive_buffer.datatype().mpi_datatype());
 
     MPI_Request mpi_request;
     auto const error_code
@@ -346,9 +364,10 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::binary_operation const& operation,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(buffer, environment));
     auto const size = communicator.size(environment);
-    auto const receive_count = buffer.count() / size;
-    assert(receive_count * size == buffer.count());
+    auto const receive_count = buffer.count(environment) / size;
+    assert(receive_count * size == buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -360,6 +379,93 @@ namespace yampi
     request.reset(mpi_request, environment);
   }
 # endif // MPI_VERSION >= 4
+  // Reduce-scatter by the algorithm in user space (see <yampi/collective_algorithm.hpp>)
+  // only for intracommunicators
+  template <typename Value>
+  inline void reduce_scatter(
+    ::yampi::collective_algorithm const algorithm,
+    ::yampi::buffer<Value> const send_buffer, ::yampi::buffer<Value> receive_buffer,
+    ::yampi::binary_operation const& operation,
+    ::yampi::communicator const& communicator, ::yampi::environment const& environment)
+  {
+    if (algorithm == ::yampi::collective_algorithm::library)
+    {
+      ::yampi::reduce_scatter(send_buffer, receive_buffer, operation, communicator, environment);
+      return;
+    }
+
+    if (algorithm == ::yampi::collective_algorithm::autotuned)
+    {
+      auto const selected
+        = ::yampi::collective_autotuner::of(communicator, environment).select(
+            ::yampi::collective_autotuner::make_key(
+              "reduce_scatter", send_buffer.datatype().mpi_datatype(), operation.mpi_op(),
+              ::yampi::profiler::num_bytes(send_buffer, environment), communicator, environment),
+            [&](::yampi::collective_algorithm const candidate)
+            { ::yampi::reduce_scatter(candidate, send_buffer, receive_buffer, operation, communicator, environment); },
+            communicator, environment);
+      ::yampi::reduce_scatter(selected, send_buffer, receive_buffer, operation, communicator, environment);
+      return;
+    }
+
+    YAMPI_PROFILE_SCOPE("yampi::reduce_scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
+    namespace detail = ::yampi::collective_algorithm_detail;
+    auto const count = detail::count_of(receive_buffer, environment);
+    auto const rank = communicator.rank(environment).mpi_rank();
+    auto const size = communicator.size(environment);
+    auto const total_count = detail::count_of(send_buffer, environment);
+    assert(total_count == size * count);
+
+    using value_type = typename std::remove_cv<Value>::type;
+    ::yampi::scratch_buffer<value_type> work(total_count);
+    std::copy(send_buffer.data(), send_buffer.data() + total_count, work.begin());
+    auto const buffer = detail::make_buffer_like(send_buffer, work.begin(), work.end());
+    auto const offsets = detail::block_offsets(total_count, size);
+    auto const& algorithm_communicator = detail::communicator_of(communicator, environment);
+
+    switch (detail::algorithm_for(algorithm, operation, true, environment))
+    {
+     case ::yampi::collective_algorithm::ring:
+      detail::ring_reduce_scatter(buffer, offsets, operation, algorithm_communicator, environment);
+      break;
+     case ::yampi::collective_algorithm::recursive_doubling:
+     case ::yampi::collective_algorithm::rabenseifner:
+     {
+      auto const folded_rank = detail::fold(buffer, operation, algorithm_communicator, environment);
+      auto const folded_size = detail::largest_power_of_two(size);
+      auto const remainder = size - folded_size;
+      if (folded_rank < 0)
+      {
+        // the partner of the process reduces its block
+        ::yampi::receive(
+          ::yampi::ignore_status, receive_buffer, ::yampi::rank{rank + 1}, detail::tag, algorithm_communicator,
+          environment);
+        return;
+      }
+
+      // the folded process of folded rank index takes the blocks of the processes folded into it
+      std::vector<int> folded_offsets(folded_size + 1);
+      for (auto index = 0; index <= folded_size; ++index)
+        folded_offsets[index] = offsets[index < remainder ? 2 * index : index + remainder];
+      detail::recursive_halving_reduce_scatter(
+        buffer, folded_offsets, folded_rank, operation, algorithm_communicator, environment);
+      if (rank < 2 * remainder)
+        ::yampi::send(
+          detail::sub_buffer(buffer, offsets[rank - 1], offsets[rank]), ::yampi::rank{rank - 1}, detail::tag,
+          algorithm_communicator, environment);
+      break;
+     }
+     case ::yampi::collective_algorithm::binomial_tree:
+      detail::binomial_reduce(buffer, operation, algorithm_communicator, environment);
+      detail::binomial_scatter(buffer, offsets, ::yampi::rank{0}, algorithm_communicator, environment);
+      break;
+     case ::yampi::collective_algorithm::library:
+     case ::yampi::collective_algorithm::autotuned:
+      throw ::yampi::error{MPI_ERR_ARG, "yampi::reduce_scatter", environment};
+    }
+
+    std::copy(work.begin() + offsets[rank], work.begin() + offsets[rank + 1], receive_buffer.data());
+  }
 }
 
 
@@ -0,0 +1,312 @@
+#ifndef YAMPI_REMOTE_PTR_HPP
+# define YAMPI_REMOTE_PTR_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <type_traits>
+# include <utility>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/dynamic_window.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/target_buffer.hpp>
+# include <yampi/datatype.hpp>
+# include <yampi/has_predefined_datatype.hpp>
+# include <yampi/binary_operation.hpp>
+# include <yampi/address.hpp>
+# include <yampi/addressof.hpp>
+# include <yampi/byte_displacement.hpp>
+# include <yampi/displacement.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/error.hpp>
+# include <yampi/put.hpp>
+# include <yampi/get.hpp>
+# include <yampi/accumulate.hpp>
+# include <yampi/compare_swap.hpp>
+# include <yampi/fetch_operate.hpp>
+# include <yampi/detail/at_finalize.hpp>
+
+
+// Typed pointer to memory attached to a dynamic window.
+//
+// ::yampi::remote_ptr<T> is a pair of the rank of the owner and the address of the object in the owner, which is the
+// target displacement in dynamic windows. Obtain it with ::yampi::remote_addressof on the owner, and send it to other
+// processes with ::yampi::remote_ptr_datatype(environment), e.g.
+//
+//   auto const ptr = ::yampi::remote_addressof(node, present_rank, environment);
+//   auto const& ptr_datatype = ::yampi::remote_ptr_datatype(environment);
+//   ::yampi::send(::yampi::make_buffer(ptr, ptr_datatype), destination, tag, communicator, environment);
+//
+// Pointer arithmetic is in units of T, as for T*. The default value is null, pointing to MPI_PROC_NULL, so that RMA
+// operations through it do nothing.
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  template <typename T>
+  class remote_ptr
+  {
+    ::yampi::rank rank_;
+    ::yampi::address address_;
+
+   public:
+    using element_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr remote_ptr() noexcept
+      : rank_{::yampi::tags::null_process}, address_{}
+    { }
+
+    constexpr remote_ptr(::yampi::rank const rank, ::yampi::address const address) noexcept
+      : rank_{rank}, address_{address}
+    { }
+
+    remote_ptr(remote_ptr const&) = default;
+    remote_ptr& operator=(remote_ptr const&) = default;
+    remote_ptr(remote_ptr&&) = default;
+    remote_ptr& operator=(remote_ptr&&) = default;
+    ~remote_ptr() noexcept = default;
+
+    // T* to T const*
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    constexpr remote_ptr(::yampi::remote_ptr<U> const& other) noexcept
+      : rank_{other.rank()}, address_{other.address()}
+    { }
+
+    constexpr ::yampi::rank const& rank() const noexcept { return rank_; }
+    constexpr ::yampi::address const& address() const noexcept { return address_; }
+    // target displacement in dynamic windows
+    constexpr ::yampi::displacement displacement() const noexcept
+    { return ::yampi::displacement{address_.mpi_address()}; }
+
+    bool is_null() const noexcept { return rank_.is_null(); }
+    explicit operator bool() const noexcept { return not is_null(); }
+
+    remote_ptr& operator+=(difference_type const n)
+    {
+      address_ += ::yampi::byte_displacement{static_cast<MPI_Aint>(n * static_cast<difference_type>(sizeof(T)))};
+      return *this;
+    }
+
+    remote_ptr& operator-=(difference_type const n)
+    {
+      address_ -= ::yampi::byte_displacement{static_cast<MPI_Aint>(n * static_cast<difference_type>(sizeof(T)))};
+      return *this;
+    }
+
+    remote_ptr& operator++() { return *this += 1; }
+    remote_ptr& operator--() { return *this -= 1; }
+    remote_ptr operator++(int) { auto result = *this; ++*this; return result; }
+    remote_ptr operator--(int) { auto result = *this; --*this; return result; }
+
+    void swap(remote_ptr& other) noexcept
+    {
+      using std::swap;
+      swap(rank_, other.rank_);
+      swap(address_, other.address_);
+    }
+  };
+
+  template <typename T>
+  inline ::yampi::remote_ptr<T> operator+(::yampi::remote_ptr<T> ptr, std::ptrdiff_t const n)
+  { return ptr += n; }
+
+  template <typename T>
+  inline ::yampi::remote_ptr<T> operator+(std::ptrdiff_t const n, ::yampi::remote_ptr<T> ptr)
+  { return ptr += n; }
+
+  template <typename T>
+  inline ::yampi::remote_ptr<T> operator-(::yampi::remote_ptr<T> ptr, std::ptrdiff_t const n)
+  { return ptr -= n; }
+
+  // lhs and rhs must point to the same process
+  template <typename T>
+  inline std::ptrdiff_t operator-(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<T> const& rhs)
+  {
+    assert(lhs.rank() == rhs.rank());
+    return static_cast<std::ptrdiff_t>((lhs.address() - rhs.address()).mpi_byte_displacement())
+      / static_cast<std::ptrdiff_t>(sizeof(T));
+  }
+
+  template <typename T, typename U>
+  inline constexpr bool operator==(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  { return lhs.rank() == rhs.rank() and lhs.address() == rhs.address(); }
+
+  template <typename T, typename U>
+  inline constexpr bool operator!=(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  { return not (lhs == rhs); }
+
+  // ordered by rank, then by address, so that remote pointers can be keys of associative containers
+  template <typename T, typename U>
+  inline constexpr bool operator<(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  {
+    return lhs.rank().mpi_rank() < rhs.rank().mpi_rank()
+      or (lhs.rank() == rhs.rank() and lhs.address() < rhs.address());
+  }
+
+  template <typename T, typename U>
+  inline constexpr bool operator>(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  { return rhs < lhs; }
+
+  template <typename T, typename U>
+  inline constexpr bool operator<=(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  { return not (rhs < lhs); }
+
+  template <typename T, typename U>
+  inline constexpr bool operator>=(::yampi::remote_ptr<T> const& lhs, ::yampi::remote_ptr<U> const& rhs) noexcept
+  { return not (lhs < rhs); }
+
+  template <typename T>
+  inline void swap(::yampi::remote_ptr<T>& lhs, ::yampi::remote_ptr<T>& rhs) noexcept
+  { lhs.swap(rhs); }
+
+  // value must be in memory attached to a dynamic window; present_rank is the rank of the calling process in the
+  // communicator of the window
+  template <typename T>
+  inline ::yampi::remote_ptr<T> remote_addressof(
+    T& value, ::yampi::rank const present_rank, ::yampi::environment const& environment)
+  { return ::yampi::remote_ptr<T>{present_rank, ::yampi::addressof(value, environment)}; }
+
+  namespace remote_ptr_detail
+  {
+    inline ::yampi::datatype make_datatype(::yampi::environment const& environment)
+    {
+      using ptr_type = ::yampi::remote_ptr<char>;
+      static_assert(std::is_standard_layout<ptr_type>::value, "remote_ptr must be standard-layout");
+      static_assert(sizeof(::yampi::rank) == sizeof(int), "yampi::rank must have the same size as int");
+      static_assert(
+        sizeof(::yampi::address) == sizeof(MPI_Aint), "yampi::address must have the same size as MPI_Aint");
+
+      // rank_ is the first member, address_ follows with the alignment of MPI_Aint
+      int const block_lengths[2] = {1, 1};
+      MPI_Aint const displacements[2]
+        = {MPI_Aint{0},
+           static_cast<MPI_Aint>((sizeof(int) + alignof(MPI_Aint) - 1u) / alignof(MPI_Aint) * alignof(MPI_Aint))};
+      MPI_Datatype const mpi_datatypes[2] = {MPI_INT, MPI_AINT};
+
+      MPI_Datatype mpi_struct_datatype;
+      auto error_code
+        = MPI_Type_create_struct(2, block_lengths, displacements, mpi_datatypes, std::addressof(mpi_struct_datatype));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::remote_ptr_datatype", environment};
+
+      MPI_Datatype result;
+      error_code
+        = MPI_Type_create_resized(
+            mpi_struct_datatype, MPI_Aint{0}, static_cast<MPI_Aint>(sizeof(ptr_type)), std::addressof(result));
+      MPI_Type_free(std::addressof(mpi_struct_datatype));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::remote_ptr_datatype", environment};
+
+      error_code = MPI_Type_commit(std::addressof(result));
+      if (error_code != MPI_SUCCESS)
+      {
+        MPI_Type_free(std::addressof(result));
+        throw ::yampi::error{error_code, "yampi::remote_ptr_datatype", environment};
+      }
+
+      return ::yampi::datatype{result};
+    }
+  } // namespace remote_ptr_detail
+
+  // Datatype of ::yampi::remote_ptr<T> for any T, committed on the first call and freed at the beginning of MPI_Finalize
+  inline ::yampi::datatype const& remote_ptr_datatype(::yampi::environment const& environment)
+  {
+    static auto& result = *new ::yampi::datatype{::yampi::remote_ptr_detail::make_datatype(environment)};
+    static int const error_code = ::yampi::detail::at_finalize([]() { result = ::yampi::datatype{}; });
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::remote_ptr_datatype", environment};
+    return result;
+  }
+
+  namespace remote_ptr_detail
+  {
+    // the target has the same count and datatype as the origin
+    template <typename T, typename OriginValue>
+    inline
+    typename std::enable_if< ::yampi::has_predefined_datatype<T>::value, ::yampi::target_buffer<T> >::type
+    target_buffer_of(::yampi::remote_ptr<T> const& ptr, ::yampi::buffer<OriginValue> const& origin_buffer)
+    {
+#   if MPI_VERSION >= 4
+      return ::yampi::target_buffer<T>{ptr.displacement(), origin_buffer.count()};
+#   else // MPI_VERSION >= 4
+      return ::yampi::target_buffer<T>{ptr.displacement(), origin_buffer.large_count()};
+#   endif // MPI_VERSION >= 4
+    }
+
+    template <typename T, typename OriginValue>
+    inline
+    typename std::enable_if<not ::yampi::has_predefined_datatype<T>::value, ::yampi::target_buffer<T> >::type
+    target_buffer_of(::yampi::remote_ptr<T> const& ptr, ::yampi::buffer<OriginValue> const& origin_buffer)
+    {
+#   if MPI_VERSION >= 4
+      return ::yampi::target_buffer<T>{ptr.displacement(), origin_buffer.count(), origin_buffer.datatype()};
+#   else // MPI_VERSION >= 4
+      return ::yampi::target_buffer<T>{ptr.displacement(), origin_buffer.large_count(), origin_buffer.datatype()};
+#   endif // MPI_VERSION >= 4
+    }
+  } // namespace remote_ptr_detail
+
+  // RMA operations through remote pointers. As for the other RMA operations, they must be in an epoch of window,
+  // and origin buffers must not be accessed until the operations complete
+  template <typename OriginValue, typename T>
+  inline void put(
+    ::yampi::buffer<OriginValue> const origin_buffer, ::yampi::remote_ptr<T> const& target,
+    ::yampi::dynamic_window const& window, ::yampi::environment const& environment)
+  {
+    ::yampi::put(
+      origin_buffer, target.rank(), ::yampi::remote_ptr_detail::target_buffer_of(target, origin_buffer),
+      window, environment);
+  }
+
+  template <typename OriginValue, typename T>
+  inline void get(
+    ::yampi::buffer<OriginValue> origin_buffer, ::yampi::remote_ptr<T> const& target,
+    ::yampi::dynamic_window const& window, ::yampi::environment const& environment)
+  {
+    ::yampi::get(
+      origin_buffer, target.rank(), ::yampi::remote_ptr_detail::target_buffer_of(target, origin_buffer),
+      window, environment);
+  }
+
+  template <typename OriginValue, typename T>
+  inline void accumulate(
+    ::yampi::buffer<OriginValue> const origin_buffer, ::yampi::remote_ptr<T> const& target,
+    ::yampi::binary_operation const& operation,
+    ::yampi::dynamic_window const& window, ::yampi::environment const& environment)
+  {
+    ::yampi::accumulate(
+      origin_buffer, target.rank(), ::yampi::remote_ptr_detail::target_buffer_of(target, origin_buffer),
+      operation, window, environment);
+  }
+
+  template <typename Value>
+  inline
+  typename std::enable_if< ::yampi::has_predefined_datatype<Value>::value, void >::type
+  compare_swap(
+    Value const& origin_value, Value const& compare_value, Value& result_value,
+    ::yampi::remote_ptr<Value> const& target,
+    ::yampi::dynamic_window const& window, ::yampi::environment const& environment)
+  {
+    ::yampi::compare_swap(
+      origin_value, compare_value, result_value, target.rank(), target.displacement(), window, environment);
+  }
+
+  template <typename Value>
+  inline
+  typename std::enable_if< ::yampi::has_predefined_datatype<Value>::value, void >::type
+  fetch_operate(
+    Value const& origin_value, Value& result_value,
+    ::yampi::remote_ptr<Value> const& target, ::yampi::binary_operation const& operation,
+    ::yampi::dynamic_window const& window, ::yampi::environment const& environment)
+  {
+    ::yampi::fetch_operate(
+      origin_value, result_value, target.rank(), target.displacement(), operation, window, environment);
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -10,9 +10,13 @@
 
 # include <mpi.h>
 
+# include <boost/optional.hpp>
+
 # include <yampi/status.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 # if __cplusplus >= 201703L
 #   define YAMPI_is_nothrow_swappable std::is_nothrow_swappable
@@ -106,45 +110,18 @@ namespace yampi
     bool operator==(request_base const& other) const noexcept
     { return mpi_request_ == other.mpi_request_; }
 
+    // Waits and tests through request_base are recorded in request histograms as those of requests of unknown kind
     ::yampi::status wait(::yampi::environment const& environment)
-    {
-      MPI_Status mpi_status;
-      auto const error_code = MPI_Wait(std::addressof(mpi_request_), std::addressof(mpi_status));
-
-      return error_code == MPI_SUCCESS
-        ? ::yampi::status(mpi_status)
-        : throw ::yampi::error{error_code, "yampi::request_base::wait", environment};
-    }
+    { return do_wait< ::yampi::request_base >(environment); }
 
     void wait(::yampi::ignore_status_t const, ::yampi::environment const& environment)
-    {
-      auto const error_code = MPI_Wait(std::addressof(mpi_request_), MPI_STATUS_IGNORE);
-      if (error_code != MPI_SUCCESS)
-        throw ::yampi::error{error_code, "yampi::request_base::wait", environment};
-    }
+    { do_wait< ::yampi::request_base >(::yampi::ignore_status, environment); }
 
     boost::optional< ::yampi::status > test(::yampi::environment const& environment)
-    {
-      int flag;
-      MPI_Status mpi_status;
-      auto const error_code = MPI_Test(std::addressof(mpi_request_), std::addressof(flag), std::addressof(mpi_status));
-
-      return error_code == MPI_SUCCESS
-        ? static_cast<bool>(flag)
-          ? boost::make_optional(::yampi::status(mpi_status))
-          : boost::none
-        : throw ::yampi::error{error_code, "yampi::request_base::test", environment};
-    }
+    { return do_test< ::yampi::request_base >(environment); }
 
     bool test(::yampi::ignore_status_t const, ::yampi::environment const& environment)
-    {
-      int flag;
-      auto const error_code = MPI_Test(std::addressof(mpi_request_), std::addressof(flag), MPI_STATUS_IGNORE);
-
-      return error_code == MPI_SUCCESS
-        ? static_cast<bool>(flag)
-        : throw ::yampi::error{error_code, "yampi::request_base::test", environment};
-    }
+    { return do_test< ::yampi::request_base >(::yampi::ignore_status, environment); }
 
     boost::optional< ::yampi::status > status(::yampi::environment const& environment) const
     {
@@ -185,6 +162,62 @@ namespace yampi
       using std::swap;
       swap(mpi_request_, other.mpi_request_);
     }
+
+   protected:
+    // Derived classes call these with themselves as Request, so that request histograms are keyed by their kinds
+    template <typename Request>
+    ::yampi::status do_wait(::yampi::environment const& environment)
+    {
+      YAMPI_PROFILE_SCOPE("yampi::request_base::wait", 0u);
+      YAMPI_TIME_REQUEST_WAIT(Request, environment);
+      MPI_Status mpi_status;
+      auto const error_code = MPI_Wait(std::addressof(mpi_request_), std::addressof(mpi_status));
+
+      return error_code == MPI_SUCCESS
+        ? ::yampi::status(mpi_status)
+        : throw ::yampi::error{error_code, "yampi::request_base::wait", environment};
+    }
+
+    template <typename Request>
+    void do_wait(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    {
+      YAMPI_PROFILE_SCOPE("yampi::request_base::wait", 0u);
+      YAMPI_TIME_REQUEST_WAIT(Request, environment);
+      auto const error_code = MPI_Wait(std::addressof(mpi_request_), MPI_STATUS_IGNORE);
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::request_base::wait", environment};
+    }
+
+    template <typename Request>
+    boost::optional< ::yampi::status > do_test(::yampi::environment const& environment)
+    {
+      YAMPI_PROFILE_SCOPE("yampi::request_base::test", 0u);
+      YAMPI_TIME_REQUEST_TEST(Request, environment);
+      int flag;
+      MPI_Status mpi_status;
+      auto const error_code = MPI_Test(std::addressof(mpi_request_), std::addressof(flag), std::addressof(mpi_status));
+      YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
+
+      return error_code == MPI_SUCCESS
+        ? static_cast<bool>(flag)
+          ? boost::make_optional(::yampi::status(mpi_status))
+          : boost::none
+        : throw ::yampi::error{error_code, "yampi::request_base::test", environment};
+    }
+
+    template <typename Request>
+    bool do_test(::yampi::ignore_status_t const, ::yampi::environment const& environment)
+    {
+      YAMPI_PROFILE_SCOPE("yampi::request_base::test", 0u);
+      YAMPI_TIME_REQUEST_TEST(Request, environment);
+      int flag;
+      auto const error_code = MPI_Test(std::addressof(mpi_request_), std::addressof(flag), MPI_STATUS_IGNORE);
+      YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
+
+      return error_code == MPI_SUCCESS
+        ? static_cast<bool>(flag)
+        : throw ::yampi::error{error_code, "yampi::request_base::test", environment};
+    }
   };
 
   inline bool operator!=(::yampi::request_base const& lhs, ::yampi::request_base const& rhs) noexcept(noexcept(lhs == rhs))
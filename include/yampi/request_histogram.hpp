@@ -0,0 +1,253 @@
+#ifndef YAMPI_REQUEST_HISTOGRAM_HPP
+# define YAMPI_REQUEST_HISTOGRAM_HPP
+
+# include <cstddef>
+# include <array>
+# include <atomic>
+# include <ostream>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/wall_clock.hpp>
+
+
+// Request wait/test histograms.
+//
+// Compile with YAMPI_REQUEST_HISTOGRAM defined to make wait and test of requests, wait_all, wait_any, wait_some,
+// test_all, test_any and test_some record the time spent in them to ::yampi::request_histograms::instance(),
+// keyed by request kind. test also counts how often it finds the requests completed. The kind is that of the static
+// type, so waits and tests through ::yampi::request_base are recorded as those of request_kind::other.
+// Without YAMPI_REQUEST_HISTOGRAM, the YAMPI_*_REQUEST_* macros expand to nothing.
+namespace yampi
+{
+  class immediate_request;
+  class persistent_request;
+  class partitioned_request;
+
+  enum class request_kind
+    : int
+  { immediate = 0, persistent = 1, partitioned = 2, other = 3 };
+
+  template <typename Request>
+  struct request_kind_of
+  { static constexpr ::yampi::request_kind value = ::yampi::request_kind::other; };
+
+  template <>
+  struct request_kind_of< ::yampi::immediate_request >
+  { static constexpr ::yampi::request_kind value = ::yampi::request_kind::immediate; };
+
+  template <>
+  struct request_kind_of< ::yampi::persistent_request >
+  { static constexpr ::yampi::request_kind value = ::yampi::request_kind::persistent; };
+
+  template <>
+  struct request_kind_of< ::yampi::partitioned_request >
+  { static constexpr ::yampi::request_kind value = ::yampi::request_kind::partitioned; };
+
+  // bucket 0 counts durations shorter than 1 ns, bucket i (> 0) counts durations in [2^(i-1), 2^i) ns
+  class log_histogram
+  {
+   public:
+    static constexpr std::size_t num_buckets = 48u;
+
+   private:
+    std::array<std::atomic<unsigned long long>, num_buckets> counts_;
+    std::atomic<unsigned long long> total_nanoseconds_;
+
+   public:
+    log_histogram() noexcept
+      : counts_{}, total_nanoseconds_{0ull}
+    { clear(); }
+
+    log_histogram(log_histogram const&) = delete;
+    log_histogram& operator=(log_histogram const&) = delete;
+
+    void add(::yampi::wall_clock::duration const duration) noexcept
+    {
+      auto const nanoseconds
+        = duration.count() > 0.0
+          ? static_cast<unsigned long long>(duration.count() * 1.0e9)
+          : 0ull;
+
+      auto bucket = std::size_t{0u};
+      for (auto value = nanoseconds; value != 0ull and bucket + 1u < num_buckets; value >>= 1u)
+        ++bucket;
+
+      counts_[bucket].fetch_add(1ull, std::memory_order_relaxed);
+      total_nanoseconds_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept
+    {
+      for (auto& count: counts_)
+        count.store(0ull, std::memory_order_relaxed);
+      total_nanoseconds_.store(0ull, std::memory_order_relaxed);
+    }
+
+    unsigned long long count(std::size_t const bucket) const noexcept
+    { return counts_[bucket].load(std::memory_order_relaxed); }
+
+    unsigned long long total_count() const noexcept
+    {
+      auto result = 0ull;
+      for (auto const& count: counts_)
+        result += count.load(std::memory_order_relaxed);
+      return result;
+    }
+
+    unsigned long long total_nanoseconds() const noexcept
+    { return total_nanoseconds_.load(std::memory_order_relaxed); }
+
+    static unsigned long long lower_bound_nanoseconds(std::size_t const bucket) noexcept
+    { return bucket == 0u ? 0ull : 1ull << (bucket - 1u); }
+  };
+
+  class request_histograms
+  {
+    static constexpr std::size_t num_kinds = 4u;
+
+    std::array< ::yampi::log_histogram, num_kinds > wait_histograms_;
+    std::array< ::yampi::log_histogram, num_kinds > test_histograms_;
+    std::array<std::atomic<unsigned long long>, num_kinds> num_completed_tests_;
+    std::array<std::atomic<unsigned long long>, num_kinds> num_pending_tests_;
+
+    request_histograms() noexcept
+      : wait_histograms_{}, test_histograms_{}, num_completed_tests_{}, num_pending_tests_{}
+    { clear(); }
+
+   public:
+    request_histograms(request_histograms const&) = delete;
+    request_histograms& operator=(request_histograms const&) = delete;
+
+    static ::yampi::request_histograms& instance() noexcept
+    {
+      static ::yampi::request_histograms result;
+      return result;
+    }
+
+    ::yampi::log_histogram const& wait_histogram(::yampi::request_kind const kind) const noexcept
+    { return wait_histograms_[static_cast<std::size_t>(kind)]; }
+
+    ::yampi::log_histogram const& test_histogram(::yampi::request_kind const kind) const noexcept
+    { return test_histograms_[static_cast<std::size_t>(kind)]; }
+
+    unsigned long long num_completed_tests(::yampi::request_kind const kind) const noexcept
+    { return num_completed_tests_[static_cast<std::size_t>(kind)].load(std::memory_order_relaxed); }
+
+    unsigned long long num_pending_tests(::yampi::request_kind const kind) const noexcept
+    { return num_pending_tests_[static_cast<std::size_t>(kind)].load(std::memory_order_relaxed); }
+
+    void record_wait(::yampi::request_kind const kind, ::yampi::wall_clock::duration const duration) noexcept
+    { wait_histograms_[static_cast<std::size_t>(kind)].add(duration); }
+
+    void record_test(
+      ::yampi::request_kind const kind, ::yampi::wall_clock::duration const duration, bool const is_completed) noexcept
+    {
+      test_histograms_[static_cast<std::size_t>(kind)].add(duration);
+      (is_completed ? num_completed_tests_ : num_pending_tests_)[static_cast<std::size_t>(kind)]
+        .fetch_add(1ull, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept
+    {
+      for (auto kind = std::size_t{0u}; kind < num_kinds; ++kind)
+      {
+        wait_histograms_[kind].clear();
+        test_histograms_[kind].clear();
+        num_completed_tests_[kind].store(0ull, std::memory_order_relaxed);
+        num_pending_tests_[kind].store(0ull, std::memory_order_relaxed);
+      }
+    }
+
+    // Writes "kind,operation,lower_bound_ns,count" for each nonempty bucket, and
+    // "kind,test_completed,,count" and "kind,test_pending,,count" for each kind having tests
+    void write(std::ostream& out) const
+    {
+      static char const* const kind_names[num_kinds] = {"immediate", "persistent", "partitioned", "other"};
+
+      out << "kind,operation,lower_bound_ns,count\n";
+      for (auto kind = std::size_t{0u}; kind < num_kinds; ++kind)
+      {
+        for (auto bucket = std::size_t{0u}; bucket < ::yampi::log_histogram::num_buckets; ++bucket)
+          if (wait_histograms_[kind].count(bucket) != 0ull)
+            out
+              << kind_names[kind] << ",wait," << ::yampi::log_histogram::lower_bound_nanoseconds(bucket)
+              << ',' << wait_histograms_[kind].count(bucket) << '\n';
+        for (auto bucket = std::size_t{0u}; bucket < ::yampi::log_histogram::num_buckets; ++bucket)
+          if (test_histograms_[kind].count(bucket) != 0ull)
+            out
+              << kind_names[kind] << ",test," << ::yampi::log_histogram::lower_bound_nanoseconds(bucket)
+              << ',' << test_histograms_[kind].count(bucket) << '\n';
+
+        if (test_histograms_[kind].total_count() == 0ull)
+          continue;
+        out
+          << kind_names[kind] << ",test_completed,," << num_completed_tests_[kind].load(std::memory_order_relaxed) << '\n'
+          << kind_names[kind] << ",test_pending,," << num_pending_tests_[kind].load(std::memory_order_relaxed) << '\n';
+      }
+      out << std::flush;
+    }
+  };
+
+  namespace request_histogram_detail
+  {
+    class scoped_wait_timer
+    {
+      ::yampi::request_kind kind_;
+      ::yampi::environment const& environment_;
+      ::yampi::wall_clock::time_point start_;
+
+     public:
+      scoped_wait_timer(::yampi::request_kind const kind, ::yampi::environment const& environment)
+        : kind_{kind}, environment_{environment}, start_{::yampi::wall_clock::now(environment)}
+      { }
+
+      ~scoped_wait_timer() noexcept
+      { ::yampi::request_histograms::instance().record_wait(kind_, ::yampi::wall_clock::now(environment_) - start_); }
+
+      scoped_wait_timer(scoped_wait_timer const&) = delete;
+      scoped_wait_timer& operator=(scoped_wait_timer const&) = delete;
+    };
+
+    class scoped_test_timer
+    {
+      ::yampi::request_kind kind_;
+      ::yampi::environment const& environment_;
+      ::yampi::wall_clock::time_point start_;
+      bool is_completed_;
+
+     public:
+      scoped_test_timer(::yampi::request_kind const kind, ::yampi::environment const& environment)
+        : kind_{kind}, environment_{environment}, start_{::yampi::wall_clock::now(environment)}, is_completed_{false}
+      { }
+
+      ~scoped_test_timer() noexcept
+      {
+        ::yampi::request_histograms::instance().record_test(
+          kind_, ::yampi::wall_clock::now(environment_) - start_, is_completed_);
+      }
+
+      scoped_test_timer(scoped_test_timer const&) = delete;
+      scoped_test_timer& operator=(scoped_test_timer const&) = delete;
+
+      void complete(bool const is_completed) noexcept { is_completed_ = is_completed; }
+    };
+  } // namespace request_histogram_detail
+} // namespace yampi
+
+
+# ifdef YAMPI_REQUEST_HISTOGRAM
+#   define YAMPI_TIME_REQUEST_WAIT(Request, environment) \
+  ::yampi::request_histogram_detail::scoped_wait_timer const yampi_scoped_wait_timer_{::yampi::request_kind_of< Request >::value, environment}
+#   define YAMPI_TIME_REQUEST_TEST(Request, environment) \
+  ::yampi::request_histogram_detail::scoped_test_timer yampi_scoped_test_timer_{::yampi::request_kind_of< Request >::value, environment}
+#   define YAMPI_COMPLETE_REQUEST_TEST(is_completed) yampi_scoped_test_timer_.complete(is_completed)
+# else // YAMPI_REQUEST_HISTOGRAM
+#   define YAMPI_TIME_REQUEST_WAIT(Request, environment)
+#   define YAMPI_TIME_REQUEST_TEST(Request, environment)
+#   define YAMPI_COMPLETE_REQUEST_TEST(is_completed)
+# endif // YAMPI_REQUEST_HISTOGRAM
+
+
+#endif
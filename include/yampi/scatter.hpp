@@ -18,6 +18,7 @@
 # include <yampi/nonroot_call_on_root_error.hpp>
 # include <yampi/root_call_on_nonroot_error.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/persistent_request.hpp>
 #   include <yampi/information.hpp>
@@ -33,13 +34,14 @@ namespace yampi
     ContiguousIterator const first, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, ReceiveValue>::value,
       "value_type of ContiguousIterator must be the same to ReceiveValue");
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.count().mpi_count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= std::addressof(*first)));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= std::addressof(*first)));
+    assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.large_count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= std::addressof(*first)));
 # endif // MPI_VERSION >= 4
 
 # if MPI_VERSION >= 4
@@ -51,8 +53,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatter(
-          std::addressof(*first), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -64,15 +66,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -84,14 +87,14 @@ namespace yampi
     auto const error_code
       = MPI_Scatter(
           send_buffer.data(), send_count, send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Scatter(
           const_cast<value_type*>(send_buffer.data()), send_count, send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -103,6 +106,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::scatter"};
 
@@ -116,7 +120,7 @@ namespace yampi
     auto const error_code
       = MPI_Scatter(
           nullptr, 0, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -129,12 +133,13 @@ namespace yampi
     ::yampi::buffer<Value> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::scatter"};
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -165,6 +170,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatter_c(
@@ -175,7 +181,7 @@ namespace yampi
     auto const error_code
       = MPI_Scatter(
           nullptr, 0, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -187,9 +193,10 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const send_count = send_buffer.count() / remote_size;
-    assert(send_count * remote_size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / remote_size;
+    assert(send_count * remote_size == send_buffer.count(environment));
 
 # if MPI_VERSION >= 4
     auto const error_code
@@ -217,6 +224,7 @@ namespace yampi
 
   inline void scatter(::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", 0u);
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Scatter_c(
@@ -240,13 +248,14 @@ namespace yampi
     ContiguousIterator const first, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, ReceiveValue>::value,
       "value_type of ContiguousIterator must be the same to ReceiveValue");
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.count().mpi_count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= std::addressof(*first)));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= std::addressof(*first)));
+    assert(communicator.rank(environment) != root or (std::addressof(*first) + receive_buffer.large_count() * communicator.size(environment) <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= std::addressof(*first)));
 # endif // MPI_VERSION >= 4
 
     MPI_Request mpi_request;
@@ -259,8 +268,8 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Iscatter(
-          std::addressof(*first), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          std::addressof(*first), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -274,15 +283,16 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 # else // MPI_VERSION >= 4
-    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count() <= send_buffer.data()));
+    assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.large_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.large_count() <= send_buffer.data()));
 # endif // MPI_VERSION >= 4
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -295,7 +305,7 @@ namespace yampi
     auto const error_code
       = MPI_Iscatter(
           send_buffer.data(), send_count, send_buffer.datatype().mpi_datatype(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -309,6 +319,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::scatter"};
 
@@ -323,7 +334,7 @@ namespace yampi
     auto const error_code
       = MPI_Iscatter(
           nullptr, 0, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -338,12 +349,13 @@ namespace yampi
     ::yampi::buffer<Value> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::scatter"};
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -371,6 +383,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -382,7 +395,7 @@ namespace yampi
     auto const error_code
       = MPI_Iscatter(
           nullptr, 0, MPI_DATATYPE_NULL,
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           root.mpi_rank(), communicator.mpi_comm(), std::addressof(mpi_request));
 # endif // MPI_VERSION >= 4
     if (error_code != MPI_SUCCESS)
@@ -396,9 +409,10 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const send_count = send_buffer.count() / remote_size;
-    assert(send_count * remote_size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / remote_size;
+    assert(send_count * remote_size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
@@ -423,6 +437,7 @@ namespace yampi
     ::yampi::immediate_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", 0u);
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -450,6 +465,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, ReceiveValue>::value,
       "value_type of ContiguousIterator must be the same to ReceiveValue");
@@ -473,11 +489,12 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -496,6 +513,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::scatter"};
 
@@ -517,12 +535,13 @@ namespace yampi
     ::yampi::buffer<Value> const send_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::scatter"};
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -542,6 +561,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatter_init_c(
@@ -559,9 +579,10 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const send_count = send_buffer.count() / remote_size;
-    assert(send_count * remote_size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / remote_size;
+    assert(send_count * remote_size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -578,6 +599,7 @@ namespace yampi
     ::yampi::persistent_request& request, ::yampi::information const& information,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatter_init_c(
@@ -596,6 +618,7 @@ namespace yampi
     ContiguousIterator const first, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     static_assert(
       std::is_same<typename std::iterator_traits<ContiguousIterator>::value_type, ReceiveValue>::value,
       "value_type of ContiguousIterator must be the same to ReceiveValue");
@@ -618,11 +641,12 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer, ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     assert(communicator.rank(environment) != root or (send_buffer.data() + send_buffer.count().mpi_count() <= receive_buffer.data() or receive_buffer.data() + receive_buffer.count().mpi_count() <= send_buffer.data()));
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -641,6 +665,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     if (communicator.rank(environment) == root)
       throw ::yampi::nonroot_call_on_root_error{"yampi::scatter"};
 
@@ -662,12 +687,13 @@ namespace yampi
     ::yampi::buffer<Value> const send_buffer, ::yampi::rank const root,
     ::yampi::communicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     if (communicator.rank(environment) != root)
       throw ::yampi::root_call_on_nonroot_error{"yampi::scatter"};
 
     auto const size = communicator.size(environment);
-    auto const send_count = send_buffer.count() / size;
-    assert(send_count * size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / size;
+    assert(send_count * size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -687,6 +713,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const root,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(receive_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatter_init_c(
@@ -704,9 +731,10 @@ namespace yampi
     ::yampi::buffer<SendValue> const send_buffer,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", ::yampi::profiler::num_bytes(send_buffer, environment));
     auto const remote_size = communicator.remote_size(environment);
-    auto const send_count = send_buffer.count() / remote_size;
-    assert(send_count * remote_size == send_buffer.count());
+    auto const send_count = send_buffer.count(environment) / remote_size;
+    assert(send_count * remote_size == send_buffer.count(environment));
 
     MPI_Request mpi_request;
     auto const error_code
@@ -723,6 +751,7 @@ namespace yampi
     ::yampi::persistent_request& request,
     ::yampi::intercommunicator const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::scatter", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Scatter_init_c(
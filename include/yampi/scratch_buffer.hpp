@@ -0,0 +1,209 @@
+#ifndef YAMPI_SCRATCH_BUFFER_HPP
+# define YAMPI_SCRATCH_BUFFER_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <algorithm>
+# include <vector>
+# include <memory>
+
+# include <yampi/pooled_allocator.hpp>
+
+
+// Scratch buffers for temporaries.
+//
+// Each thread has a ::yampi::scratch_arena, a bump allocator over blocks of MPI_Alloc_mem-ed (registered) memory
+// taken from ::yampi::memory_pool<true>. ::yampi::scratch_buffer<Value> takes its storage from the arena of the calling
+// thread and gives it back on destruction, so scratch buffers must be destroyed in the reverse order of construction
+// in each thread (which holds for local variables). Blocks are kept for subsequent calls; when no scratch buffer is
+// alive, multiple blocks are merged into one large enough for all of them.
+namespace yampi
+{
+  class scratch_arena
+  {
+    struct block
+    {
+      char* data;
+      std::size_t size;
+    };
+
+    static constexpr std::size_t min_block_size = std::size_t{1u} << 12u;
+
+    std::vector<block> blocks_;
+    std::size_t current_block_;
+    std::size_t num_used_bytes_;
+    std::size_t depth_;
+
+   public:
+    // the state to return to on deallocation
+    struct marker
+    {
+      std::size_t block;
+      std::size_t num_used_bytes;
+    };
+
+    scratch_arena() noexcept
+      : blocks_{}, current_block_{0u}, num_used_bytes_{0u}, depth_{0u}
+    { }
+
+    ~scratch_arena() noexcept
+    {
+      try
+      {
+        release();
+      }
+      catch (...)
+      { }
+    }
+
+    scratch_arena(scratch_arena const&) = delete;
+    scratch_arena& operator=(scratch_arena const&) = delete;
+    scratch_arena(scratch_arena&&) = delete;
+    scratch_arena& operator=(scratch_arena&&) = delete;
+
+    // MPI must be initialized when this allocates first
+    static ::yampi::scratch_arena& this_thread()
+    {
+      thread_local ::yampi::scratch_arena result;
+      return result;
+    }
+
+    // Returns storage of num_bytes bytes aligned to alignment, and the marker to pass to deallocate
+    void* allocate(std::size_t const num_bytes, std::size_t const alignment, marker& previous)
+    {
+      previous = marker{current_block_, num_used_bytes_};
+
+      while (true)
+      {
+        if (current_block_ < blocks_.size())
+        {
+          auto const offset = (num_used_bytes_ + alignment - 1u) / alignment * alignment;
+          if (offset + num_bytes <= blocks_[current_block_].size)
+          {
+            num_used_bytes_ = offset + num_bytes;
+            ++depth_;
+            return blocks_[current_block_].data + offset;
+          }
+
+          if (num_used_bytes_ != 0u or current_block_ + 1u < blocks_.size())
+          {
+            ++current_block_;
+            num_used_bytes_ = 0u;
+            continue;
+          }
+        }
+
+        auto const block_size
+          = std::max({min_block_size, num_bytes + alignment, blocks_.empty() ? std::size_t{0u} : 2u * blocks_.back().size});
+        blocks_.push_back(block{static_cast<char*>(::yampi::memory_pool<true>::instance().allocate(block_size)), block_size});
+        current_block_ = blocks_.size() - 1u;
+        num_used_bytes_ = 0u;
+      }
+    }
+
+    void deallocate(marker const& previous)
+    {
+      assert(depth_ > 0u);
+      current_block_ = previous.block;
+      num_used_bytes_ = previous.num_used_bytes;
+
+      if (--depth_ != 0u or blocks_.size() <= 1u)
+        return;
+
+      auto total_size = std::size_t{0u};
+      for (auto const& block: blocks_)
+        total_size += block.size;
+      release();
+      blocks_.push_back(block{static_cast<char*>(::yampi::memory_pool<true>::instance().allocate(total_size)), total_size});
+    }
+
+    // Returns all blocks to the memory pool. No scratch buffer may be alive
+    void release()
+    {
+      assert(depth_ == 0u);
+      for (auto const& block: blocks_)
+        ::yampi::memory_pool<true>::instance().deallocate(block.data, block.size);
+      blocks_.clear();
+      current_block_ = 0u;
+      num_used_bytes_ = 0u;
+    }
+
+    std::size_t capacity() const noexcept
+    {
+      auto result = std::size_t{0u};
+      for (auto const& block: blocks_)
+        result += block.size;
+      return result;
+    }
+  };
+
+  // Default-initialized array of Value in the scratch arena of the calling thread
+  template <typename Value>
+  class scratch_buffer
+  {
+    ::yampi::scratch_arena& arena_;
+    ::yampi::scratch_arena::marker marker_;
+    Value* data_;
+    std::size_t size_;
+
+   public:
+    explicit scratch_buffer(std::size_t const size)
+      : scratch_buffer{size, ::yampi::scratch_arena::this_thread()}
+    { }
+
+    scratch_buffer(std::size_t const size, ::yampi::scratch_arena& arena)
+      : arena_{arena}, marker_{},
+        data_{static_cast<Value*>(arena.allocate(size * sizeof(Value), alignof(Value), marker_))},
+        size_{0u}
+    {
+      try
+      {
+        for (; size_ < size; ++size_)
+          ::new(static_cast<void*>(data_ + size_)) Value;
+      }
+      catch (...)
+      {
+        destroy();
+        throw;
+      }
+    }
+
+    ~scratch_buffer() noexcept
+    {
+      try
+      {
+        destroy();
+      }
+      catch (...)
+      { }
+    }
+
+    scratch_buffer(scratch_buffer const&) = delete;
+    scratch_buffer& operator=(scratch_buffer const&) = delete;
+    scratch_buffer(scratch_buffer&&) = delete;
+    scratch_buffer& operator=(scratch_buffer&&) = delete;
+
+    Value* data() noexcept { return data_; }
+    Value const* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    Value* begin() noexcept { return data_; }
+    Value const* begin() const noexcept { return data_; }
+    Value* end() noexcept { return data_ + size_; }
+    Value const* end() const noexcept { return data_ + size_; }
+
+    Value& operator[](std::size_t const index) noexcept { return data_[index]; }
+    Value const& operator[](std::size_t const index) const noexcept { return data_[index]; }
+
+   private:
+    void destroy()
+    {
+      for (; size_ > 0u; --size_)
+        data_[size_ - 1u].~Value();
+      arena_.deallocate(marker_);
+    }
+  };
+}
+
+
+#endif
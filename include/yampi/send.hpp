@@ -16,6 +16,10 @@
 # include <yampi/communication_mode.hpp>
 # include <yampi/immediate_request.hpp>
 # include <yampi/persistent_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/communication_matrix.hpp>
+# include <yampi/datatype_layout.hpp>
+# include <yampi/large_count.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/partitioned_request.hpp>
 #   include <yampi/partitioned_buffer.hpp>
@@ -31,21 +35,28 @@ namespace yampi
     ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send(*bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Send_c(
           buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Send(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<Value>::type;
     auto const error_code
       = MPI_Send(
-          const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # endif // MPI_VERSION >= 3
     if (error_code != MPI_SUCCESS)
@@ -59,6 +70,12 @@ namespace yampi
     ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -67,16 +84,17 @@ namespace yampi
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Isend(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<Value>::type;
     auto const error_code
       = MPI_Isend(
-          const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION
@@ -92,6 +110,11 @@ namespace yampi
     ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -100,16 +123,17 @@ namespace yampi
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+    ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
     auto const error_code
       = MPI_Send_init(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), arguments.count(), arguments.mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # else // MPI_VERSION >= 3
     using value_type = typename std::remove_cv<Value>::type;
     auto const error_code
       = MPI_Send_init(
-          const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
           std::addressof(mpi_request));
 # endif // MPI_VERSION >= 3
@@ -127,6 +151,7 @@ namespace yampi
     ::yampi::information const& information,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Psend_init(
@@ -145,6 +170,7 @@ namespace yampi
     ::yampi::partitioned_buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send", 0u);
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Psend_init(
@@ -195,21 +221,28 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(*bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
         auto const error_code
           = MPI_Bsend_c(
               buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Bsend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Bsend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # endif // MPI_VERSION
         if (error_code != MPI_SUCCESS)
@@ -223,6 +256,12 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -231,16 +270,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Ibsend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Ibsend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION
@@ -256,6 +296,11 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -264,16 +309,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Bsend_init(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION >= 3
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Bsend_init(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION >= 3
@@ -292,21 +338,28 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(*bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
         auto const error_code
           = MPI_Ssend_c(
               buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Ssend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Ssend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # endif // MPI_VERSION
         if (error_code != MPI_SUCCESS)
@@ -320,6 +373,12 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -328,16 +387,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Issend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Issend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION
@@ -353,6 +413,11 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -361,16 +426,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Ssend_init(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION >= 3
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Ssend_init(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION >= 3
@@ -389,21 +455,28 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(*bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
         auto const error_code
           = MPI_Rsend_c(
               buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Rsend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Rsend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm());
 # endif // MPI_VERSION
         if (error_code != MPI_SUCCESS)
@@ -417,6 +490,12 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
+        YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -425,16 +504,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Irsend(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Irsend(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION
@@ -450,6 +530,11 @@ namespace yampi
         ::yampi::buffer<Value> const buffer, ::yampi::rank const destination, ::yampi::tag const tag,
         ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
       {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+          return call(request, *bytes, destination, tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+        YAMPI_PROFILE_SCOPE("yampi::send", ::yampi::profiler::num_bytes(buffer, environment));
         MPI_Request mpi_request;
 # if MPI_VERSION >= 4
         auto const error_code
@@ -458,16 +543,17 @@ namespace yampi
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # elif MPI_VERSION >= 3
+        ::yampi::large_count_detail::count_and_datatype const arguments{buffer, environment};
         auto const error_code
           = MPI_Rsend_init(
-              buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+              buffer.data(), arguments.count(), arguments.mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # else // MPI_VERSION >= 3
         using value_type = typename std::remove_cv<Value>::type;
         auto const error_code
           = MPI_Rsend_init(
-              const_cast<value_type*>(buffer.data()), buffer.count(), buffer.datatype().mpi_datatype(),
+              const_cast<value_type*>(buffer.data()), buffer.count(environment), buffer.datatype().mpi_datatype(),
               destination.mpi_rank(), tag.mpi_tag(), communicator.mpi_comm(),
               std::addressof(mpi_request));
 # endif // MPI_VERSION >= 3
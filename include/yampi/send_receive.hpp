@@ -15,6 +15,9 @@
 # include <yampi/error.hpp>
 # include <yampi/cartesian.hpp>
 # include <yampi/immediate_request.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/communication_matrix.hpp>
+# include <yampi/datatype_layout.hpp>
 
 
 namespace yampi
@@ -26,6 +29,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        *send_bytes, destination, send_tag, receive_buffer, source, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        send_buffer, destination, send_tag, *receive_bytes, source, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -38,18 +53,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION
@@ -64,6 +79,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        *send_bytes, destination, send_tag, receive_buffer, source,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        send_buffer, destination, send_tag, *receive_bytes, source,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -76,18 +103,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION
@@ -102,6 +129,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        *send_bytes, destination, send_tag, receive_buffer, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        send_buffer, destination, send_tag, *receive_bytes, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -114,18 +153,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION
@@ -140,6 +179,14 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(*send_bytes, destination, send_tag, receive_buffer, communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(send_buffer, destination, send_tag, *receive_bytes, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -152,18 +199,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
 # endif // MPI_VERSION
@@ -179,6 +226,12 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(*bytes, destination, send_tag, source, receive_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -190,7 +243,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
@@ -206,6 +259,12 @@ namespace yampi
     ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(*bytes, destination, send_tag, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -217,7 +276,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
@@ -233,6 +292,12 @@ namespace yampi
     ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(*bytes, destination, send_tag, receive_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -244,7 +309,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), std::addressof(stat));
@@ -259,6 +324,12 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const destination, ::yampi::tag const send_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(*bytes, destination, send_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Status stat;
 # if MPI_VERSION >= 4
     auto const error_code
@@ -270,7 +341,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), std::addressof(stat));
@@ -288,6 +359,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *send_bytes, destination, send_tag, receive_buffer, source, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, send_buffer, destination, send_tag, *receive_bytes, source, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_c(
@@ -299,18 +382,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION
@@ -325,6 +408,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *send_bytes, destination, send_tag, receive_buffer, source,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, send_buffer, destination, send_tag, *receive_bytes, source,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_c(
@@ -336,18 +431,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION
@@ -362,6 +457,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *send_bytes, destination, send_tag, receive_buffer, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, send_buffer, destination, send_tag, *receive_bytes, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_c(
@@ -373,18 +480,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION
@@ -399,6 +506,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *send_bytes, destination, send_tag, receive_buffer,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, send_buffer, destination, send_tag, *receive_bytes,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_c(
@@ -410,18 +529,18 @@ namespace yampi
 # elif MPI_VERSION >= 3
     auto const error_code
       = MPI_Sendrecv(
-          send_buffer.data(), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          send_buffer.data(), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # else // MPI_VERSION
     using value_type = typename std::remove_cv<SendValue>::type;
     auto const error_code
       = MPI_Sendrecv(
-          const_cast<value_type*>(send_buffer.data()), send_buffer.count(), send_buffer.datatype().mpi_datatype(),
+          const_cast<value_type*>(send_buffer.data()), send_buffer.count(environment), send_buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
-          receive_buffer.data(), receive_buffer.count(), receive_buffer.datatype().mpi_datatype(),
+          receive_buffer.data(), receive_buffer.count(environment), receive_buffer.datatype().mpi_datatype(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
 # endif // MPI_VERSION
@@ -437,6 +556,14 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *bytes, destination, send_tag, source, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace_c(
@@ -447,7 +574,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           source.mpi_rank(), receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
@@ -463,6 +590,14 @@ namespace yampi
     ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *bytes, destination, send_tag, source,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace_c(
@@ -473,7 +608,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           source.mpi_rank(), MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
@@ -489,6 +624,14 @@ namespace yampi
     ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(
+        ::yampi::ignore_status, *bytes, destination, send_tag, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace_c(
@@ -499,7 +642,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           MPI_ANY_SOURCE, receive_tag.mpi_tag(),
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
@@ -514,6 +657,12 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const destination, ::yampi::tag const send_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(::yampi::ignore_status, *bytes, destination, send_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
 # if MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace_c(
@@ -524,7 +673,7 @@ namespace yampi
 # else // MPI_VERSION >= 4
     auto const error_code
       = MPI_Sendrecv_replace(
-          buffer.data(), buffer.count(), buffer.datatype().mpi_datatype(),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(),
           destination.mpi_rank(), send_tag.mpi_tag(),
           MPI_ANY_SOURCE, MPI_ANY_TAG,
           communicator.mpi_comm(), MPI_STATUS_IGNORE);
@@ -542,6 +691,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        request, *send_bytes, destination, send_tag, receive_buffer, source, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        request, send_buffer, destination, send_tag, *receive_bytes, source, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_c(
@@ -562,6 +723,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        request, *send_bytes, destination, send_tag, receive_buffer, source,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        request, send_buffer, destination, send_tag, *receive_bytes, source,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_c(
@@ -582,6 +755,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        request, *send_bytes, destination, send_tag, receive_buffer, receive_tag,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        request, send_buffer, destination, send_tag, *receive_bytes, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_c(
@@ -602,6 +787,18 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const send_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(send_buffer, environment))
+      return ::yampi::send_receive(
+        request, *send_bytes, destination, send_tag, receive_buffer,
+        communicator, environment);
+    if (auto const receive_bytes = ::yampi::datatype_layout_detail::to_byte_buffer(receive_buffer, environment))
+      return ::yampi::send_receive(
+        request, send_buffer, destination, send_tag, *receive_bytes,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(send_buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_c(
@@ -623,6 +820,14 @@ namespace yampi
     ::yampi::rank const source, ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(
+        request, *bytes, destination, send_tag, source, receive_tag,
+        communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_replace_c(
@@ -642,6 +847,12 @@ namespace yampi
     ::yampi::rank const source,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(request, *bytes, destination, send_tag, source, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_replace_c(
@@ -661,6 +872,12 @@ namespace yampi
     ::yampi::tag const receive_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(request, *bytes, destination, send_tag, receive_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_replace_c(
@@ -679,6 +896,12 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::rank const destination, ::yampi::tag const send_tag,
     ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
   {
+# ifdef YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    if (auto const bytes = ::yampi::datatype_layout_detail::to_byte_buffer(buffer, environment))
+      return ::yampi::send_receive(request, *bytes, destination, send_tag, communicator, environment);
+# endif // YAMPI_CONTIGUOUS_DATATYPES_AS_BYTES
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
+    YAMPI_RECORD_SEND(communicator, destination, ::yampi::profiler::num_bytes(buffer, environment));
     MPI_Request mpi_request;
     auto const error_code
       = MPI_Isendrecv_replace_c(
@@ -701,6 +924,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -723,6 +947,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -745,6 +970,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -766,6 +992,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -790,6 +1017,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -815,6 +1043,7 @@ namespace yampi
     ::yampi::cartesian const& cartesian,
     ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -839,6 +1068,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -862,6 +1092,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -888,6 +1119,7 @@ namespace yampi
     ::yampi::buffer<ReceiveValue> receive_buffer, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -913,6 +1145,7 @@ namespace yampi
     ::yampi::cartesian const& cartesian,
     ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(send_buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -937,6 +1170,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag, ::yampi::tag const receive_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -960,6 +1194,7 @@ namespace yampi
     ::yampi::buffer<Value> buffer, ::yampi::tag const send_tag,
     ::yampi::cartesian const& cartesian, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::send_receive", ::yampi::profiler::num_bytes(buffer, environment));
     int mpi_source;
     int mpi_destination;
     auto const error_code
@@ -0,0 +1,79 @@
+#ifndef YAMPI_SHARED_SEGMENT_HPP
+# define YAMPI_SHARED_SEGMENT_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <iterator>
+# include <stdexcept>
+
+
+// View of the segment of a process in a window on shared memory.
+//
+// ::yampi::window_array<T, true>::shared_segment(rank, environment) returns the segment of any process in the window,
+// which the calling process can access with plain loads and stores instead of ::yampi::get and ::yampi::put.
+// Accesses must be ordered as in the unified memory model, e.g. in a passive target epoch of all processes
+//
+//   ::yampi::all_shared_lock< ::yampi::window_array<double, true> > lock{window, environment};
+//   local[index] = value;                                            // store to own segment
+//   ::yampi::synchronize_barrier(window, communicator, environment); // make stores visible to the other processes
+//   auto const halo = neighbor[0];                                   // load from neighbor's segment
+//
+// where ::yampi::synchronize_barrier is in <yampi/synchronize.hpp>.
+namespace yampi
+{
+  template <typename T>
+  class shared_segment
+  {
+    T* data_;
+    std::size_t size_;
+
+   public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    constexpr shared_segment() noexcept : data_{nullptr}, size_{0u} { }
+
+    constexpr shared_segment(T* data, std::size_t const size) noexcept
+      : data_{data}, size_{size}
+    { }
+
+    reference at(size_type const index) const
+    {
+      return index < size_
+        ? data_[index]
+        : throw std::out_of_range("yampi::shared_segment<T>::at");
+    }
+
+    reference operator[](size_type const index) const
+    { assert(index < size_); return data_[index]; }
+
+    reference front() const { return *data_; }
+    reference back() const { return data_[size_-1]; }
+
+    T* data() const noexcept { return data_; }
+
+    iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(this->end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(this->cend()); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(this->begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(this->cbegin()); }
+
+    bool empty() const noexcept { return size_ == std::size_t{0u}; }
+    size_type size() const noexcept { return size_; }
+  };
+}
+
+
+#endif
@@ -11,6 +11,7 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -19,6 +20,7 @@ namespace yampi
   inline void start_all(
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::start_all", 0u);
     static_assert(
       std::is_base_of< ::yampi::startable_request, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::startable_request");
@@ -4,8 +4,10 @@
 # include <mpi.h>
 
 # include <yampi/window_base.hpp>
+# include <yampi/communicator_base.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -14,10 +16,32 @@ namespace yampi
   template <typename Derived>
   inline void synchronize(::yampi::window_base<Derived> const& window, ::yampi::environment const& environment)
   {
-    int const error_code = MPI_Win_synchronize(window.mpi_win());
+    YAMPI_PROFILE_SCOPE("yampi::synchronize", 0u);
+    int const error_code = MPI_Win_sync(window.mpi_win());
     if (error_code != MPI_SUCCESS)
       throw ::yampi::error(error_code, "yampi::synchronize", environment);
   }
+
+  // Collective over communicator, which must be that of window. In a passive target epoch of a window on shared memory,
+  // stores of each process before this call are visible to loads of all processes after this call
+  template <typename Derived>
+  inline void synchronize_barrier(
+    ::yampi::window_base<Derived> const& window,
+    ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+  {
+    YAMPI_PROFILE_SCOPE("yampi::synchronize_barrier", 0u);
+    auto error_code = MPI_Win_sync(window.mpi_win());
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::synchronize_barrier", environment};
+
+    error_code = MPI_Barrier(communicator.mpi_comm());
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::synchronize_barrier", environment};
+
+    error_code = MPI_Win_sync(window.mpi_win());
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::synchronize_barrier", environment};
+  }
 }
 # endif // MPI_VERSION >= 3
 
@@ -2,6 +2,7 @@
 # define YAMPI_TARGET_BUFFER_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <utility>
 # include <type_traits>
 # if __cplusplus < 201703L
@@ -15,8 +16,11 @@
 # include <yampi/predefined_datatype.hpp>
 # include <yampi/has_predefined_datatype.hpp>
 # include <yampi/displacement.hpp>
+# include <yampi/environment.hpp>
 # if MPI_VERSION >= 4
 #   include <yampi/count.hpp>
+# else // MPI_VERSION >= 4
+#   include <yampi/large_count.hpp>
 # endif // MPI_VERSION >= 4
 
 # if __cplusplus >= 201703L
@@ -36,12 +40,17 @@ namespace yampi
     ::yampi::count count_;
 # else // MPI_VERSION >= 4
     int count_;
+    // the number of elements, which may exceed INT_MAX (see <yampi/large_count.hpp>)
+    std::ptrdiff_t large_count_;
 # endif // MPI_VERSION >= 4
     ::yampi::datatype const* datatype_ptr_;
 
    public:
     target_buffer(::yampi::displacement const displacement, ::yampi::datatype const& datatype) noexcept
       : displacement_{displacement}, count_{1},
+# if MPI_VERSION < 4
+        large_count_{1},
+# endif // MPI_VERSION < 4
         datatype_ptr_{std::addressof(datatype)}
     { assert(displacement >= ::yampi::displacement{MPI_Aint{0}}); }
 
@@ -54,8 +63,9 @@ namespace yampi
       assert(count >= ::yampi::count{0});
     }
 # else // MPI_VERSION >= 4
-    target_buffer(::yampi::displacement const displacement, int const count, ::yampi::datatype const& datatype) noexcept
-      : displacement_{displacement}, count_{count},
+    target_buffer(
+      ::yampi::displacement const displacement, std::ptrdiff_t const count, ::yampi::datatype const& datatype) noexcept
+      : displacement_{displacement}, count_{static_cast<int>(count)}, large_count_{count},
         datatype_ptr_{std::addressof(datatype)}
     {
       assert(displacement >= ::yampi::displacement{MPI_Aint{0}});
@@ -69,8 +79,22 @@ namespace yampi
     ::yampi::displacement const& displacement() const noexcept { return displacement_; }
 # if MPI_VERSION >= 4
     ::yampi::count const& count() const noexcept { return count_; }
+    ::yampi::count const& count(::yampi::environment const&) const noexcept { return count_; }
 # else // MPI_VERSION >= 4
-    int const& count() const noexcept { return count_; }
+    // count() only for at most INT_MAX elements; wrappers handling more use large_count() (see <yampi/large_count.hpp>)
+    int const& count() const noexcept
+    {
+      assert(large_count_ <= ::yampi::large_count_detail::max_count);
+      return count_;
+    }
+    // throws ::yampi::error with MPI_ERR_COUNT for more than INT_MAX elements
+    int const& count(::yampi::environment const& environment) const
+    {
+      return large_count_ <= ::yampi::large_count_detail::max_count
+        ? count_
+        : throw ::yampi::error{MPI_ERR_COUNT, "yampi::target_buffer::count", environment};
+    }
+    std::ptrdiff_t large_count() const noexcept { return large_count_; }
 # endif // MPI_VERSION >= 4
     ::yampi::datatype const& datatype() const noexcept { return *datatype_ptr_; }
 
@@ -79,6 +103,9 @@ namespace yampi
       using std::swap;
       swap(displacement_, other.displacement_);
       swap(count_, other.count_);
+# if MPI_VERSION < 4
+      swap(large_count_, other.large_count_);
+# endif // MPI_VERSION < 4
       swap(datatype_ptr_, other.datatype_ptr_);
     }
   }; // class target_buffer<T, Enable>
@@ -91,11 +118,16 @@ namespace yampi
     ::yampi::count count_;
 # else // MPI_VERSION >= 4
     int count_;
+    // the number of elements, which may exceed INT_MAX (see <yampi/large_count.hpp>)
+    std::ptrdiff_t large_count_;
 # endif // MPI_VERSION >= 4
 
    public:
     explicit target_buffer(::yampi::displacement const displacement) noexcept
       : displacement_{displacement}, count_{1}
+# if MPI_VERSION < 4
+        , large_count_{1}
+# endif // MPI_VERSION < 4
     { assert(displacement >= ::yampi::displacement{MPI_Aint{0}}); }
 
 # if MPI_VERSION >= 4
@@ -106,8 +138,8 @@ namespace yampi
       assert(count >= ::yampi::count{0});
     }
 # else // MPI_VERSION >= 4
-    target_buffer(::yampi::displacement const displacement, int const count) noexcept
-      : displacement_{displacement}, count_{count}
+    target_buffer(::yampi::displacement const displacement, std::ptrdiff_t const count) noexcept
+      : displacement_{displacement}, count_{static_cast<int>(count)}, large_count_{count}
     {
       assert(displacement >= ::yampi::displacement{MPI_Aint{0}});
       assert(count >= 0);
@@ -120,8 +152,22 @@ namespace yampi
     ::yampi::displacement const& displacement() const noexcept { return displacement_; }
 # if MPI_VERSION >= 4
     ::yampi::count const& count() const noexcept { return count_; }
+    ::yampi::count const& count(::yampi::environment const&) const noexcept { return count_; }
 # else // MPI_VERSION >= 4
-    int const& count() const noexcept { return count_; }
+    // count() only for at most INT_MAX elements; wrappers handling more use large_count() (see <yampi/large_count.hpp>)
+    int const& count() const noexcept
+    {
+      assert(large_count_ <= ::yampi::large_count_detail::max_count);
+      return count_;
+    }
+    // throws ::yampi::error with MPI_ERR_COUNT for more than INT_MAX elements
+    int const& count(::yampi::environment const& environment) const
+    {
+      return large_count_ <= ::yampi::large_count_detail::max_count
+        ? count_
+        : throw ::yampi::error{MPI_ERR_COUNT, "yampi::target_buffer::count", environment};
+    }
+    std::ptrdiff_t large_count() const noexcept { return large_count_; }
 # endif // MPI_VERSION >= 4
     ::yampi::predefined_datatype<T> datatype() const noexcept { return ::yampi::predefined_datatype<T>(); }
 
@@ -130,6 +176,9 @@ namespace yampi
       using std::swap;
       swap(displacement_, other.displacement_);
       swap(count_, other.count_);
+# if MPI_VERSION < 4
+      swap(large_count_, other.large_count_);
+# endif // MPI_VERSION < 4
     }
   }; // class target_buffer<T, typename std::enable_if< ::yampi::has_predefined_datatype<T>::value >::type>
 
@@ -159,17 +208,17 @@ namespace yampi
 
   template <typename T>
   inline
-  typename std::enable_if< ::yampi::has_predefined_datatype<T>::value, ::yampi::target_buffer<T> >::type make_target_buffer(::yampi::displacement const displacement, int count)
+  typename std::enable_if< ::yampi::has_predefined_datatype<T>::value, ::yampi::target_buffer<T> >::type make_target_buffer(::yampi::displacement const displacement, std::ptrdiff_t count)
     noexcept(noexcept(::yampi::target_buffer<T>(displacement, count)))
   { return ::yampi::target_buffer<T>(displacement, count); }
 
   template <typename T>
-  inline ::yampi::target_buffer<T> make_target_buffer(::yampi::displacement const displacement, int count, ::yampi::predefined_datatype<T> const&)
+  inline ::yampi::target_buffer<T> make_target_buffer(::yampi::displacement const displacement, std::ptrdiff_t count, ::yampi::predefined_datatype<T> const&)
     noexcept(noexcept(::yampi::target_buffer<T>(displacement, count)))
   { return ::yampi::target_buffer<T>(displacement, count); }
 
   template <typename T>
-  inline ::yampi::target_buffer<T> make_target_buffer(::yampi::displacement const displacement, int count, ::yampi::datatype const& datatype)
+  inline ::yampi::target_buffer<T> make_target_buffer(::yampi::displacement const displacement, std::ptrdiff_t count, ::yampi::datatype const& datatype)
     noexcept(noexcept(::yampi::target_buffer<T>(displacement, count, datatype)))
   { return ::yampi::target_buffer<T>(displacement, count, datatype); }
 }
@@ -14,6 +14,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -23,6 +25,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_all", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -35,6 +39,7 @@ namespace yampi
       = MPI_Testall(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(flag), reinterpret_cast<MPI_Status*>(std::addressof(*out)));
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
 
     return error_code == MPI_SUCCESS
       ? static_cast<bool>(flag)
@@ -48,6 +53,8 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_all", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
@@ -57,6 +64,7 @@ namespace yampi
       = MPI_Testall(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(flag), MPI_STATUSES_IGNORE);
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
 
     return error_code == MPI_SUCCESS
       ? static_cast<bool>(flag)
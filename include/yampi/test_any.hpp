@@ -14,6 +14,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -22,6 +24,8 @@ namespace yampi
   inline boost::optional<std::pair< ::yampi::status, ContiguousIterator >> test_any(
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_any", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
@@ -33,6 +37,7 @@ namespace yampi
       = MPI_Testany(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(index), std::addressof(flag), std::addressof(mpi_status));
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
 
     return error_code == MPI_SUCCESS
       ? static_cast<bool>(flag)
@@ -48,6 +53,8 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_any", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
@@ -58,6 +65,7 @@ namespace yampi
       = MPI_Testany(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(index), std::addressof(flag), MPI_STATUS_IGNORE);
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and static_cast<bool>(flag));
 
     return error_code == MPI_SUCCESS
       ? static_cast<bool>(flag)
@@ -14,6 +14,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -23,6 +25,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const index_out, ContiguousIterator3 const status_out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_some", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -38,6 +42,7 @@ namespace yampi
       = MPI_Testsome(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(count), std::addressof(*index_out), reinterpret_cast<MPI_Status*>(std::addressof(*status_out)));
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and count != MPI_UNDEFINED and count > 0);
 
     return error_code == MPI_SUCCESS
       ? count != MPI_UNDEFINED
@@ -52,6 +57,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::test_some", 0u);
+    YAMPI_TIME_REQUEST_TEST(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -64,6 +71,7 @@ namespace yampi
       = MPI_Testsome(
           static_cast<int>(last - first), reinterpret_cast<MPI_Request*>(std::addressof(*first)),
           std::addressof(count), std::addressof(*out), MPI_STATUSES_IGNORE);
+    YAMPI_COMPLETE_REQUEST_TEST(error_code == MPI_SUCCESS and count != MPI_UNDEFINED and count > 0);
 
     return error_code == MPI_SUCCESS
       ? count != MPI_UNDEFINED
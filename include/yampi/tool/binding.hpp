@@ -0,0 +1,45 @@
+#ifndef YAMPI_TOOL_BINDING_HPP
+# define YAMPI_TOOL_BINDING_HPP
+
+# include <mpi.h>
+
+
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    // the kind of MPI object a variable is bound to
+    enum class binding : int
+    {
+      no_object = MPI_T_BIND_NO_OBJECT,
+      communicator = MPI_T_BIND_MPI_COMM,
+      datatype = MPI_T_BIND_MPI_DATATYPE,
+      error_handler = MPI_T_BIND_MPI_ERRHANDLER,
+      file = MPI_T_BIND_MPI_FILE,
+      group = MPI_T_BIND_MPI_GROUP,
+      operation = MPI_T_BIND_MPI_OP,
+      request = MPI_T_BIND_MPI_REQUEST,
+      window = MPI_T_BIND_MPI_WIN,
+      message = MPI_T_BIND_MPI_MESSAGE,
+      information = MPI_T_BIND_MPI_INFO
+    };
+
+    enum class verbosity : int
+    {
+      user_basic = MPI_T_VERBOSITY_USER_BASIC,
+      user_detail = MPI_T_VERBOSITY_USER_DETAIL,
+      user_all = MPI_T_VERBOSITY_USER_ALL,
+      tuner_basic = MPI_T_VERBOSITY_TUNER_BASIC,
+      tuner_detail = MPI_T_VERBOSITY_TUNER_DETAIL,
+      tuner_all = MPI_T_VERBOSITY_TUNER_ALL,
+      mpidev_basic = MPI_T_VERBOSITY_MPIDEV_BASIC,
+      mpidev_detail = MPI_T_VERBOSITY_MPIDEV_DETAIL,
+      mpidev_all = MPI_T_VERBOSITY_MPIDEV_ALL
+    };
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
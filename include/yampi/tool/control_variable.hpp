@@ -0,0 +1,369 @@
+#ifndef YAMPI_TOOL_CONTROL_VARIABLE_HPP
+# define YAMPI_TOOL_CONTROL_VARIABLE_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+# include <utility>
+# include <memory>
+
+# include <mpi.h>
+
+# include <boost/optional.hpp>
+# include <boost/none.hpp>
+
+# include <yampi/communicator_base.hpp>
+# include <yampi/window_base.hpp>
+# include <yampi/tool/session.hpp>
+# include <yampi/tool/error.hpp>
+# include <yampi/tool/binding.hpp>
+# include <yampi/tool/native_value.hpp>
+
+
+// Control variables (cvars) of the MPI tool information interface.
+//
+//   ::yampi::tool::session session;
+//   auto const index = ::yampi::tool::find_control_variable("coll_tuned_alltoall_algorithm", session);
+//   if (index)
+//   {
+//     ::yampi::tool::control_variable algorithm{*index, session};
+//     {
+//       ::yampi::tool::scoped_control_variable const pairwise{algorithm, 2, session};
+//       ::yampi::complete_exchange(...);
+//     } // the previous value is restored here
+//   }
+//
+// Which variables exist, and when they may be written, is implementation-specific.
+// Variables of scope all or all_eq must be written by all processes (with equal values for all_eq);
+// group and group_eq likewise for the processes of the bound object
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    enum class control_variable_scope : int
+    {
+      constant = MPI_T_SCOPE_CONSTANT,
+      readonly = MPI_T_SCOPE_READONLY,
+      local = MPI_T_SCOPE_LOCAL,
+      group = MPI_T_SCOPE_GROUP,
+      group_eq = MPI_T_SCOPE_GROUP_EQ,
+      all = MPI_T_SCOPE_ALL,
+      all_eq = MPI_T_SCOPE_ALL_EQ
+    };
+
+    struct control_variable_information
+    {
+      int index;
+      std::string name;
+      std::string description;
+      ::yampi::tool::verbosity verbosity;
+      MPI_Datatype mpi_datatype;
+      ::yampi::tool::binding binding;
+      ::yampi::tool::control_variable_scope scope;
+    };
+
+    namespace control_variable_detail
+    {
+      inline int get_information(int const index, ::yampi::tool::control_variable_information& result)
+      {
+        int name_length = 0;
+        int description_length = 0;
+        int verbosity, binding, scope;
+        MPI_Datatype mpi_datatype;
+        MPI_T_enum enumtype;
+        auto error_code
+          = MPI_T_cvar_get_info(
+              index, nullptr, std::addressof(name_length), std::addressof(verbosity),
+              std::addressof(mpi_datatype), std::addressof(enumtype), nullptr, std::addressof(description_length),
+              std::addressof(binding), std::addressof(scope));
+        if (error_code != MPI_SUCCESS)
+          return error_code;
+
+        // lengths include the terminating null characters
+        std::vector<char> name(name_length + 1);
+        std::vector<char> description(description_length + 1);
+        error_code
+          = MPI_T_cvar_get_info(
+              index, name.data(), std::addressof(name_length), std::addressof(verbosity),
+              std::addressof(mpi_datatype), std::addressof(enumtype), description.data(), std::addressof(description_length),
+              std::addressof(binding), std::addressof(scope));
+        if (error_code != MPI_SUCCESS)
+          return error_code;
+
+        result
+          = ::yampi::tool::control_variable_information{
+              index, name.data(), description.data(),
+              static_cast< ::yampi::tool::verbosity >(verbosity), mpi_datatype,
+              static_cast< ::yampi::tool::binding >(binding),
+              static_cast< ::yampi::tool::control_variable_scope >(scope)};
+        return MPI_SUCCESS;
+      }
+    }
+
+    inline int num_control_variables(::yampi::tool::session const&)
+    {
+      int result;
+      auto const error_code = MPI_T_cvar_get_num(std::addressof(result));
+      return error_code == MPI_SUCCESS
+        ? result
+        : throw ::yampi::tool::error{error_code, "yampi::tool::num_control_variables"};
+    }
+
+    inline ::yampi::tool::control_variable_information control_variable_information_of(
+      int const index, ::yampi::tool::session const&)
+    {
+      ::yampi::tool::control_variable_information result;
+      auto const error_code = ::yampi::tool::control_variable_detail::get_information(index, result);
+      return error_code == MPI_SUCCESS
+        ? result
+        : throw ::yampi::tool::error{error_code, "yampi::tool::control_variable_information_of"};
+    }
+
+    // Indices of unavailable variables are skipped
+    inline std::vector< ::yampi::tool::control_variable_information > control_variable_informations(
+      ::yampi::tool::session const& session)
+    {
+      auto const num_variables = ::yampi::tool::num_control_variables(session);
+
+      std::vector< ::yampi::tool::control_variable_information > result;
+      result.reserve(num_variables);
+      for (auto index = 0; index < num_variables; ++index)
+      {
+        ::yampi::tool::control_variable_information information;
+        auto const error_code = ::yampi::tool::control_variable_detail::get_information(index, information);
+        if (::yampi::tool::error_detail::is_unavailable(error_code))
+          continue;
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::control_variable_informations"};
+
+        result.push_back(std::move(information));
+      }
+
+      return result;
+    }
+
+    inline boost::optional<int> find_control_variable(std::string const& name, ::yampi::tool::session const& session)
+    {
+# if (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+      static_cast<void>(session);
+      int result;
+      auto const error_code = MPI_T_cvar_get_index(name.c_str(), std::addressof(result));
+      if (error_code == MPI_T_ERR_INVALID_NAME)
+        return boost::none;
+
+      return error_code == MPI_SUCCESS
+        ? boost::make_optional(result)
+        : throw ::yampi::tool::error{error_code, "yampi::tool::find_control_variable"};
+# else // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+      auto const num_variables = ::yampi::tool::num_control_variables(session);
+      for (auto index = 0; index < num_variables; ++index)
+      {
+        ::yampi::tool::control_variable_information information;
+        auto const error_code = ::yampi::tool::control_variable_detail::get_information(index, information);
+        if (::yampi::tool::error_detail::is_unavailable(error_code))
+          continue;
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::find_control_variable"};
+
+        if (information.name == name)
+          return index;
+      }
+
+      return boost::none;
+# endif // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+    }
+
+    class control_variable
+    {
+      MPI_T_cvar_handle mpi_cvar_handle_;
+      int count_;
+      ::yampi::tool::control_variable_information information_;
+      // values in the datatype of the variable, allocated once so that reading and writing do not allocate
+      std::vector<char> data_;
+
+     public:
+      // for variables bound to no object, whose values apply to the whole process
+      control_variable(int const index, ::yampi::tool::session const& session)
+        : control_variable{index, static_cast<void*>(nullptr), session}
+      { }
+
+      control_variable(
+        int const index, ::yampi::communicator_base const& communicator, ::yampi::tool::session const& session)
+        : control_variable{index, const_cast<MPI_Comm*>(std::addressof(communicator.mpi_comm())), session}
+      { }
+
+      template <typename Window>
+      control_variable(
+        int const index, ::yampi::window_base<Window> const& window, ::yampi::tool::session const& session)
+        : control_variable{index, const_cast<MPI_Win*>(std::addressof(window.mpi_win())), session}
+      { }
+
+      ~control_variable() noexcept { MPI_T_cvar_handle_free(std::addressof(mpi_cvar_handle_)); }
+
+      control_variable(control_variable const&) = delete;
+      control_variable& operator=(control_variable const&) = delete;
+      control_variable(control_variable&&) = delete;
+      control_variable& operator=(control_variable&&) = delete;
+
+      ::yampi::tool::control_variable_information const& information() const noexcept { return information_; }
+      // the number of values of the variable, or the maximum length of the string if the datatype is MPI_CHAR
+      int count() const noexcept { return count_; }
+
+      // Reads all count() values into [first, first + count()), converted from the datatype of the variable
+      template <typename RandomAccessIterator>
+      void read_all(RandomAccessIterator const first, ::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::control_variable::read_all");
+
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        for (auto index = 0; index < count_; ++index)
+          first[index] = ::yampi::tool::native_value_detail::load<value_type>(data_.data(), information_.mpi_datatype, index);
+      }
+
+      // Reads the first value, converted from the datatype of the variable to Value
+      template <typename Value>
+      Value read(::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::control_variable::read");
+        return ::yampi::tool::native_value_detail::load<Value>(data_.data(), information_.mpi_datatype, 0u);
+      }
+
+      // for variables of MPI_CHAR
+      std::string read_string(::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::control_variable::read_string");
+        return std::string{data_.data()};
+      }
+
+      // Writes count() values from [first, first + count()), converted to the datatype of the variable
+      template <typename RandomAccessIterator>
+      void write_all(RandomAccessIterator const first, ::yampi::tool::session const&)
+      {
+        for (auto index = 0; index < count_; ++index)
+          ::yampi::tool::native_value_detail::store(data_.data(), information_.mpi_datatype, index, first[index]);
+        do_write("yampi::tool::control_variable::write_all");
+      }
+
+      template <typename Value>
+      void write(Value const& value, ::yampi::tool::session const&)
+      {
+        ::yampi::tool::native_value_detail::store(data_.data(), information_.mpi_datatype, 0u, value);
+        do_write("yampi::tool::control_variable::write");
+      }
+
+      // for variables of MPI_CHAR
+      void write_string(std::string const& value, ::yampi::tool::session const&)
+      {
+        if (value.size() >= data_.size())
+          throw ::yampi::tool::error{MPI_T_ERR_INVALID_ITEM, "yampi::tool::control_variable::write_string"};
+
+        std::fill(std::copy(value.begin(), value.end(), data_.begin()), data_.end(), '\0');
+        do_write("yampi::tool::control_variable::write_string");
+      }
+
+      // Values in the datatype of the variable, used to save and restore them without conversion
+      std::vector<char> read_raw(::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::control_variable::read_raw");
+        return data_;
+      }
+
+      void write_raw(std::vector<char> const& raw, ::yampi::tool::session const&)
+      {
+        if (raw.size() != data_.size())
+          throw ::yampi::tool::error{MPI_T_ERR_INVALID_ITEM, "yampi::tool::control_variable::write_raw"};
+
+        data_ = raw;
+        do_write("yampi::tool::control_variable::write_raw");
+      }
+
+      MPI_T_cvar_handle const& mpi_cvar_handle() const noexcept { return mpi_cvar_handle_; }
+
+     private:
+      control_variable(int const index, void* object, ::yampi::tool::session const& session)
+        : mpi_cvar_handle_{}, count_{}, information_{}, data_{}
+      {
+        auto const error_code
+          = MPI_T_cvar_handle_alloc(index, object, std::addressof(mpi_cvar_handle_), std::addressof(count_));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::control_variable::control_variable"};
+
+        try
+        {
+          information_ = ::yampi::tool::control_variable_information_of(index, session);
+          // one more element to keep strings null-terminated
+          data_.resize(
+            (static_cast<std::size_t>(count_) + (information_.mpi_datatype == MPI_CHAR ? 1u : 0u))
+              * ::yampi::tool::native_value_detail::size_of(information_.mpi_datatype));
+        }
+        catch (...)
+        {
+          MPI_T_cvar_handle_free(std::addressof(mpi_cvar_handle_));
+          throw;
+        }
+      }
+
+      void do_read(char const* where)
+      {
+        auto const error_code = MPI_T_cvar_read(mpi_cvar_handle_, data_.data());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, where};
+      }
+
+      void do_write(char const* where)
+      {
+        auto const error_code = MPI_T_cvar_write(mpi_cvar_handle_, data_.data());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, where};
+      }
+    };
+
+    // Writes a control variable and restores its previous value on destruction.
+    // Errors while restoring are ignored, since the variable may not be settable anymore (MPI_T_ERR_CVAR_SET_NOT_NOW)
+    class scoped_control_variable
+    {
+      ::yampi::tool::control_variable& control_variable_;
+      ::yampi::tool::session const& session_;
+      std::vector<char> saved_;
+
+     public:
+      template <typename Value>
+      scoped_control_variable(
+        ::yampi::tool::control_variable& control_variable, Value const& value, ::yampi::tool::session const& session)
+        : control_variable_{control_variable}, session_{session}, saved_{control_variable.read_raw(session)}
+      { control_variable_.write(value, session); }
+
+      scoped_control_variable(
+        ::yampi::tool::control_variable& control_variable, std::string const& value, ::yampi::tool::session const& session)
+        : control_variable_{control_variable}, session_{session}, saved_{control_variable.read_raw(session)}
+      { control_variable_.write_string(value, session); }
+
+      scoped_control_variable(
+        ::yampi::tool::control_variable& control_variable, char const* value, ::yampi::tool::session const& session)
+        : scoped_control_variable{control_variable, std::string{value}, session}
+      { }
+
+      ~scoped_control_variable() noexcept
+      {
+        try
+        {
+          control_variable_.write_raw(saved_, session_);
+        }
+        catch (...)
+        { }
+      }
+
+      scoped_control_variable(scoped_control_variable const&) = delete;
+      scoped_control_variable& operator=(scoped_control_variable const&) = delete;
+      scoped_control_variable(scoped_control_variable&&) = delete;
+      scoped_control_variable& operator=(scoped_control_variable&&) = delete;
+    };
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef YAMPI_TOOL_ERROR_HPP
+# define YAMPI_TOOL_ERROR_HPP
+
+# include <string>
+# include <stdexcept>
+
+# include <mpi.h>
+
+
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    // MPI_T functions return MPI_T_ERR_* codes, which MPI_Error_string is not required to know
+    // (and MPI_T may be used outside MPI_Init/MPI_Finalize), so they are reported by this class instead of ::yampi::error
+    class error
+      : public std::runtime_error
+    {
+      int error_code_;
+
+     public:
+      error(int const error_code, std::string const& where)
+        : std::runtime_error{(std::string("In ") + where + ": " + generate_error_string(error_code)).c_str()},
+          error_code_{error_code}
+      { }
+
+      int error_code() const { return error_code_; }
+
+     private:
+      static std::string generate_error_string(int const error_code)
+      {
+        switch (error_code)
+        {
+         case MPI_T_ERR_MEMORY: return "out of memory";
+         case MPI_T_ERR_NOT_INITIALIZED: return "interface not initialized";
+         case MPI_T_ERR_CANNOT_INIT: return "interface not in the state to be initialized";
+         case MPI_T_ERR_INVALID_INDEX: return "the index is invalid or has been deleted";
+         case MPI_T_ERR_INVALID_ITEM: return "item index queried is out of range";
+         case MPI_T_ERR_INVALID_HANDLE: return "the handle is invalid";
+         case MPI_T_ERR_OUT_OF_HANDLES: return "no more handles available";
+         case MPI_T_ERR_OUT_OF_SESSIONS: return "no more sessions available";
+         case MPI_T_ERR_INVALID_SESSION: return "session argument is not a valid session";
+         case MPI_T_ERR_CVAR_SET_NOT_NOW: return "variable cannot be set at this moment";
+         case MPI_T_ERR_CVAR_SET_NEVER: return "variable cannot be set until end of execution";
+         case MPI_T_ERR_PVAR_NO_STARTSTOP: return "variable cannot be started or stopped";
+         case MPI_T_ERR_PVAR_NO_WRITE: return "variable cannot be written or reset";
+         case MPI_T_ERR_PVAR_NO_ATOMIC: return "variable cannot be read and written atomically";
+#   if (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+         case MPI_T_ERR_INVALID_NAME: return "name doesn't match";
+         case MPI_T_ERR_INVALID: return "invalid use of the interface or bad parameter value";
+#   endif // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+         default: return "unknown MPI_T error (" + std::to_string(error_code) + ")";
+        }
+      }
+    };
+
+    namespace error_detail
+    {
+      // Implementations report removed or not-yet-registered variables in either way
+      inline bool is_unavailable(int const error_code) noexcept
+      {
+#   if (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+        return error_code == MPI_T_ERR_INVALID_INDEX or error_code == MPI_T_ERR_INVALID;
+#   else // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+        return error_code == MPI_T_ERR_INVALID_INDEX;
+#   endif // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+      }
+    }
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef YAMPI_TOOL_NATIVE_VALUE_HPP
+# define YAMPI_TOOL_NATIVE_VALUE_HPP
+
+# include <cstddef>
+# include <cstring>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/tool/error.hpp>
+
+
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    // MPI_T variables have one of the datatypes MPI_INT, MPI_UNSIGNED, MPI_UNSIGNED_LONG, MPI_UNSIGNED_LONG_LONG,
+    // MPI_COUNT, MPI_CHAR or MPI_DOUBLE. These functions convert values of them from/to arithmetic types
+    namespace native_value_detail
+    {
+      inline std::size_t size_of(MPI_Datatype const datatype)
+      {
+        if (datatype == MPI_INT)
+          return sizeof(int);
+        else if (datatype == MPI_UNSIGNED)
+          return sizeof(unsigned int);
+        else if (datatype == MPI_UNSIGNED_LONG)
+          return sizeof(unsigned long);
+        else if (datatype == MPI_UNSIGNED_LONG_LONG)
+          return sizeof(unsigned long long);
+        else if (datatype == MPI_COUNT)
+          return sizeof(MPI_Count);
+        else if (datatype == MPI_CHAR)
+          return sizeof(char);
+        else if (datatype == MPI_DOUBLE)
+          return sizeof(double);
+
+        throw ::yampi::tool::error{MPI_T_ERR_INVALID_ITEM, "yampi::tool::native_value_detail::size_of"};
+      }
+
+      template <typename Native, typename Value>
+      inline Value load_as(void const* data, std::size_t const index) noexcept
+      {
+        Native result;
+        std::memcpy(std::addressof(result), static_cast<char const*>(data) + index * sizeof(Native), sizeof(Native));
+        return static_cast<Value>(result);
+      }
+
+      template <typename Value>
+      inline Value load(void const* data, MPI_Datatype const datatype, std::size_t const index)
+      {
+        if (datatype == MPI_INT)
+          return load_as<int, Value>(data, index);
+        else if (datatype == MPI_UNSIGNED)
+          return load_as<unsigned int, Value>(data, index);
+        else if (datatype == MPI_UNSIGNED_LONG)
+          return load_as<unsigned long, Value>(data, index);
+        else if (datatype == MPI_UNSIGNED_LONG_LONG)
+          return load_as<unsigned long long, Value>(data, index);
+        else if (datatype == MPI_COUNT)
+          return load_as<MPI_Count, Value>(data, index);
+        else if (datatype == MPI_CHAR)
+          return load_as<char, Value>(data, index);
+        else if (datatype == MPI_DOUBLE)
+          return load_as<double, Value>(data, index);
+
+        throw ::yampi::tool::error{MPI_T_ERR_INVALID_ITEM, "yampi::tool::native_value_detail::load"};
+      }
+
+      template <typename Native, typename Value>
+      inline void store_as(void* data, std::size_t const index, Value const value) noexcept
+      {
+        auto const native = static_cast<Native>(value);
+        std::memcpy(static_cast<char*>(data) + index * sizeof(Native), std::addressof(native), sizeof(Native));
+      }
+
+      template <typename Value>
+      inline void store(void* data, MPI_Datatype const datatype, std::size_t const index, Value const value)
+      {
+        if (datatype == MPI_INT)
+          store_as<int>(data, index, value);
+        else if (datatype == MPI_UNSIGNED)
+          store_as<unsigned int>(data, index, value);
+        else if (datatype == MPI_UNSIGNED_LONG)
+          store_as<unsigned long>(data, index, value);
+        else if (datatype == MPI_UNSIGNED_LONG_LONG)
+          store_as<unsigned long long>(data, index, value);
+        else if (datatype == MPI_COUNT)
+          store_as<MPI_Count>(data, index, value);
+        else if (datatype == MPI_CHAR)
+          store_as<char>(data, index, value);
+        else if (datatype == MPI_DOUBLE)
+          store_as<double>(data, index, value);
+        else
+          throw ::yampi::tool::error{MPI_T_ERR_INVALID_ITEM, "yampi::tool::native_value_detail::store"};
+      }
+    }
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef YAMPI_TOOL_PERFORMANCE_VARIABLE_HPP
+# define YAMPI_TOOL_PERFORMANCE_VARIABLE_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <iterator>
+# include <utility>
+# include <memory>
+
+# include <mpi.h>
+
+# include <boost/optional.hpp>
+# include <boost/none.hpp>
+
+# include <yampi/communicator_base.hpp>
+# include <yampi/window_base.hpp>
+# include <yampi/tool/session.hpp>
+# include <yampi/tool/error.hpp>
+# include <yampi/tool/binding.hpp>
+# include <yampi/tool/native_value.hpp>
+
+
+// Performance variables (pvars) of the MPI tool information interface.
+//
+//   ::yampi::tool::session session;
+//   ::yampi::tool::performance_session performance_session{session};
+//   auto const index = ::yampi::tool::find_performance_variable("pml_ob1_unexpected_msgq_length", session);
+//   if (index)
+//   {
+//     ::yampi::tool::performance_variable unexpected{performance_session, *index, communicator, session};
+//     ... = unexpected.read<std::size_t>(session);
+//   }
+//
+// Which variables exist is implementation-specific; enumerate them with performance_variable_informations
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    enum class performance_variable_class : int
+    {
+      state = MPI_T_PVAR_CLASS_STATE,
+      level = MPI_T_PVAR_CLASS_LEVEL,
+      size = MPI_T_PVAR_CLASS_SIZE,
+      percentage = MPI_T_PVAR_CLASS_PERCENTAGE,
+      high_watermark = MPI_T_PVAR_CLASS_HIGHWATERMARK,
+      low_watermark = MPI_T_PVAR_CLASS_LOWWATERMARK,
+      counter = MPI_T_PVAR_CLASS_COUNTER,
+      aggregate = MPI_T_PVAR_CLASS_AGGREGATE,
+      timer = MPI_T_PVAR_CLASS_TIMER,
+      generic = MPI_T_PVAR_CLASS_GENERIC
+    };
+
+    struct performance_variable_information
+    {
+      int index;
+      std::string name;
+      std::string description;
+      ::yampi::tool::verbosity verbosity;
+      ::yampi::tool::performance_variable_class variable_class;
+      MPI_Datatype mpi_datatype;
+      ::yampi::tool::binding binding;
+      bool is_readonly;
+      bool is_continuous;
+      bool is_atomic;
+    };
+
+    namespace performance_variable_detail
+    {
+      inline int get_information(int const index, ::yampi::tool::performance_variable_information& result)
+      {
+        int name_length = 0;
+        int description_length = 0;
+        int verbosity, variable_class, binding, is_readonly, is_continuous, is_atomic;
+        MPI_Datatype mpi_datatype;
+        MPI_T_enum enumtype;
+        auto error_code
+          = MPI_T_pvar_get_info(
+              index, nullptr, std::addressof(name_length), std::addressof(verbosity), std::addressof(variable_class),
+              std::addressof(mpi_datatype), std::addressof(enumtype), nullptr, std::addressof(description_length),
+              std::addressof(binding), std::addressof(is_readonly), std::addressof(is_continuous), std::addressof(is_atomic));
+        if (error_code != MPI_SUCCESS)
+          return error_code;
+
+        // lengths include the terminating null characters
+        std::vector<char> name(name_length + 1);
+        std::vector<char> description(description_length + 1);
+        error_code
+          = MPI_T_pvar_get_info(
+              index, name.data(), std::addressof(name_length), std::addressof(verbosity), std::addressof(variable_class),
+              std::addressof(mpi_datatype), std::addressof(enumtype), description.data(), std::addressof(description_length),
+              std::addressof(binding), std::addressof(is_readonly), std::addressof(is_continuous), std::addressof(is_atomic));
+        if (error_code != MPI_SUCCESS)
+          return error_code;
+
+        result
+          = ::yampi::tool::performance_variable_information{
+              index, name.data(), description.data(),
+              static_cast< ::yampi::tool::verbosity >(verbosity),
+              static_cast< ::yampi::tool::performance_variable_class >(variable_class),
+              mpi_datatype, static_cast< ::yampi::tool::binding >(binding),
+              static_cast<bool>(is_readonly), static_cast<bool>(is_continuous), static_cast<bool>(is_atomic)};
+        return MPI_SUCCESS;
+      }
+    }
+
+    inline int num_performance_variables(::yampi::tool::session const&)
+    {
+      int result;
+      auto const error_code = MPI_T_pvar_get_num(std::addressof(result));
+      return error_code == MPI_SUCCESS
+        ? result
+        : throw ::yampi::tool::error{error_code, "yampi::tool::num_performance_variables"};
+    }
+
+    inline ::yampi::tool::performance_variable_information performance_variable_information_of(
+      int const index, ::yampi::tool::session const&)
+    {
+      ::yampi::tool::performance_variable_information result;
+      auto const error_code = ::yampi::tool::performance_variable_detail::get_information(index, result);
+      return error_code == MPI_SUCCESS
+        ? result
+        : throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable_information_of"};
+    }
+
+    // Indices of unavailable variables are skipped
+    inline std::vector< ::yampi::tool::performance_variable_information > performance_variable_informations(
+      ::yampi::tool::session const& session)
+    {
+      auto const num_variables = ::yampi::tool::num_performance_variables(session);
+
+      std::vector< ::yampi::tool::performance_variable_information > result;
+      result.reserve(num_variables);
+      for (auto index = 0; index < num_variables; ++index)
+      {
+        ::yampi::tool::performance_variable_information information;
+        auto const error_code = ::yampi::tool::performance_variable_detail::get_information(index, information);
+        if (::yampi::tool::error_detail::is_unavailable(error_code))
+          continue;
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable_informations"};
+
+        result.push_back(std::move(information));
+      }
+
+      return result;
+    }
+
+    // Variables of different classes may share a name. This returns the index of the first one
+    inline boost::optional<int> find_performance_variable(std::string const& name, ::yampi::tool::session const& session)
+    {
+      auto const num_variables = ::yampi::tool::num_performance_variables(session);
+      for (auto index = 0; index < num_variables; ++index)
+      {
+        ::yampi::tool::performance_variable_information information;
+        auto const error_code = ::yampi::tool::performance_variable_detail::get_information(index, information);
+        if (::yampi::tool::error_detail::is_unavailable(error_code))
+          continue;
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::find_performance_variable"};
+
+        if (information.name == name)
+          return index;
+      }
+
+      return boost::none;
+    }
+
+# if (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+    inline boost::optional<int> find_performance_variable(
+      std::string const& name, ::yampi::tool::performance_variable_class const variable_class,
+      ::yampi::tool::session const&)
+    {
+      int result;
+      auto const error_code = MPI_T_pvar_get_index(name.c_str(), static_cast<int>(variable_class), std::addressof(result));
+      if (error_code == MPI_T_ERR_INVALID_NAME)
+        return boost::none;
+
+      return error_code == MPI_SUCCESS
+        ? boost::make_optional(result)
+        : throw ::yampi::tool::error{error_code, "yampi::tool::find_performance_variable"};
+    }
+# endif // (MPI_VERSION > 3) || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+
+    // Handles of performance variables are allocated in a performance session,
+    // which isolates them from other tools reading the same variables
+    class performance_session
+    {
+      MPI_T_pvar_session mpi_pvar_session_;
+
+     public:
+      explicit performance_session(::yampi::tool::session const&)
+        : mpi_pvar_session_{}
+      {
+        auto const error_code = MPI_T_pvar_session_create(std::addressof(mpi_pvar_session_));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_session::performance_session"};
+      }
+
+      ~performance_session() noexcept { MPI_T_pvar_session_free(std::addressof(mpi_pvar_session_)); }
+
+      performance_session(performance_session const&) = delete;
+      performance_session& operator=(performance_session const&) = delete;
+      performance_session(performance_session&&) = delete;
+      performance_session& operator=(performance_session&&) = delete;
+
+      // start_all, stop_all and reset_all apply to every handle of this session, ignoring those variables
+      // which cannot be started/stopped or written
+      void start_all(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_start(mpi_pvar_session_, MPI_T_PVAR_ALL_HANDLES);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_session::start_all"};
+      }
+
+      void stop_all(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_stop(mpi_pvar_session_, MPI_T_PVAR_ALL_HANDLES);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_session::stop_all"};
+      }
+
+      void reset_all(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_reset(mpi_pvar_session_, MPI_T_PVAR_ALL_HANDLES);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_session::reset_all"};
+      }
+
+      MPI_T_pvar_session const& mpi_pvar_session() const noexcept { return mpi_pvar_session_; }
+    };
+
+    class performance_variable
+    {
+      MPI_T_pvar_session mpi_pvar_session_;
+      MPI_T_pvar_handle mpi_pvar_handle_;
+      int count_;
+      ::yampi::tool::performance_variable_information information_;
+      // read buffer, allocated once so that reading does not allocate
+      std::vector<char> data_;
+
+     public:
+      // for variables bound to no object
+      performance_variable(
+        ::yampi::tool::performance_session const& performance_session, int const index,
+        ::yampi::tool::session const& session)
+        : performance_variable{performance_session.mpi_pvar_session(), index, nullptr, session}
+      { }
+
+      performance_variable(
+        ::yampi::tool::performance_session const& performance_session, int const index,
+        ::yampi::communicator_base const& communicator, ::yampi::tool::session const& session)
+        : performance_variable{
+            performance_session.mpi_pvar_session(), index,
+            const_cast<MPI_Comm*>(std::addressof(communicator.mpi_comm())), session}
+      { }
+
+      template <typename Window>
+      performance_variable(
+        ::yampi::tool::performance_session const& performance_session, int const index,
+        ::yampi::window_base<Window> const& window, ::yampi::tool::session const& session)
+        : performance_variable{
+            performance_session.mpi_pvar_session(), index,
+            const_cast<MPI_Win*>(std::addressof(window.mpi_win())), session}
+      { }
+
+      ~performance_variable() noexcept
+      { MPI_T_pvar_handle_free(mpi_pvar_session_, std::addressof(mpi_pvar_handle_)); }
+
+      performance_variable(performance_variable const&) = delete;
+      performance_variable& operator=(performance_variable const&) = delete;
+      performance_variable(performance_variable&&) = delete;
+      performance_variable& operator=(performance_variable&&) = delete;
+
+      ::yampi::tool::performance_variable_information const& information() const noexcept { return information_; }
+      // the number of values of the variable
+      int count() const noexcept { return count_; }
+
+      // Continuous variables are always started, and throw MPI_T_ERR_PVAR_NO_STARTSTOP
+      void start(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_start(mpi_pvar_session_, mpi_pvar_handle_);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable::start"};
+      }
+
+      void stop(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_stop(mpi_pvar_session_, mpi_pvar_handle_);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable::stop"};
+      }
+
+      void reset(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_reset(mpi_pvar_session_, mpi_pvar_handle_);
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable::reset"};
+      }
+
+      // Reads all count() values into [first, first + count()), converted from the datatype of the variable
+      template <typename RandomAccessIterator>
+      void read_all(RandomAccessIterator const first, ::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::performance_variable::read_all");
+
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        for (auto index = 0; index < count_; ++index)
+          first[index] = ::yampi::tool::native_value_detail::load<value_type>(data_.data(), information_.mpi_datatype, index);
+      }
+
+      // Reads the first value, converted from the datatype of the variable to Value
+      template <typename Value>
+      Value read(::yampi::tool::session const&)
+      {
+        do_read("yampi::tool::performance_variable::read");
+        return ::yampi::tool::native_value_detail::load<Value>(data_.data(), information_.mpi_datatype, 0u);
+      }
+
+      // Reads the first value and resets the variable atomically, if information().is_atomic
+      template <typename Value>
+      Value read_reset(::yampi::tool::session const&)
+      {
+        auto const error_code = MPI_T_pvar_readreset(mpi_pvar_session_, mpi_pvar_handle_, data_.data());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable::read_reset"};
+        return ::yampi::tool::native_value_detail::load<Value>(data_.data(), information_.mpi_datatype, 0u);
+      }
+
+      MPI_T_pvar_handle const& mpi_pvar_handle() const noexcept { return mpi_pvar_handle_; }
+
+     private:
+      performance_variable(
+        MPI_T_pvar_session const mpi_pvar_session, int const index, void* object, ::yampi::tool::session const& session)
+        : mpi_pvar_session_{mpi_pvar_session}, mpi_pvar_handle_{}, count_{}, information_{}, data_{}
+      {
+        auto const error_code
+          = MPI_T_pvar_handle_alloc(
+              mpi_pvar_session_, index, object, std::addressof(mpi_pvar_handle_), std::addressof(count_));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::performance_variable::performance_variable"};
+
+        try
+        {
+          information_ = ::yampi::tool::performance_variable_information_of(index, session);
+          data_.resize(
+            static_cast<std::size_t>(count_) * ::yampi::tool::native_value_detail::size_of(information_.mpi_datatype));
+        }
+        catch (...)
+        {
+          MPI_T_pvar_handle_free(mpi_pvar_session_, std::addressof(mpi_pvar_handle_));
+          throw;
+        }
+      }
+
+      void do_read(char const* where)
+      {
+        auto const error_code = MPI_T_pvar_read(mpi_pvar_session_, mpi_pvar_handle_, data_.data());
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, where};
+      }
+    };
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef YAMPI_TOOL_SESSION_HPP
+# define YAMPI_TOOL_SESSION_HPP
+
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/thread_support.hpp>
+# include <yampi/tool/error.hpp>
+
+
+# if MPI_VERSION >= 3
+namespace yampi
+{
+  namespace tool
+  {
+    // Initializes the MPI tool information interface. Calls of MPI_T_init_thread and MPI_T_finalize are reference
+    // counted, so sessions may be nested. The standard allows sessions outside MPI_Init/MPI_Finalize, but some
+    // implementations crash if MPI_T_finalize follows MPI_Finalize, so prefer sessions within the lifetime of environment.
+    // Every function in ::yampi::tool takes a session as its last argument, as ::yampi::environment elsewhere
+    class session
+    {
+      ::yampi::thread_support thread_support_;
+
+     public:
+      session()
+        : session{::yampi::thread_support::single}
+      { }
+
+      explicit session(::yampi::thread_support const thread_support)
+        : thread_support_{}
+      {
+        int provided_thread_support;
+        auto const error_code
+          = MPI_T_init_thread(static_cast<int>(thread_support), std::addressof(provided_thread_support));
+        if (error_code != MPI_SUCCESS)
+          throw ::yampi::tool::error{error_code, "yampi::tool::session::session"};
+
+        thread_support_ = static_cast< ::yampi::thread_support >(provided_thread_support);
+      }
+
+      ~session() noexcept { MPI_T_finalize(); }
+
+      session(session const&) = delete;
+      session& operator=(session const&) = delete;
+      session(session&&) = delete;
+      session& operator=(session&&) = delete;
+
+      ::yampi::thread_support thread_support() const noexcept { return thread_support_; }
+    };
+  }
+}
+# endif // MPI_VERSION >= 3
+
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef YAMPI_UNPACK_HPP
+# define YAMPI_UNPACK_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <iterator>
+# include <type_traits>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/datatype.hpp>
+# include <yampi/count.hpp>
+# include <yampi/communicator_base.hpp>
+# include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/pack.hpp>
+
+
+// Unpacking, the inverse of <yampi/pack.hpp>.
+//
+// ::yampi::unpack(in_first, in_last, position, buffer, communicator, environment) wraps MPI_Unpack and returns the
+// position after the read bytes. The user-space overloads
+//   ::yampi::unpack(in, strided_block, count, data)
+//   ::yampi::unpack(in, flexible_blocks, data)
+//   ::yampi::unpack(in, fixed_blocks, data)
+//   ::yampi::unpack(in, size_first, size_last, subsize_first, start_index_first, data)
+// scatter contiguous Value's to the layouts and return the end of the read Value's.
+namespace yampi
+{
+  // MPI_Unpack
+  template <typename ContiguousIterator, typename Value>
+  inline std::size_t unpack(
+    ContiguousIterator const in_first, ContiguousIterator const in_last, std::size_t const position,
+    ::yampi::buffer<Value> buffer,
+    ::yampi::communicator_base const& communicator, ::yampi::environment const& environment)
+  {
+    static_assert(
+      sizeof(typename std::iterator_traits<ContiguousIterator>::value_type) == 1u,
+      "The value type of ContiguousIterator must be a byte");
+    assert(in_last >= in_first);
+    YAMPI_PROFILE_SCOPE("yampi::unpack", ::yampi::profiler::num_bytes(buffer, environment));
+
+    using in_value_type = typename std::remove_cv<typename std::iterator_traits<ContiguousIterator>::value_type>::type;
+    // some implementations reject null pointers even if nothing is read
+    char empty_in;
+    auto const in
+      = in_first == in_last
+        ? static_cast<void*>(std::addressof(empty_in))
+        : static_cast<void*>(const_cast<in_value_type*>(std::addressof(*in_first)));
+# if MPI_VERSION >= 4
+    auto result = static_cast<MPI_Count>(position);
+    auto const error_code
+      = MPI_Unpack_c(
+          in, static_cast<MPI_Count>(in_last - in_first), std::addressof(result),
+          buffer.data(), buffer.count().mpi_count(), buffer.datatype().mpi_datatype(), communicator.mpi_comm());
+# else // MPI_VERSION >= 4
+    auto result = static_cast<int>(position);
+    auto const error_code
+      = MPI_Unpack(
+          in, static_cast<int>(in_last - in_first), std::addressof(result),
+          buffer.data(), buffer.count(environment), buffer.datatype().mpi_datatype(), communicator.mpi_comm());
+# endif // MPI_VERSION >= 4
+    if (error_code != MPI_SUCCESS)
+      throw ::yampi::error{error_code, "yampi::unpack", environment};
+    return static_cast<std::size_t>(result);
+  }
+
+  // as MPI_Type_vector
+  template <typename Value>
+  inline Value const* unpack(
+    Value const* in, ::yampi::strided_block const& block, ::yampi::count const count, Value* data) noexcept
+  {
+    auto const length = ::yampi::pack_detail::to_ptrdiff(block.length());
+    auto const num_blocks = ::yampi::pack_detail::to_ptrdiff(count);
+    ::yampi::pack_detail::copy_blocks(
+      in, data, num_blocks, length, length, ::yampi::pack_detail::to_ptrdiff(block.stride()));
+    return in + num_blocks * length;
+  }
+
+  // as MPI_Type_indexed
+  template <typename Value>
+  inline Value const* unpack(Value const* in, ::yampi::flexible_blocks const& blocks, Value* data) noexcept
+  {
+    auto const length_first = blocks.length_begin();
+    ::yampi::pack_detail::for_each_run(
+      blocks.displacement_begin(), blocks.displacement_end(),
+      [length_first](std::ptrdiff_t const index) { return ::yampi::pack_detail::to_ptrdiff(length_first[index]); },
+      [&in, data](std::ptrdiff_t const displacement, std::ptrdiff_t const length)
+      {
+        ::yampi::pack_detail::copy_blocks(in, data + displacement, std::ptrdiff_t{1}, length, length, length);
+        in += length;
+      });
+    return in;
+  }
+
+  // as MPI_Type_create_indexed_block
+  template <typename Value>
+  inline Value const* unpack(Value const* in, ::yampi::fixed_blocks const& blocks, Value* data) noexcept
+  {
+    auto const length = ::yampi::pack_detail::to_ptrdiff(blocks.length());
+    ::yampi::pack_detail::for_each_run(
+      blocks.displacement_begin(), blocks.displacement_end(),
+      [length](std::ptrdiff_t) { return length; },
+      [&in, data](std::ptrdiff_t const displacement, std::ptrdiff_t const run_length)
+      {
+        ::yampi::pack_detail::copy_blocks(
+          in, data + displacement, std::ptrdiff_t{1}, run_length, run_length, run_length);
+        in += run_length;
+      });
+    return in;
+  }
+
+  // as MPI_Type_create_subarray with MPI_ORDER_C
+  template <typename Value, typename ContiguousIterator1, typename ContiguousIterator2, typename ContiguousIterator3>
+  inline Value const* unpack(
+    Value const* in,
+    ContiguousIterator1 const array_size_first, ContiguousIterator1 const array_size_last,
+    ContiguousIterator2 const array_subsize_first, ContiguousIterator3 const array_start_index_first,
+    Value* data)
+  {
+    ::yampi::pack_detail::subarray_layout const layout{
+      array_size_first, array_size_last, array_subsize_first, array_start_index_first};
+    layout.for_each_row(
+      [&in, data](
+        std::ptrdiff_t const displacement, std::ptrdiff_t const num_runs, std::ptrdiff_t const stride,
+        std::ptrdiff_t const run_length)
+      {
+        ::yampi::pack_detail::copy_blocks(in, data + displacement, num_runs, run_length, run_length, stride);
+        in += num_runs * run_length;
+      });
+    return in;
+  }
+}
+
+
+#endif
@@ -12,6 +12,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -21,6 +23,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_all", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -43,6 +47,8 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_all", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
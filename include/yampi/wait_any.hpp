@@ -12,6 +12,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -20,6 +22,8 @@ namespace yampi
   inline std::pair< ::yampi::status, ContiguousIterator > wait_any(
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_any", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
@@ -43,6 +47,8 @@ namespace yampi
     ::yampi::ignore_status_t const,
     ContiguousIterator const first, ContiguousIterator const last, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_any", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator>::value_type >::value,
       "value_type of ContiguousIterator must be derived from yampi::request_base");
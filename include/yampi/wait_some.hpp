@@ -12,6 +12,8 @@
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/error.hpp>
+# include <yampi/profiler.hpp>
+# include <yampi/request_histogram.hpp>
 
 
 namespace yampi
@@ -21,6 +23,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const index_out, ContiguousIterator3 const status_out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_some", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -38,7 +42,7 @@ namespace yampi
           std::addressof(count), std::addressof(*index_out), reinterpret_cast<MPI_Status*>(std::addressof(*status_out)));
 
     return error_code == MPI_SUCCESS
-      ? index != MPI_UNDEFINED
+      ? count != MPI_UNDEFINED
         ? std::make_pair(index_out + count, status_out + count)
         : std::make_pair(index_out, status_out)
       : throw ::yampi::error{error_code, "yampi::wait_some", environment};
@@ -50,6 +54,8 @@ namespace yampi
     ContiguousIterator1 const first, ContiguousIterator1 const last,
     ContiguousIterator2 const out, ::yampi::environment const& environment)
   {
+    YAMPI_PROFILE_SCOPE("yampi::wait_some", 0u);
+    YAMPI_TIME_REQUEST_WAIT(typename std::iterator_traits<ContiguousIterator1>::value_type, environment);
     static_assert(
       std::is_base_of< ::yampi::request_base, typename std::iterator_traits<ContiguousIterator1>::value_type >::value,
       "value_type of ContiguousIterator1 must be derived from yampi::request_base");
@@ -64,7 +70,7 @@ namespace yampi
           std::addressof(count), std::addressof(*out), MPI_STATUSES_IGNORE);
 
     return error_code == MPI_SUCCESS
-      ? index != MPI_UNDEFINED
+      ? count != MPI_UNDEFINED
         ? out + count
         : out
       : throw ::yampi::error{error_code, "yampi::wait_some", environment};
@@ -16,6 +16,7 @@
 # include <yampi/communicator.hpp>
 # include <yampi/addressof.hpp>
 # include <yampi/information.hpp>
+# include <yampi/profiler.hpp>
 
 
 namespace yampi
@@ -59,6 +60,7 @@ namespace yampi
       MPI_Info const& mpi_info, ::yampi::communicator const& communicator,
       ::yampi::environment const& environment) const
     {
+      YAMPI_PROFILE_SCOPE("yampi::window::create", 0u);
       assert(last >= first);
 
       using value_type = typename std::remove_cv<typename std::iterator_traits<ContiguousIterator>::value_type>::type;
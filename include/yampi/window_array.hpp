@@ -8,6 +8,7 @@
 # include <utility>
 # include <type_traits>
 # include <memory>
+# include <stdexcept>
 
 # include <mpi.h>
 
@@ -16,6 +17,9 @@
 # include <yampi/window_base.hpp>
 # include <yampi/communicator.hpp>
 # include <yampi/information.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/shared_segment.hpp>
+# include <yampi/profiler.hpp>
 
 
 # if MPI_VERSION >= 3
@@ -33,19 +37,20 @@ namespace yampi
         MPI_Win& mpi_win, std::size_t const num_elements, MPI_Info const& mpi_info,
         ::yampi::communicator const& communicator, ::yampi::environment const& environment)
       {
+        YAMPI_PROFILE_SCOPE("yampi::window_array_detail::create<T, false>::call", 0u);
         T* result;
 # if MPI_VERSION >= 4
         int const error_code
           = MPI_Win_allocate_c(
               static_cast<MPI_Aint>(sizeof(T)) * static_cast<MPI_Aint>(num_elements),
               static_cast<MPI_Aint>(sizeof(T)), mpi_info, communicator.mpi_comm(),
-              result, std::addressof(mpi_win));
+              std::addressof(result), std::addressof(mpi_win));
 # else // MPI_VERSION >= 4
         int const error_code
           = MPI_Win_allocate(
               static_cast<MPI_Aint>(sizeof(T)) * static_cast<MPI_Aint>(num_elements),
               static_cast<int>(sizeof(T)), mpi_info, communicator.mpi_comm(),
-              result, std::addressof(mpi_win));
+              std::addressof(result), std::addressof(mpi_win));
 # endif // MPI_VERSION >= 4
         return error_code == MPI_SUCCESS
           ? result
@@ -60,19 +65,20 @@ namespace yampi
         MPI_Win& mpi_win, std::size_t const num_elements, MPI_Info const& mpi_info,
         ::yampi::communicator const& communicator, ::yampi::environment const& environment)
       {
+        YAMPI_PROFILE_SCOPE("yampi::window_array_detail::create<T, true>::call", 0u);
         T* result;
 # if MPI_VERSION >= 4
         int const error_code
           = MPI_Win_allocate_shared_c(
               static_cast<MPI_Aint>(sizeof(T)) * static_cast<MPI_Aint>(num_elements),
               static_cast<MPI_Aint>(sizeof(T)), mpi_info, communicator.mpi_comm(),
-              result, std::addressof(mpi_win));
+              std::addressof(result), std::addressof(mpi_win));
 # else // MPI_VERSION >= 4
         int const error_code
           = MPI_Win_allocate_shared(
               static_cast<MPI_Aint>(sizeof(T)) * static_cast<MPI_Aint>(num_elements),
               static_cast<int>(sizeof(T)), mpi_info, communicator.mpi_comm(),
-              result, std::addressof(mpi_win));
+              std::addressof(result), std::addressof(mpi_win));
 # endif // MPI_VERSION >= 4
         return error_code == MPI_SUCCESS
           ? result
@@ -87,7 +93,7 @@ namespace yampi
   {
     typedef ::yampi::window_base< ::yampi::window_array<T, is_on_shared_memory> > base_type;
 
-    MPI_Win mpi_win_;
+    using base_type::mpi_win_;
     T* base_ptr_;
     std::size_t num_elements_;
 
@@ -102,9 +108,9 @@ namespace yampi
     typedef pointer iterator;
     typedef const_pointer const_iterator;
     typedef std::reverse_iterator<iterator> reverse_iterator;
-    typedef std::reverse_iterator<const_iterator> reverse_const_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    window_array() noexcept(noexcept(base_type{}))
+    window_array() noexcept(std::is_nothrow_copy_constructible<MPI_Win>::value)
       : base_type{}, base_ptr_{nullptr}, num_elements_{std::size_t{0u}}
     { }
 
@@ -112,9 +118,11 @@ namespace yampi
     window_array& operator=(window_array const&) = delete;
 
     window_array(window_array&& other)
-      noexcept(noexcept(base_type{std::move(other)}))
-      : base_ptr_{std::move(other.base_ptr_)}, num_elements_{std::move(other.num_elements_)}, base_type{std::move(other)}
-    { other.base_ptr_ = nullptr; }
+      noexcept(
+        std::is_nothrow_move_constructible<MPI_Win>::value
+        and std::is_nothrow_copy_assignable<MPI_Win>::value)
+      : base_type{std::move(other)}, base_ptr_{std::move(other.base_ptr_)}, num_elements_{std::move(other.num_elements_)}
+    { other.base_ptr_ = nullptr; other.num_elements_ = std::size_t{0u}; }
 
     window_array& operator=(window_array&& other)
       noexcept(
@@ -180,20 +188,22 @@ namespace yampi
       std::size_t const num_elements,
       ::yampi::communicator const& communicator, ::yampi::environment const& environment)
     {
-      free(environment);
+      base_type::free(environment);
       base_ptr_
         = ::yampi::window_array_detail::create<T, is_on_shared_memory>::call(
             mpi_win_, num_elements, MPI_INFO_NULL, communicator, environment);
+      num_elements_ = num_elements;
     }
 
     void reset(
       std::size_t const num_elements, ::yampi::information const& information,
       ::yampi::communicator const& communicator, ::yampi::environment const& environment)
     {
-      free(environment);
+      base_type::free(environment);
       base_ptr_
         = ::yampi::window_array_detail::create<T, is_on_shared_memory>::call(
             mpi_win_, num_elements, information.mpi_info(), communicator, environment);
+      num_elements_ = num_elements;
     }
 
     reference at(size_type const index)
@@ -232,17 +242,36 @@ namespace yampi
     const_iterator end() const noexcept { return base_ptr_ + num_elements_; }
     const_iterator cend() const noexcept { return base_ptr_ + num_elements_; }
     reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
-    const_reverse_iterator rbegin() const noexcept { return reverse_iterator(this->end()); }
-    const_reverse_iterator crbegin() const noexcept { return reverse_iterator(this->cend()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(this->end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(this->cend()); }
     reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
-    const_reverse_iterator rend() const noexcept { return reverse_iterator(this->begin()); }
-    const_reverse_iterator crend() const noexcept { return reverse_iterator(this->cbegin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(this->begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(this->cbegin()); }
 
     bool empty() const noexcept { return num_elements_ == std::size_t{0u}; }
     size_type size() const  noexcept { return num_elements_; }
     size_type max_size() const  noexcept { return num_elements_; }
 
     void fill(T const& value) { std::fill(begin(), end(), value); }
+
+    // Segment of the process of rank in the communicator of this window, to which the calling process can load and
+    // store directly. Only for is_on_shared_memory == true. Querying costs an MPI call, so keep segments accessed often
+    ::yampi::shared_segment<T> shared_segment(::yampi::rank const rank, ::yampi::environment const& environment) const
+    {
+      static_assert(is_on_shared_memory, "yampi::window_array<T, false> has no shared segments");
+
+      MPI_Aint num_bytes;
+      int displacement_unit;
+      T* result;
+      auto const error_code
+        = MPI_Win_shared_query(
+            mpi_win_, rank.mpi_rank(),
+            std::addressof(num_bytes), std::addressof(displacement_unit), std::addressof(result));
+      if (error_code != MPI_SUCCESS)
+        throw ::yampi::error{error_code, "yampi::window_array::shared_segment", environment};
+
+      return ::yampi::shared_segment<T>{result, static_cast<std::size_t>(num_bytes) / sizeof(T)};
+    }
   };
 
   template <typename T, bool is_on_shared_memory>
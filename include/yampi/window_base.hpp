@@ -14,6 +14,7 @@
 # include <yampi/byte_displacement.hpp>
 # include <yampi/group.hpp>
 # include <yampi/error.hpp>
+# include <yampi/information.hpp>
 
 # if __cplusplus >= 201703L
 #   define YAMPI_is_nothrow_swappable std::is_nothrow_swappable